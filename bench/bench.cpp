@@ -0,0 +1,793 @@
+/// @file bench.cpp
+/// @brief Measures the throughput of wide operators and math functions against their serial counterparts.
+/// @author github.com/SirJonthe
+/// @date 2022, 2023
+/// @copyright Public domain.
+/// @license CC0 1.0
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "../wide.h"
+#include "../wmath.h"
+#include "../wexpr.h"
+#include "../wsort.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	#include <intrin.h>
+	#define BENCH_HAS_TSC
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+	#include <x86intrin.h>
+	#define BENCH_HAS_TSC
+#endif
+
+#define BENCH_STRINGIFY_(x) #x
+#define BENCH_STRINGIFY(x) BENCH_STRINGIFY_(x)
+
+namespace bench
+{
+
+/// @brief The number of elements processed per pass. Small enough for all buffers of the widest type to stay in the L1 cache, so that the benchmarks measure computation rather than memory bandwidth.
+static const size_t N = 4096;
+
+
+/// @brief Options parsed from the command line.
+struct options
+{
+	bool        json;
+	double      min_time;
+	int         samples;
+	std::string filter;
+	double      sort_max;
+};
+
+
+/// @brief The result of timing one implementation of an operation.
+struct timing
+{
+	double elements_per_second;
+	double cycles_per_element;
+};
+
+
+/// @brief Reads the time stamp counter. The counter ticks at a constant reference rate, which usually differs somewhat from the actual core clock.
+///
+/// @returns the counter, or 0 on platforms without a time stamp counter.
+inline uint64_t cycles( void )
+{
+#if defined(BENCH_HAS_TSC)
+	return uint64_t(__rdtsc());
+#else
+	return 0;
+#endif
+}
+
+
+/// @brief Prevents the compiler from optimizing away, or moving, work done on the memory pointed to.
+inline void clobber(void *p)
+{
+#if defined(_MSC_VER)
+	(void)p;
+	_ReadWriteBarrier();
+#else
+	__asm__ __volatile__("" : : "r"(p) : "memory");
+#endif
+}
+
+
+/// @brief Receives checksums of the results so that the compiler can not remove the computations.
+volatile uint64_t sink = 0;
+
+
+/// @brief Generates a deterministic pseudo-random value in the range [0, 1).
+inline double random01(uint64_t &state)
+{
+	state = state * 6364136223846793005ull + 1442695040888963407ull;
+	return double(state >> 11) * (1.0 / 9007199254740992.0);
+}
+
+
+/// @brief Fills a buffer with values in the range [lo, hi].
+template < typename serial_t >
+void fill(serial_t *p, double lo, double hi, uint64_t seed)
+{
+	for (size_t i = 0; i < N; ++i) {
+		double x = lo + (hi - lo) * random01(seed);
+		if (std::is_integral<serial_t>::value) {
+			x = std::floor(x + 0.5);
+		}
+		p[i] = serial_t(x);
+	}
+}
+
+
+/// @brief Times repeated passes of a kernel over the buffers, and returns the best of several samples.
+///
+/// @param elements the number of elements processed per pass.
+template < typename kernel_t >
+timing measure(const options &opt, kernel_t kernel, void *out, size_t elements = N)
+{
+	typedef std::chrono::steady_clock clock;
+	const double min_seconds = opt.min_time / 1000.0;
+	size_t passes = 1;
+	for (;;) {
+		const clock::time_point t0 = clock::now();
+		for (size_t p = 0; p < passes; ++p) {
+			kernel();
+			clobber(out);
+		}
+		const double seconds = std::chrono::duration<double>(clock::now() - t0).count();
+		if (seconds >= min_seconds / opt.samples || passes >= (size_t(1) << 30)) {
+			break;
+		}
+		passes *= 2;
+	}
+	timing best = { 0.0, std::numeric_limits<double>::infinity() };
+	for (int s = 0; s < opt.samples; ++s) {
+		const clock::time_point t0 = clock::now();
+		const uint64_t          c0 = bench::cycles();
+		for (size_t p = 0; p < passes; ++p) {
+			kernel();
+			clobber(out);
+		}
+		const uint64_t c1      = bench::cycles();
+		const double   seconds = std::chrono::duration<double>(clock::now() - t0).count();
+		const double   count   = double(passes) * double(elements);
+		const double   eps     = seconds > 0.0 ? count / seconds : std::numeric_limits<double>::infinity();
+		if (eps > best.elements_per_second) {
+			best.elements_per_second = eps;
+			best.cycles_per_element  = double(c1 - c0) / count;
+		}
+	}
+#if !defined(BENCH_HAS_TSC)
+	best.cycles_per_element = std::numeric_limits<double>::quiet_NaN();
+#endif
+	return best;
+}
+
+
+/// @brief Adds the bit patterns of a buffer to the sink.
+template < typename serial_t >
+void consume(const serial_t *p)
+{
+	uint64_t sum = 0;
+	for (size_t i = 0; i < N; ++i) {
+		uint64_t bits = 0;
+		std::memcpy(&bits, p + i, sizeof(serial_t));
+		sum = sum * 31 + bits;
+	}
+	sink = sink + sum;
+}
+
+
+/// @brief Returns the number of leading zero bits of a serial integer.
+template < typename serial_t >
+serial_t countl_zero(serial_t x)
+{
+	typedef typename std::make_unsigned<serial_t>::type unsigned_t;
+	const unsigned_t u = unsigned_t(x);
+	if (u == 0) { return serial_t(sizeof(serial_t) * 8); }
+#if defined(__GNUC__) || defined(__clang__)
+	return serial_t(__builtin_clzll((unsigned long long)u) - int(64 - sizeof(serial_t) * 8));
+#else
+	serial_t n = 0;
+	for (unsigned_t m = unsigned_t(unsigned_t(1) << (sizeof(serial_t) * 8 - 1)); (u & m) == 0; m >>= 1) { ++n; }
+	return n;
+#endif
+}
+
+
+/// @brief Returns the saturated sum of two serial integers.
+template < typename serial_t >
+serial_t adds(serial_t a, serial_t b)
+{
+	const int64_t s = int64_t(a) + int64_t(b);
+	return serial_t(std::max<int64_t>(int64_t(std::numeric_limits<serial_t>::min()), std::min<int64_t>(int64_t(std::numeric_limits<serial_t>::max()), s)));
+}
+
+
+/// @brief Returns the number of bits needed to represent a serial integer, minus one, or -1 for non-positive values.
+template < typename serial_t >
+serial_t ilog2(serial_t x)
+{
+	return x > 0 ? serial_t(serial_t(sizeof(serial_t) * 8 - 1) - bench::countl_zero(x)) : serial_t(-1);
+}
+
+
+/// @brief Computes the same chain of arithmetic as the 'chain' benchmark through expression templates.
+template < typename wide_t >
+wide_t chain(const wide_t &a, const wide_t &b)
+{
+	typedef typename wide_t::serial_t S;
+	using cc0::wide::expr::lazy;
+	return (lazy(a) * b + S(2)) * a - lazy(b) * S(0.5) + lazy(a) * a;
+}
+
+
+/// @brief Implements the passes over the buffers for an operation that maps each pair of input elements to one output element through its 'wide' and 'serial' functions.
+template < typename op_t >
+struct map
+{
+	template < typename wide_t >
+	static void wide_pass(const typename wide_t::serial_t *a, const typename wide_t::serial_t *b, typename wide_t::serial_t *out)
+	{
+		for (size_t i = 0; i < N; i += wide_t::width) {
+			cc0::wide::store_aligned(out + i, op_t::wide(cc0::wide::load_aligned<wide_t>(a + i), cc0::wide::load_aligned<wide_t>(b + i)));
+		}
+	}
+	template < typename S >
+	static void serial_pass(const S *a, const S *b, S *out)
+	{
+		for (size_t i = 0; i < N; ++i) {
+			out[i] = op_t::serial(a[i], b[i]);
+		}
+	}
+};
+
+}
+
+/// @brief Declares a benchmarked operation taking two operands 'a' and 'b' with values in the range [lo, hi]. Both expressions may refer to the serial type as 'S'.
+///
+/// @param name the name of the operation.
+/// @param cat the category the operation belongs to.
+/// @param lo the lowest input value.
+/// @param hi the highest input value.
+/// @param wide_expr the wide implementation.
+/// @param serial_expr the serial implementation.
+#define BENCH_OP(name, cat, lo, hi, wide_expr, serial_expr) \
+	struct op_##name : bench::map<op_##name> \
+	{ \
+		static const char *id( void )       { return #name; } \
+		static const char *category( void ) { return cat; } \
+		static double      min( void )      { return lo; } \
+		static double      max( void )      { return hi; } \
+		template < typename wide_t > \
+		static wide_t wide(const wide_t &a, const wide_t &b) \
+		{ \
+			typedef typename wide_t::serial_t S; \
+			(void)a; (void)b; (void)sizeof(S); \
+			return wide_expr; \
+		} \
+		template < typename S > \
+		static S serial(S a, S b) \
+		{ \
+			(void)a; (void)b; (void)sizeof(S); \
+			return serial_expr; \
+		} \
+	};
+
+namespace bench
+{
+
+// Floating-point operators.
+BENCH_OP(add,            "arithmetic",   -100.0,  100.0, (a + b),                                                       S(a + b))
+BENCH_OP(sub,            "arithmetic",   -100.0,  100.0, (a - b),                                                       S(a - b))
+BENCH_OP(mul,            "arithmetic",   -100.0,  100.0, (a * b),                                                       S(a * b))
+BENCH_OP(div,            "arithmetic",      1.0,  100.0, (a / b),                                                       S(a / b))
+BENCH_OP(fma,            "arithmetic",   -100.0,  100.0, (cc0::wide::fma(a, b, a)),                                     (std::fma(a, b, a)))
+BENCH_OP(rcp,            "arithmetic",      1.0,  100.0, (cc0::wide::rcp(a)),                                           S(S(1) / a))
+BENCH_OP(rcp_approx,     "arithmetic",      1.0,  100.0, (cc0::wide::rcp_approx(a)),                                    S(S(1) / a))
+BENCH_OP(rsqrt,          "arithmetic",      1.0,  100.0, (cc0::wide::rsqrt(a)),                                         S(S(1) / std::sqrt(a)))
+BENCH_OP(rsqrt_approx,   "arithmetic",      1.0,  100.0, (cc0::wide::rsqrt_approx(a)),                                  S(S(1) / std::sqrt(a)))
+BENCH_OP(sqrt,           "arithmetic",     0.01, 1000.0, (cc0::wide::sqrt(a)),                                          (std::sqrt(a)))
+BENCH_OP(sqrt_nr,        "arithmetic",     0.01, 1000.0, (cc0::wide::sqrt_nr(a)),                                       (std::sqrt(a)))
+BENCH_OP(sqrt_bs,        "arithmetic",     0.01, 1000.0, (cc0::wide::sqrt_bs(a)),                                       (std::sqrt(a)))
+BENCH_OP(fmin,           "comparison",   -100.0,  100.0, (cc0::wide::min(a, b)),                                        (std::min(a, b)))
+BENCH_OP(fmax,           "comparison",   -100.0,  100.0, (cc0::wide::max(a, b)),                                        (std::max(a, b)))
+BENCH_OP(fcmov,          "comparison",   -100.0,  100.0, (cc0::wide::cmov(a < b, a, b)),                                (a < b ? a : b))
+BENCH_OP(fabs,           "rounding",     -100.0,  100.0, (cc0::wide::abs(a)),                                           (std::abs(a)))
+BENCH_OP(floor,          "rounding",     -100.0,  100.0, (cc0::wide::floor(a)),                                         (std::floor(a)))
+BENCH_OP(ceil,           "rounding",     -100.0,  100.0, (cc0::wide::ceil(a)),                                          (std::ceil(a)))
+BENCH_OP(round,          "rounding",     -100.0,  100.0, (cc0::wide::round(a)),                                         (std::round(a)))
+BENCH_OP(convert,        "conversion",   -100.0,  100.0, (wide_t(cc0::wide::wide_int<wide_t::depth,wide_t::width>(a))), S(int64_t(a)))
+BENCH_OP(sin,            "trigonometry",  -10.0,   10.0, (cc0::wide::sin(a)),                                           (std::sin(a)))
+BENCH_OP(sin_balanced,   "trigonometry",  -10.0,   10.0, (cc0::wide::sin<cc0::wide::precision::balanced>(a)),           (std::sin(a)))
+BENCH_OP(sin_fast,       "trigonometry",  -10.0,   10.0, (cc0::wide::sin<cc0::wide::precision::fast>(a)),               (std::sin(a)))
+BENCH_OP(cos,            "trigonometry",  -10.0,   10.0, (cc0::wide::cos(a)),                                           (std::cos(a)))
+BENCH_OP(cos_balanced,   "trigonometry",  -10.0,   10.0, (cc0::wide::cos<cc0::wide::precision::balanced>(a)),           (std::cos(a)))
+BENCH_OP(cos_fast,       "trigonometry",  -10.0,   10.0, (cc0::wide::cos<cc0::wide::precision::fast>(a)),               (std::cos(a)))
+BENCH_OP(tan,            "trigonometry",  -10.0,   10.0, (cc0::wide::tan(a)),                                           (std::tan(a)))
+BENCH_OP(tan_balanced,   "trigonometry",  -10.0,   10.0, (cc0::wide::tan<cc0::wide::precision::balanced>(a)),           (std::tan(a)))
+BENCH_OP(tan_fast,       "trigonometry",  -10.0,   10.0, (cc0::wide::tan<cc0::wide::precision::fast>(a)),               (std::tan(a)))
+BENCH_OP(asin,           "trigonometry",   -1.0,    1.0, (cc0::wide::asin(a)),                                          (std::asin(a)))
+BENCH_OP(asin_balanced,  "trigonometry",   -1.0,    1.0, (cc0::wide::asin<cc0::wide::precision::balanced>(a)),          (std::asin(a)))
+BENCH_OP(asin_fast,      "trigonometry",   -1.0,    1.0, (cc0::wide::asin<cc0::wide::precision::fast>(a)),              (std::asin(a)))
+BENCH_OP(acos,           "trigonometry",   -1.0,    1.0, (cc0::wide::acos(a)),                                          (std::acos(a)))
+BENCH_OP(acos_balanced,  "trigonometry",   -1.0,    1.0, (cc0::wide::acos<cc0::wide::precision::balanced>(a)),          (std::acos(a)))
+BENCH_OP(acos_fast,      "trigonometry",   -1.0,    1.0, (cc0::wide::acos<cc0::wide::precision::fast>(a)),              (std::acos(a)))
+BENCH_OP(atan,           "trigonometry", -100.0,  100.0, (cc0::wide::atan(a)),                                          (std::atan(a)))
+BENCH_OP(atan_balanced,  "trigonometry", -100.0,  100.0, (cc0::wide::atan<cc0::wide::precision::balanced>(a)),          (std::atan(a)))
+BENCH_OP(atan_fast,      "trigonometry", -100.0,  100.0, (cc0::wide::atan<cc0::wide::precision::fast>(a)),              (std::atan(a)))
+BENCH_OP(atan2,          "trigonometry", -100.0,  100.0, (cc0::wide::atan2(a, b)),                                      (std::atan2(a, b)))
+BENCH_OP(atan2_balanced, "trigonometry", -100.0,  100.0, (cc0::wide::atan2<cc0::wide::precision::balanced>(a, b)),      (std::atan2(a, b)))
+BENCH_OP(atan2_fast,     "trigonometry", -100.0,  100.0, (cc0::wide::atan2<cc0::wide::precision::fast>(a, b)),          (std::atan2(a, b)))
+BENCH_OP(exp,            "exponential",   -20.0,   20.0, (cc0::wide::exp(a)),                                           (std::exp(a)))
+BENCH_OP(exp_balanced,   "exponential",   -20.0,   20.0, (cc0::wide::exp<cc0::wide::precision::balanced>(a)),           (std::exp(a)))
+BENCH_OP(exp_fast,       "exponential",   -20.0,   20.0, (cc0::wide::exp<cc0::wide::precision::fast>(a)),               (std::exp(a)))
+BENCH_OP(exp2,           "exponential",   -20.0,   20.0, (cc0::wide::exp2(a)),                                          (std::exp2(a)))
+BENCH_OP(exp2_balanced,  "exponential",   -20.0,   20.0, (cc0::wide::exp2<cc0::wide::precision::balanced>(a)),          (std::exp2(a)))
+BENCH_OP(exp2_fast,      "exponential",   -20.0,   20.0, (cc0::wide::exp2<cc0::wide::precision::fast>(a)),              (std::exp2(a)))
+BENCH_OP(log,            "exponential",   0.001, 1000.0, (cc0::wide::log(a)),                                           (std::log(a)))
+BENCH_OP(log_balanced,   "exponential",   0.001, 1000.0, (cc0::wide::log<cc0::wide::precision::balanced>(a)),           (std::log(a)))
+BENCH_OP(log_fast,       "exponential",   0.001, 1000.0, (cc0::wide::log<cc0::wide::precision::fast>(a)),               (std::log(a)))
+BENCH_OP(log2,           "exponential",   0.001, 1000.0, (cc0::wide::log2(a)),                                          (std::log2(a)))
+BENCH_OP(log2_balanced,  "exponential",   0.001, 1000.0, (cc0::wide::log2<cc0::wide::precision::balanced>(a)),          (std::log2(a)))
+BENCH_OP(log2_fast,      "exponential",   0.001, 1000.0, (cc0::wide::log2<cc0::wide::precision::fast>(a)),              (std::log2(a)))
+BENCH_OP(log10,          "exponential",   0.001, 1000.0, (cc0::wide::log10(a)),                                         (std::log10(a)))
+BENCH_OP(log10_balanced, "exponential",   0.001, 1000.0, (cc0::wide::log10<cc0::wide::precision::balanced>(a)),         (std::log10(a)))
+BENCH_OP(log10_fast,     "exponential",   0.001, 1000.0, (cc0::wide::log10<cc0::wide::precision::fast>(a)),             (std::log10(a)))
+BENCH_OP(pow,            "exponential",     0.1,   10.0, (cc0::wide::pow(a, b)),                                        (std::pow(a, b)))
+BENCH_OP(pow_balanced,   "exponential",     0.1,   10.0, (cc0::wide::pow<cc0::wide::precision::balanced>(a, b)),        (std::pow(a, b)))
+BENCH_OP(pow_fast,       "exponential",     0.1,   10.0, (cc0::wide::pow<cc0::wide::precision::fast>(a, b)),            (std::pow(a, b)))
+BENCH_OP(chain,          "expression",   -100.0,  100.0, ((a * b + S(2)) * a - b * S(0.5) + a * a),                     S((a * b + S(2)) * a - b * S(0.5) + a * a))
+BENCH_OP(chain_expr,     "expression",   -100.0,  100.0, (bench::chain(a, b)),                                          S((a * b + S(2)) * a - b * S(0.5) + a * a))
+
+// Integer operators.
+BENCH_OP(iadd,           "arithmetic",   -100.0,  100.0, (a + b),                                                       S(a + b))
+BENCH_OP(isub,           "arithmetic",   -100.0,  100.0, (a - b),                                                       S(a - b))
+BENCH_OP(imul,           "arithmetic",   -100.0,  100.0, (a * b),                                                       S(a * b))
+BENCH_OP(imulhi,         "arithmetic",   -100.0,  100.0, (cc0::wide::mulhi(a, b)),                                      S((int64_t(a) * int64_t(b)) >> (sizeof(S) * 8)))
+BENCH_OP(idiv,           "arithmetic",      1.0,  100.0, (a / b),                                                       S(a / b))
+BENCH_OP(imod,           "arithmetic",      1.0,  100.0, (a % b),                                                       S(a % b))
+BENCH_OP(iadds,          "arithmetic",   -100.0,  100.0, (cc0::wide::adds(a, b)),                                       (bench::adds(a, b)))
+BENCH_OP(iavg,           "arithmetic",   -100.0,  100.0, (cc0::wide::avg(a, b)),                                        S((int64_t(a) + int64_t(b) + 1) >> 1))
+BENCH_OP(iand,           "bitwise",      -100.0,  100.0, (a & b),                                                       S(a & b))
+BENCH_OP(ior,            "bitwise",      -100.0,  100.0, (a | b),                                                       S(a | b))
+BENCH_OP(ixor,           "bitwise",      -100.0,  100.0, (a ^ b),                                                       S(a ^ b))
+BENCH_OP(ishl,           "bitwise",         0.0,  100.0, (a << S(1)),                                                   S(a << 1))
+BENCH_OP(ishr,           "bitwise",      -100.0,  100.0, (a >> S(1)),                                                   S(a >> 1))
+BENCH_OP(popcount,       "bitwise",      -100.0,  100.0, (cc0::wide::popcount(a)),                                      S(cc0::wide::__wide_popcount(uint64_t(typename std::make_unsigned<S>::type(a)))))
+BENCH_OP(countl_zero,    "bitwise",      -100.0,  100.0, (cc0::wide::countl_zero(a)),                                   (bench::countl_zero(a)))
+BENCH_OP(imin,           "comparison",   -100.0,  100.0, (cc0::wide::min(a, b)),                                        (std::min(a, b)))
+BENCH_OP(imax,           "comparison",   -100.0,  100.0, (cc0::wide::max(a, b)),                                        (std::max(a, b)))
+BENCH_OP(icmov,          "comparison",   -100.0,  100.0, (cc0::wide::cmov(a < b, a, b)),                                (a < b ? a : b))
+BENCH_OP(ilog2,          "exponential",     1.0,  100.0, (cc0::wide::log2(a)),                                          (bench::ilog2(a)))
+
+
+/// @brief Predication through CC0_WIDE_IF. Both branches are taken by some lanes of most inputs, which is the worst case for wide code.
+struct op_branch : bench::map<op_branch>
+{
+	static const char *id( void )       { return "branch"; }
+	static const char *category( void ) { return "predication"; }
+	static double      min( void )      { return -100.0; }
+	static double      max( void )      { return 100.0; }
+	template < typename wide_t >
+	static wide_t wide(const wide_t &a, const wide_t &b)
+	{
+		cc0::wide::wide_bool<wide_t::depth,wide_t::width> mask = true;
+		wide_t r = a;
+		CC0_WIDE_IF(a < b)
+			r = CC0_WIDE_SET(a + b);
+		CC0_WIDE_ELSE
+			r = CC0_WIDE_SET(a * b);
+		CC0_WIDE_END_IF
+		return r;
+	}
+	template < typename S >
+	static S serial(S a, S b)
+	{
+		return a < b ? S(a + b) : S(a * b);
+	}
+};
+
+
+/// @brief Predication through CC0_WIDE_IF_UNIFORM where all lanes take the same branch, which is the best case for wide code. The other branch is skipped, and the taken branch assigns without blending.
+struct op_branch_uniform : bench::map<op_branch_uniform>
+{
+	static const char *id( void )       { return "branch_uniform"; }
+	static const char *category( void ) { return "predication"; }
+	static double      min( void )      { return 0.0; }
+	static double      max( void )      { return 100.0; }
+	template < typename wide_t >
+	static wide_t wide(const wide_t &a, const wide_t &b)
+	{
+		typedef typename wide_t::serial_t S;
+		cc0::wide::wide_bool<wide_t::depth,wide_t::width> mask = true;
+		wide_t r = a;
+		CC0_WIDE_IF_UNIFORM(a >= S(0))
+			r = CC0_WIDE_SET(a + b);
+		CC0_WIDE_ELSE
+			r = CC0_WIDE_SET(a * b);
+		CC0_WIDE_END_IF
+		return r;
+	}
+	template < typename S >
+	static S serial(S a, S b)
+	{
+		return a >= S(0) ? S(a + b) : S(a * b);
+	}
+};
+
+
+/// @brief Stream compaction through compress_store, keeping the elements of 'a' that are less than the corresponding elements of 'b'. Half of the elements pass in no particular pattern, so the branch of the serial loop is unpredictable.
+struct op_filter
+{
+	static const char *id( void )       { return "filter"; }
+	static const char *category( void ) { return "compaction"; }
+	static double      min( void )      { return -100.0; }
+	static double      max( void )      { return 100.0; }
+	template < typename wide_t >
+	static void wide_pass(const typename wide_t::serial_t *a, const typename wide_t::serial_t *b, typename wide_t::serial_t *out)
+	{
+		size_t n = 0;
+		for (size_t i = 0; i < N; i += wide_t::width) {
+			const wide_t x = cc0::wide::load_aligned<wide_t>(a + i);
+			n += cc0::wide::compress_store(out + n, x, x < cc0::wide::load_aligned<wide_t>(b + i));
+		}
+	}
+	template < typename S >
+	static void serial_pass(const S *a, const S *b, S *out)
+	{
+		size_t n = 0;
+		for (size_t i = 0; i < N; ++i) {
+			if (a[i] < b[i]) { out[n++] = a[i]; }
+		}
+	}
+};
+
+
+/// @brief Returns the name of a wide type template.
+template < typename wide_t > struct type_name;
+template < uint32_t D, uint32_t W > struct type_name< cc0::wide::wide_float<D,W> > { static const char *get( void ) { return "float"; } };
+template < uint32_t D, uint32_t W > struct type_name< cc0::wide::wide_int<D,W> >   { static const char *get( void ) { return "int"; } };
+
+
+/// @brief Writes a number, or null for numbers that could not be measured.
+inline void print_number(bool json, double x)
+{
+	if (std::isfinite(x)) {
+		std::printf("%.6g", x);
+	} else if (json) {
+		std::printf("null");
+	}
+}
+
+
+/// @brief Writes the timings of the wide and serial implementations of an operation on a wide type as a row of output.
+template < typename wide_t >
+void report(const options &opt, bool &first, const char *name, const char *category, const timing &w, const timing &s)
+{
+	const char *isa = BENCH_STRINGIFY(CC0_WIDE_ISA_NAMESPACE);
+	if (opt.json) {
+		std::printf("%s\n\t\t{ \"op\": \"%s\", \"category\": \"%s\", \"type\": \"%s\", \"depth\": %u, \"width\": %u, \"isa\": \"%s\", ", first ? "" : ",", name, category, type_name<wide_t>::get(), unsigned(wide_t::depth), unsigned(wide_t::width), isa);
+		std::printf("\"wide_elements_per_second\": ");   bench::print_number(true, w.elements_per_second);
+		std::printf(", \"wide_cycles_per_element\": ");  bench::print_number(true, w.cycles_per_element);
+		std::printf(", \"serial_elements_per_second\": "); bench::print_number(true, s.elements_per_second);
+		std::printf(", \"serial_cycles_per_element\": "); bench::print_number(true, s.cycles_per_element);
+		std::printf(", \"speedup\": ");                  bench::print_number(true, w.elements_per_second / s.elements_per_second);
+		std::printf(" }");
+	} else {
+		std::printf("%s,%s,%s,%u,%u,%s,", name, category, type_name<wide_t>::get(), unsigned(wide_t::depth), unsigned(wide_t::width), isa);
+		bench::print_number(false, w.elements_per_second); std::printf(",");
+		bench::print_number(false, w.cycles_per_element);  std::printf(",");
+		bench::print_number(false, s.elements_per_second); std::printf(",");
+		bench::print_number(false, s.cycles_per_element);  std::printf(",");
+		bench::print_number(false, w.elements_per_second / s.elements_per_second);
+		std::printf("\n");
+	}
+	std::fflush(stdout);
+	first = false;
+}
+
+
+/// @brief Benchmarks an operation on a wide type against a serial loop over the same data, and writes the result as a row of output.
+template < typename op_t, typename wide_t >
+void run(const options &opt, bool &first)
+{
+	typedef typename wide_t::serial_t serial_t;
+
+	const char *name = op_t::id();
+	if (!opt.filter.empty() && std::strstr(name, opt.filter.c_str()) == nullptr && std::strstr(op_t::category(), opt.filter.c_str()) == nullptr) {
+		return;
+	}
+
+	alignas(64) static serial_t a[N];
+	alignas(64) static serial_t b[N];
+	alignas(64) static serial_t out[N];
+	bench::fill(a, op_t::min(), op_t::max(), 1);
+	bench::fill(b, op_t::min(), op_t::max(), 2);
+
+	struct wide_kernel
+	{
+		void operator()( void ) const
+		{
+			op_t::template wide_pass<wide_t>(a, b, out);
+		}
+	};
+	struct serial_kernel
+	{
+		void operator()( void ) const
+		{
+			op_t::serial_pass(a, b, out);
+		}
+	};
+
+	const timing w = bench::measure(opt, wide_kernel(), out);
+	bench::consume(out);
+	const timing s = bench::measure(opt, serial_kernel(), out);
+	bench::consume(out);
+
+	bench::report<wide_t>(opt, first, name, op_t::category(), w, s);
+}
+
+
+/// @brief Benchmarks an operation on each of the given wide types.
+template < typename op_t, typename... wide_t >
+void run_all(const options &opt, bool &first)
+{
+	const int expand[] = { 0, (bench::run<op_t, wide_t>(opt, first), 0)... };
+	(void)expand;
+}
+
+
+/// @brief Benchmarks a floating-point operation on all floating-point types.
+template < typename op_t >
+void run_float(const options &opt, bool &first)
+{
+	using namespace cc0::wide;
+	bench::run_all<op_t,
+		wide_float<32,4>, wide_float<32,8>, wide_float<32,16>,
+		wide_float<64,2>, wide_float<64,4>, wide_float<64,8>
+	>(opt, first);
+}
+
+
+/// @brief Benchmarks an integer operation on all integer types.
+template < typename op_t >
+void run_int(const options &opt, bool &first)
+{
+	using namespace cc0::wide;
+	bench::run_all<op_t,
+		wide_int<8,16>, wide_int<8,32>,
+		wide_int<16,8>, wide_int<16,16>,
+		wide_int<32,4>, wide_int<32,8>, wide_int<32,16>,
+		wide_int<64,2>, wide_int<64,4>, wide_int<64,8>
+	>(opt, first);
+}
+
+
+/// @brief Benchmarks wide_sort on a wide type against std::sort, on arrays of 1e3 elements up to the number of elements given by --sort-max, in steps of a factor of ten. Every pass sorts a fresh copy of the same random array.
+template < typename wide_t >
+void run_sort(const options &opt, bool &first)
+{
+	typedef typename wide_t::serial_t serial_t;
+
+	uint32_t exponent = 3;
+	for (size_t count = 1000; double(count) <= opt.sort_max; count *= 10, ++exponent) {
+		const std::string name = "sort_1e" + std::to_string(exponent);
+		if (!opt.filter.empty() && std::strstr(name.c_str(), opt.filter.c_str()) == nullptr && std::strstr("sort", opt.filter.c_str()) == nullptr) {
+			continue;
+		}
+
+		std::vector<serial_t> in(count);
+		std::vector<serial_t> out(count);
+		uint64_t seed = 1;
+		for (size_t i = 0; i < count; ++i) {
+			if (std::is_integral<serial_t>::value) {
+				const uint64_t bits = uint64_t(bench::random01(seed) * 18446744073709551616.0);
+				std::memcpy(&in[i], &bits, sizeof(serial_t));
+			} else {
+				in[i] = serial_t(-1000000.0 + 2000000.0 * bench::random01(seed));
+			}
+		}
+
+		struct wide_kernel
+		{
+			const std::vector<serial_t> &in;
+			std::vector<serial_t>       &out;
+			void operator()( void ) const
+			{
+				std::memcpy(out.data(), in.data(), in.size() * sizeof(serial_t));
+				cc0::wide::wide_sort<wide_t::width>(out.data(), out.size());
+			}
+		};
+		struct serial_kernel
+		{
+			const std::vector<serial_t> &in;
+			std::vector<serial_t>       &out;
+			void operator()( void ) const
+			{
+				std::memcpy(out.data(), in.data(), in.size() * sizeof(serial_t));
+				std::sort(out.begin(), out.end());
+			}
+		};
+
+		const timing                w      = bench::measure(opt, wide_kernel{ in, out }, out.data(), count);
+		const std::vector<serial_t> sorted = out;
+		const timing                s      = bench::measure(opt, serial_kernel{ in, out }, out.data(), count);
+		if (sorted != out) {
+			std::fprintf(stderr, "%s: wide_sort and std::sort disagree\n", name.c_str());
+		}
+
+		bench::report<wide_t>(opt, first, name.c_str(), "sort", w, s);
+	}
+}
+
+
+/// @brief Benchmarks wide_sort on each of the given wide types.
+template < typename... wide_t >
+void run_sort_all(const options &opt, bool &first)
+{
+	const int expand[] = { 0, (bench::run_sort<wide_t>(opt, first), 0)... };
+	(void)expand;
+}
+
+
+/// @brief Benchmarks an integer operation on the 8, 16, and 32-bit integer types only. Used for operations whose serial counterparts need an integer of twice the depth.
+template < typename op_t >
+void run_int_narrow(const options &opt, bool &first)
+{
+	using namespace cc0::wide;
+	bench::run_all<op_t,
+		wide_int<8,16>, wide_int<8,32>,
+		wide_int<16,8>, wide_int<16,16>,
+		wide_int<32,4>, wide_int<32,8>, wide_int<32,16>
+	>(opt, first);
+}
+
+}
+
+
+/// @brief Parses the command line.
+static bool parse(int argc, char **argv, bench::options &opt)
+{
+	opt.json     = false;
+	opt.min_time = 20.0;
+	opt.samples  = 5;
+	opt.sort_max = 1e6;
+	for (int i = 1; i < argc; ++i) {
+		const char *arg = argv[i];
+		if (std::strcmp(arg, "--format=csv") == 0) {
+			opt.json = false;
+		} else if (std::strcmp(arg, "--format=json") == 0) {
+			opt.json = true;
+		} else if (std::strncmp(arg, "--filter=", 9) == 0) {
+			opt.filter = arg + 9;
+		} else if (std::strncmp(arg, "--min-time=", 11) == 0) {
+			opt.min_time = std::atof(arg + 11);
+		} else if (std::strncmp(arg, "--samples=", 10) == 0) {
+			opt.samples = std::atoi(arg + 10);
+		} else if (std::strncmp(arg, "--sort-max=", 11) == 0) {
+			opt.sort_max = std::atof(arg + 11);
+		} else {
+			std::fprintf(stderr,
+				"usage: %s [--format=csv|json] [--filter=<op or category>] [--min-time=<ms>] [--samples=<n>] [--sort-max=<n>]\n"
+				"  --format    output format (default csv)\n"
+				"  --filter    only run operations whose name or category contains the given string\n"
+				"  --min-time  approximate time spent measuring each implementation, in milliseconds (default 20)\n"
+				"  --samples   number of samples, of which the fastest is reported (default 5)\n"
+				"  --sort-max  largest number of elements sorted by the sort benchmarks, e.g. 1e8 (default 1e6)\n",
+				argv[0]);
+			return false;
+		}
+	}
+	if (opt.samples < 1) { opt.samples = 1; }
+	return true;
+}
+
+
+int main(int argc, char **argv)
+{
+	using namespace bench;
+
+	options opt;
+	if (!parse(argc, argv, opt)) {
+		return 1;
+	}
+
+	if (opt.json) {
+		std::printf("{\n\t\"isa\": \"%s\",\n\t\"elements\": %u,\n\t\"results\": [", BENCH_STRINGIFY(CC0_WIDE_ISA_NAMESPACE), unsigned(N));
+	} else {
+		std::printf("op,category,type,depth,width,isa,wide_elements_per_second,wide_cycles_per_element,serial_elements_per_second,serial_cycles_per_element,speedup\n");
+	}
+
+	bool first = true;
+
+	run_float<op_add>(opt, first);
+	run_float<op_sub>(opt, first);
+	run_float<op_mul>(opt, first);
+	run_float<op_div>(opt, first);
+	run_float<op_fma>(opt, first);
+	run_float<op_rcp>(opt, first);
+	run_float<op_rcp_approx>(opt, first);
+	run_float<op_rsqrt>(opt, first);
+	run_float<op_rsqrt_approx>(opt, first);
+	run_float<op_sqrt>(opt, first);
+	run_float<op_sqrt_nr>(opt, first);
+	run_float<op_sqrt_bs>(opt, first);
+	run_float<op_fmin>(opt, first);
+	run_float<op_fmax>(opt, first);
+	run_float<op_fcmov>(opt, first);
+	run_float<op_fabs>(opt, first);
+	run_float<op_floor>(opt, first);
+	run_float<op_ceil>(opt, first);
+	run_float<op_round>(opt, first);
+	run_float<op_convert>(opt, first);
+	run_float<op_chain>(opt, first);
+	run_float<op_chain_expr>(opt, first);
+	run_float<op_branch>(opt, first);
+	run_float<op_branch_uniform>(opt, first);
+	run_float<op_filter>(opt, first);
+	run_float<op_sin>(opt, first);
+	run_float<op_sin_balanced>(opt, first);
+	run_float<op_sin_fast>(opt, first);
+	run_float<op_cos>(opt, first);
+	run_float<op_cos_balanced>(opt, first);
+	run_float<op_cos_fast>(opt, first);
+	run_float<op_tan>(opt, first);
+	run_float<op_tan_balanced>(opt, first);
+	run_float<op_tan_fast>(opt, first);
+	run_float<op_asin>(opt, first);
+	run_float<op_asin_balanced>(opt, first);
+	run_float<op_asin_fast>(opt, first);
+	run_float<op_acos>(opt, first);
+	run_float<op_acos_balanced>(opt, first);
+	run_float<op_acos_fast>(opt, first);
+	run_float<op_atan>(opt, first);
+	run_float<op_atan_balanced>(opt, first);
+	run_float<op_atan_fast>(opt, first);
+	run_float<op_atan2>(opt, first);
+	run_float<op_atan2_balanced>(opt, first);
+	run_float<op_atan2_fast>(opt, first);
+	run_float<op_exp>(opt, first);
+	run_float<op_exp_balanced>(opt, first);
+	run_float<op_exp_fast>(opt, first);
+	run_float<op_exp2>(opt, first);
+	run_float<op_exp2_balanced>(opt, first);
+	run_float<op_exp2_fast>(opt, first);
+	run_float<op_log>(opt, first);
+	run_float<op_log_balanced>(opt, first);
+	run_float<op_log_fast>(opt, first);
+	run_float<op_log2>(opt, first);
+	run_float<op_log2_balanced>(opt, first);
+	run_float<op_log2_fast>(opt, first);
+	run_float<op_log10>(opt, first);
+	run_float<op_log10_balanced>(opt, first);
+	run_float<op_log10_fast>(opt, first);
+	run_float<op_pow>(opt, first);
+	run_float<op_pow_balanced>(opt, first);
+	run_float<op_pow_fast>(opt, first);
+
+	run_int<op_iadd>(opt, first);
+	run_int<op_isub>(opt, first);
+	run_int<op_imul>(opt, first);
+	run_int_narrow<op_imulhi>(opt, first);
+	run_int<op_idiv>(opt, first);
+	run_int<op_imod>(opt, first);
+	run_int<op_iadds>(opt, first);
+	run_int<op_iavg>(opt, first);
+	run_int<op_iand>(opt, first);
+	run_int<op_ior>(opt, first);
+	run_int<op_ixor>(opt, first);
+	run_int<op_ishl>(opt, first);
+	run_int<op_ishr>(opt, first);
+	run_int<op_popcount>(opt, first);
+	run_int<op_countl_zero>(opt, first);
+	run_int<op_imin>(opt, first);
+	run_int<op_imax>(opt, first);
+	run_int<op_icmov>(opt, first);
+	run_int<op_branch>(opt, first);
+	run_int<op_branch_uniform>(opt, first);
+	run_int<op_filter>(opt, first);
+	run_int<op_ilog2>(opt, first);
+
+	// Only the types that have a native register on some backend are sorted, since every type sorts several large arrays.
+	run_sort_all<
+		cc0::wide::wide_float<32,4>, cc0::wide::wide_float<32,8>, cc0::wide::wide_float<64,4>,
+		cc0::wide::wide_int<8,16>, cc0::wide::wide_int<16,8>, cc0::wide::wide_int<32,4>, cc0::wide::wide_int<32,8>, cc0::wide::wide_int<64,4>
+	>(opt, first);
+
+	if (opt.json) {
+		std::printf("\n\t]\n}\n");
+	}
+
+	return int(sink & 0);
+}
@@ -0,0 +1,430 @@
+/// @file ulp.cpp
+/// @brief Measures the error of the wide math functions, at each precision, against long double references.
+/// @author github.com/SirJonthe
+/// @date 2022, 2023
+/// @copyright Public domain.
+/// @license CC0 1.0
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include "../wide.h"
+#include "../wmath.h"
+
+#define ULP_STRINGIFY_(x) #x
+#define ULP_STRINGIFY(x) ULP_STRINGIFY_(x)
+
+namespace ulp
+{
+
+/// @brief The number of inputs evaluated per batch.
+static const size_t N = 4096;
+
+
+/// @brief Options parsed from the command line.
+struct options
+{
+	bool        json;
+	bool        exhaustive;
+	uint64_t    samples;
+	double      max_ulp;
+	std::string filter;
+};
+
+
+/// @brief The accumulated error of one function at one precision.
+struct error
+{
+	uint64_t    samples;
+	long double max_ulp;
+	long double sum_ulp;
+	long double max_abs;
+	long double worst_a;
+	long double worst_b;
+};
+
+
+/// @brief Maps floating-point values to integers with the same ordering, so that consecutive integers are consecutive representable values.
+template < typename serial_t > struct ordered;
+
+template <>
+struct ordered<float>
+{
+	static int64_t from(float x)
+	{
+		uint32_t u;
+		std::memcpy(&u, &x, sizeof(u));
+		return (u & 0x80000000u) ? -int64_t(u & 0x7fffffffu) : int64_t(u);
+	}
+	static float to(int64_t o)
+	{
+		const uint32_t u = o < 0 ? (0x80000000u | uint32_t(-o)) : uint32_t(o);
+		float x;
+		std::memcpy(&x, &u, sizeof(x));
+		return x;
+	}
+};
+
+template <>
+struct ordered<double>
+{
+	static int64_t from(double x)
+	{
+		uint64_t u;
+		std::memcpy(&u, &x, sizeof(u));
+		return (u & 0x8000000000000000ull) ? -int64_t(u & 0x7fffffffffffffffull) : int64_t(u);
+	}
+	static double to(int64_t o)
+	{
+		const uint64_t u = o < 0 ? (0x8000000000000000ull | uint64_t(-o)) : uint64_t(o);
+		double x;
+		std::memcpy(&x, &u, sizeof(x));
+		return x;
+	}
+};
+
+
+/// @brief Generates a deterministic pseudo-random 64-bit value.
+inline uint64_t random64(uint64_t &state)
+{
+	state = state * 6364136223846793005ull + 1442695040888963407ull;
+	uint64_t x = state;
+	x ^= x >> 33;
+	x *= 0xff51afd7ed558ccdull;
+	x ^= x >> 33;
+	return x;
+}
+
+
+/// @brief Generates a value in the range [lo, hi]. Every other value is uniformly distributed over the range, and every other value uniformly distributed over the representable values in the range, which gives good coverage of both large and small magnitudes.
+template < typename serial_t >
+serial_t random_in(serial_t lo, serial_t hi, uint64_t &state, bool representable)
+{
+	if (representable) {
+		const int64_t a = ordered<serial_t>::from(lo);
+		const int64_t b = ordered<serial_t>::from(hi);
+		return ordered<serial_t>::to(a + int64_t(random64(state) % uint64_t(b - a + 1)));
+	}
+	const long double t = (long double)(random64(state) >> 11) * (1.0L / 9007199254740992.0L);
+	const serial_t    x = serial_t(lo + (hi - lo) * t);
+	return x < lo ? lo : (x > hi ? hi : x);
+}
+
+
+/// @brief Returns the error in units in the last place of the serial type of a result compared to a reference. A result matching a non-finite reference has no error, while any other non-finite result has infinite error.
+template < typename serial_t >
+long double ulp_error(serial_t x, long double ref)
+{
+	typedef std::numeric_limits<serial_t> limits;
+	if (std::isnan(ref)) {
+		return std::isnan(x) ? 0.0L : std::numeric_limits<long double>::infinity();
+	}
+	if (std::fabs(ref) > (long double)limits::max()) {
+		return (std::isinf(x) && std::signbit(x) == std::signbit(ref)) ? 0.0L : std::numeric_limits<long double>::infinity();
+	}
+	if (!std::isfinite(x)) {
+		return std::numeric_limits<long double>::infinity();
+	}
+	int e = ref != 0.0L ? std::ilogb(ref) : limits::min_exponent - 1;
+	if (e < limits::min_exponent - 1) {
+		e = limits::min_exponent - 1;
+	}
+	return std::fabs((long double)x - ref) / std::ldexp(1.0L, e - (limits::digits - 1));
+}
+
+
+/// @brief Accumulates the error of a batch of results.
+template < typename serial_t >
+void accumulate(error &err, const serial_t *a, const serial_t *b, const serial_t *out, const long double *ref, size_t count)
+{
+	for (size_t i = 0; i < count; ++i) {
+		const long double u = ulp::ulp_error(out[i], ref[i]);
+		err.samples += 1;
+		err.sum_ulp += u;
+		if (u > err.max_ulp || (err.samples == 1)) {
+			err.max_ulp = u;
+			err.worst_a = a[i];
+			err.worst_b = b[i];
+		}
+		if (std::isfinite(ref[i]) && std::isfinite((long double)out[i])) {
+			const long double d = std::fabs((long double)out[i] - ref[i]);
+			if (d > err.max_abs) {
+				err.max_abs = d;
+			}
+		}
+	}
+}
+
+}
+
+/// @brief Declares a measured function of one or two operands 'a' and 'b', with 'a' in the range [lo_a, hi_a] and 'b' in [lo_b, hi_b]. The range expressions may refer to the serial type as 'S', and the wide expression to the precision as 'P'.
+///
+/// @param name the name of the function.
+/// @param arity the number of operands.
+/// @param lo_a the lowest value of 'a'.
+/// @param hi_a the highest value of 'a'.
+/// @param lo_b the lowest value of 'b'.
+/// @param hi_b the highest value of 'b'.
+/// @param wide_expr the wide implementation.
+/// @param reference_expr the reference implementation, evaluated in long double.
+#define ULP_FUNC(name, arity_, lo_a, hi_a, lo_b, hi_b, wide_expr, reference_expr) \
+	struct fn_##name \
+	{ \
+		static const char *id( void ) { return #name; } \
+		static int         arity( void ) { return arity_; } \
+		template < typename S > static S min_a( void ) { return S(lo_a); } \
+		template < typename S > static S max_a( void ) { return S(hi_a); } \
+		template < typename S > static S min_b( void ) { return S(lo_b); } \
+		template < typename S > static S max_b( void ) { return S(hi_b); } \
+		template < cc0::wide::precision P, typename wide_t > \
+		static wide_t wide(const wide_t &a, const wide_t &b) \
+		{ \
+			(void)a; (void)b; \
+			return wide_expr; \
+		} \
+		static long double reference(long double a, long double b) \
+		{ \
+			(void)a; (void)b; \
+			return reference_expr; \
+		} \
+	};
+
+namespace ulp
+{
+
+ULP_FUNC(sin,     1, -100.0, 100.0, 0.0, 0.0, (cc0::wide::sin<P>(a)),      (std::sin(a)))
+ULP_FUNC(cos,     1, -100.0, 100.0, 0.0, 0.0, (cc0::wide::cos<P>(a)),      (std::cos(a)))
+ULP_FUNC(tan,     1, -100.0, 100.0, 0.0, 0.0, (cc0::wide::tan<P>(a)),      (std::tan(a)))
+ULP_FUNC(asin,    1,   -1.0,   1.0, 0.0, 0.0, (cc0::wide::asin<P>(a)),     (std::asin(a)))
+ULP_FUNC(acos,    1,   -1.0,   1.0, 0.0, 0.0, (cc0::wide::acos<P>(a)),     (std::acos(a)))
+ULP_FUNC(atan,    1, -1.0e4, 1.0e4, 0.0, 0.0, (cc0::wide::atan<P>(a)),     (std::atan(a)))
+ULP_FUNC(atan2,   2, -100.0, 100.0, -100.0, 100.0, (cc0::wide::atan2<P>(a, b)), (std::atan2(a, b)))
+ULP_FUNC(exp,     1, (std::numeric_limits<S>::min_exponent - 1) * 0.69314718055994530942, (std::numeric_limits<S>::max_exponent - 1) * 0.69314718055994530942, 0.0, 0.0, (cc0::wide::exp<P>(a)), (std::exp(a)))
+ULP_FUNC(exp2,    1, std::numeric_limits<S>::min_exponent - 1, std::numeric_limits<S>::max_exponent - 1, 0.0, 0.0, (cc0::wide::exp2<P>(a)), (std::exp2(a)))
+ULP_FUNC(log,     1, std::numeric_limits<S>::min(), std::numeric_limits<S>::max(), 0.0, 0.0, (cc0::wide::log<P>(a)),   (std::log(a)))
+ULP_FUNC(log2,    1, std::numeric_limits<S>::min(), std::numeric_limits<S>::max(), 0.0, 0.0, (cc0::wide::log2<P>(a)),  (std::log2(a)))
+ULP_FUNC(log10,   1, std::numeric_limits<S>::min(), std::numeric_limits<S>::max(), 0.0, 0.0, (cc0::wide::log10<P>(a)), (std::log10(a)))
+ULP_FUNC(pow,     2,    0.0,  10.0, -20.0, 20.0, (cc0::wide::pow<P>(a, b)), (std::pow(a, b)))
+
+// Functions without a precision parameter.
+ULP_FUNC(sqrt,    1,    0.0, 1.0e6, 0.0, 0.0, (cc0::wide::sqrt(a)),        (std::sqrt(a)))
+ULP_FUNC(sqrt_nr, 1,    0.0, 1.0e6, 0.0, 0.0, (cc0::wide::sqrt_nr(a)),     (std::sqrt(a)))
+ULP_FUNC(sqrt_bs, 1,    0.0, 1.0e6, 0.0, 0.0, (cc0::wide::sqrt_bs(a)),     (std::sqrt(a)))
+
+
+/// @brief Returns the name of a precision.
+inline const char *precision_name(cc0::wide::precision p)
+{
+	switch (p) {
+	case cc0::wide::precision::fast:     return "fast";
+	case cc0::wide::precision::balanced: return "balanced";
+	case cc0::wide::precision::accurate: return "accurate";
+	}
+	return "unknown";
+}
+
+
+/// @brief Writes a number, or null for numbers that are not finite.
+inline void print_number(bool json, long double x)
+{
+	if (std::isfinite(x)) {
+		std::printf("%.6Lg", x);
+	} else {
+		std::printf(json ? "null" : "inf");
+	}
+}
+
+
+/// @brief Evaluates a function at the given precision on the native width of the given depth, and writes its error as a row of output.
+///
+/// @returns false if the maximum error exceeds the bound given on the command line.
+template < typename fn_t, cc0::wide::precision P, uint32_t Depth >
+bool run(const options &opt, const char *precision, bool &first)
+{
+	typedef cc0::wide::wide_float<Depth, cc0::wide::native_width<Depth>::value> wide_t;
+	typedef typename wide_t::serial_t                                             serial_t;
+	static const uint32_t W = wide_t::width;
+
+	const char       *name  = fn_t::id();
+	const std::string label = std::string(name) + "." + precision;
+	if (!opt.filter.empty() && label.find(opt.filter) == std::string::npos) {
+		return true;
+	}
+
+	alignas(64) static serial_t a[N];
+	alignas(64) static serial_t b[N];
+	alignas(64) static serial_t out[N];
+	static long double          ref[N];
+
+	const serial_t lo_a = fn_t::template min_a<serial_t>();
+	const serial_t hi_a = fn_t::template max_a<serial_t>();
+	const serial_t lo_b = fn_t::template min_b<serial_t>();
+	const serial_t hi_b = fn_t::template max_b<serial_t>();
+
+	const bool     exhaustive = opt.exhaustive && fn_t::arity() == 1 && Depth == 32;
+	const int64_t  first_a    = ordered<serial_t>::from(lo_a);
+	const int64_t  last_a     = ordered<serial_t>::from(hi_a);
+	const uint64_t total      = exhaustive ? uint64_t(last_a - first_a + 1) : opt.samples;
+
+	error    err   = { 0, 0.0L, 0.0L, 0.0L, 0.0L, 0.0L };
+	uint64_t state = 1;
+	for (uint64_t done = 0; done < total; done += N) {
+		const size_t count = size_t(total - done < N ? total - done : N);
+		for (size_t i = 0; i < N; ++i) {
+			if (i >= count) {
+				a[i] = a[0];
+				b[i] = b[0];
+			} else if (exhaustive) {
+				a[i] = ordered<serial_t>::to(first_a + int64_t(done + i));
+				b[i] = lo_b;
+			} else {
+				a[i] = ulp::random_in(lo_a, hi_a, state, (i & 1) != 0);
+				b[i] = fn_t::arity() > 1 ? ulp::random_in(lo_b, hi_b, state, (i & 2) != 0) : lo_b;
+			}
+		}
+		for (size_t i = 0; i < N; i += W) {
+			cc0::wide::store_aligned(out + i, fn_t::template wide<P>(cc0::wide::load_aligned<wide_t>(a + i), cc0::wide::load_aligned<wide_t>(b + i)));
+		}
+		for (size_t i = 0; i < count; ++i) {
+			ref[i] = fn_t::reference(a[i], b[i]);
+		}
+		ulp::accumulate(err, a, b, out, ref, count);
+	}
+
+	const long double mean = err.samples > 0 ? err.sum_ulp / err.samples : 0.0L;
+	const char *isa = ULP_STRINGIFY(CC0_WIDE_ISA_NAMESPACE);
+	if (opt.json) {
+		std::printf("%s\n\t\t{ \"function\": \"%s\", \"precision\": \"%s\", \"depth\": %u, \"width\": %u, \"isa\": \"%s\", \"samples\": %llu, \"exhaustive\": %s, ", first ? "" : ",", name, precision, unsigned(Depth), unsigned(W), isa, (unsigned long long)err.samples, exhaustive ? "true" : "false");
+		std::printf("\"max_ulp\": ");        ulp::print_number(true, err.max_ulp);
+		std::printf(", \"mean_ulp\": ");     ulp::print_number(true, mean);
+		std::printf(", \"max_abs_error\": "); ulp::print_number(true, err.max_abs);
+		std::printf(", \"worst_a\": ");      ulp::print_number(true, err.worst_a);
+		std::printf(", \"worst_b\": ");      ulp::print_number(true, fn_t::arity() > 1 ? err.worst_b : std::numeric_limits<long double>::quiet_NaN());
+		std::printf(" }");
+	} else {
+		std::printf("%s,%s,%u,%u,%s,%llu,%s,", name, precision, unsigned(Depth), unsigned(W), isa, (unsigned long long)err.samples, exhaustive ? "true" : "false");
+		ulp::print_number(false, err.max_ulp); std::printf(",");
+		ulp::print_number(false, mean);        std::printf(",");
+		ulp::print_number(false, err.max_abs); std::printf(",");
+		ulp::print_number(false, err.worst_a); std::printf(",");
+		if (fn_t::arity() > 1) { ulp::print_number(false, err.worst_b); }
+		std::printf("\n");
+	}
+	std::fflush(stdout);
+	first = false;
+	return !(opt.max_ulp >= 0.0 && err.max_ulp > opt.max_ulp);
+}
+
+
+/// @brief Evaluates a function taking a precision at each precision and depth.
+template < typename fn_t >
+bool run_precisions(const options &opt, bool &first)
+{
+	using cc0::wide::precision;
+	bool ok = true;
+	ok &= ulp::run<fn_t, precision::fast,     32>(opt, "fast",     first);
+	ok &= ulp::run<fn_t, precision::balanced, 32>(opt, "balanced", first);
+	ok &= ulp::run<fn_t, precision::accurate, 32>(opt, "accurate", first);
+	ok &= ulp::run<fn_t, precision::fast,     64>(opt, "fast",     first);
+	ok &= ulp::run<fn_t, precision::balanced, 64>(opt, "balanced", first);
+	ok &= ulp::run<fn_t, precision::accurate, 64>(opt, "accurate", first);
+	return ok;
+}
+
+
+/// @brief Evaluates a function without a precision parameter at each depth.
+template < typename fn_t >
+bool run_single(const options &opt, bool &first)
+{
+	using cc0::wide::precision;
+	bool ok = true;
+	ok &= ulp::run<fn_t, precision::accurate, 32>(opt, "none", first);
+	ok &= ulp::run<fn_t, precision::accurate, 64>(opt, "none", first);
+	return ok;
+}
+
+}
+
+
+/// @brief Parses the command line.
+static bool parse(int argc, char **argv, ulp::options &opt)
+{
+	opt.json       = false;
+	opt.exhaustive = false;
+	opt.samples    = uint64_t(1) << 20;
+	opt.max_ulp    = -1.0;
+	for (int i = 1; i < argc; ++i) {
+		const char *arg = argv[i];
+		if (std::strcmp(arg, "--format=csv") == 0) {
+			opt.json = false;
+		} else if (std::strcmp(arg, "--format=json") == 0) {
+			opt.json = true;
+		} else if (std::strcmp(arg, "--exhaustive") == 0) {
+			opt.exhaustive = true;
+		} else if (std::strncmp(arg, "--filter=", 9) == 0) {
+			opt.filter = arg + 9;
+		} else if (std::strncmp(arg, "--samples=", 10) == 0) {
+			opt.samples = std::strtoull(arg + 10, nullptr, 10);
+		} else if (std::strncmp(arg, "--max-ulp=", 10) == 0) {
+			opt.max_ulp = std::atof(arg + 10);
+		} else {
+			std::fprintf(stderr,
+				"usage: %s [--format=csv|json] [--filter=<function.precision>] [--samples=<n>] [--exhaustive] [--max-ulp=<n>]\n"
+				"  --format      output format (default csv)\n"
+				"  --filter      only measure functions where '<function>.<precision>' contains the given string, e.g. 'sin.' or '.fast'\n"
+				"  --samples     number of random inputs per function (default 1048576)\n"
+				"  --exhaustive  evaluate every representable 32-bit input in the domain of single-operand functions\n"
+				"  --max-ulp     exit with a non-zero status if any measured error exceeds the given number of units in the last place\n",
+				argv[0]);
+			return false;
+		}
+	}
+	return true;
+}
+
+
+int main(int argc, char **argv)
+{
+	using namespace ulp;
+
+	options opt;
+	if (!parse(argc, argv, opt)) {
+		return 2;
+	}
+
+	if (opt.json) {
+		std::printf("{\n\t\"isa\": \"%s\",\n\t\"results\": [", ULP_STRINGIFY(CC0_WIDE_ISA_NAMESPACE));
+	} else {
+		std::printf("function,precision,depth,width,isa,samples,exhaustive,max_ulp,mean_ulp,max_abs_error,worst_a,worst_b\n");
+	}
+
+	bool first = true;
+	bool ok    = true;
+
+	ok &= run_precisions<fn_sin>(opt, first);
+	ok &= run_precisions<fn_cos>(opt, first);
+	ok &= run_precisions<fn_tan>(opt, first);
+	ok &= run_precisions<fn_asin>(opt, first);
+	ok &= run_precisions<fn_acos>(opt, first);
+	ok &= run_precisions<fn_atan>(opt, first);
+	ok &= run_precisions<fn_atan2>(opt, first);
+	ok &= run_precisions<fn_exp>(opt, first);
+	ok &= run_precisions<fn_exp2>(opt, first);
+	ok &= run_precisions<fn_log>(opt, first);
+	ok &= run_precisions<fn_log2>(opt, first);
+	ok &= run_precisions<fn_log10>(opt, first);
+	ok &= run_precisions<fn_pow>(opt, first);
+	ok &= run_single<fn_sqrt>(opt, first);
+	ok &= run_single<fn_sqrt_nr>(opt, first);
+	ok &= run_single<fn_sqrt_bs>(opt, first);
+
+	if (opt.json) {
+		std::printf("\n\t]\n}\n");
+	}
+
+	return ok ? 0 : 1;
+}
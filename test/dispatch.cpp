@@ -0,0 +1,110 @@
+/// @file dispatch.cpp
+/// @brief Checks that a dispatcher selects the most capable variant of a kernel that the CPU supports, out of variants compiled for each instruction set level in separate translation units, and that the CC0_WIDE_ISA environment variable caps the selection. Exits with a non-zero status if any check fails.
+/// @author github.com/SirJonthe
+/// @date 2022, 2023
+/// @copyright Public domain.
+/// @license CC0 1.0
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "../wdispatch.h"
+
+// The variants of the kernel in dispatch_kernel.cpp.
+cc0::wide::isa dispatch_kernel_generic(const float *a, const float *b, float *out, size_t n);
+cc0::wide::isa dispatch_kernel_sse2(const float *a, const float *b, float *out, size_t n);
+cc0::wide::isa dispatch_kernel_sse4_1(const float *a, const float *b, float *out, size_t n);
+cc0::wide::isa dispatch_kernel_avx2(const float *a, const float *b, float *out, size_t n);
+
+namespace test
+{
+
+/// @brief The number of failed checks.
+static uint32_t failures = 0;
+
+
+/// @brief Records a failed check if the condition is false.
+inline bool check(bool condition, const char *what, cc0::wide::isa level)
+{
+	if (!condition) {
+		std::fprintf(stderr, "FAIL %s %s\n", what, cc0::wide::isa_name(level));
+		++failures;
+	}
+	return condition;
+}
+
+
+/// @brief Runs a variant of the kernel on an array whose length is not a multiple of the width, and checks both the results and the level the variant reports being compiled for.
+inline void run(cc0::wide::isa (*kernel)(const float*, const float*, float*, size_t), cc0::wide::isa level)
+{
+	const size_t N = 37;
+	float a[N], b[N], out[N + 1];
+	for (size_t i = 0; i < N; ++i) {
+		a[i] = float(i % 7) - 3.0f;
+		b[i] = float(i % 5);
+	}
+	out[N] = -1.0f;
+	test::check(kernel(a, b, out, N) == level, "compiled level", level);
+	bool ok = out[N] == -1.0f;
+	for (size_t i = 0; i < N; ++i) {
+		ok = ok && out[i] == a[i] * b[i] + 1.0f;
+	}
+	test::check(ok, "results", level);
+}
+
+}
+
+
+int main( void )
+{
+	using cc0::wide::isa;
+	typedef cc0::wide::dispatch<isa(const float*, const float*, float*, size_t)> dispatch_t;
+
+	const dispatch_t::variant variants[] = {
+		{ isa::generic, dispatch_kernel_generic },
+		{ isa::sse2,    dispatch_kernel_sse2 },
+		{ isa::sse4_1,  dispatch_kernel_sse4_1 },
+		{ isa::avx2,    dispatch_kernel_avx2 }
+	};
+	// The variants are listed out of order, since the dispatcher must not rely on the order.
+	const dispatch_t kernel({ variants[2], variants[0], variants[3], variants[1] });
+
+	// Unset or unknown names do not cap the level.
+	const char *env = std::getenv("CC0_WIDE_ISA");
+	isa cap = isa::avx2;
+	for (const dispatch_t::variant &v : variants) {
+		if (env != nullptr && std::strcmp(env, cc0::wide::isa_name(v.level)) == 0) {
+			cap = v.level;
+		}
+	}
+	isa expected = isa::generic;
+	for (const dispatch_t::variant &v : variants) {
+		if (v.level <= cap && cc0::wide::supports(v.level)) {
+			expected = v.level;
+		}
+	}
+	test::check(cc0::wide::max_isa() == cap, "max_isa", cc0::wide::max_isa());
+	test::check(cc0::wide::supports(isa::generic) && cc0::wide::supports(isa::sse2), "baseline support", isa::sse2);
+	test::check(kernel.level() == expected, "selected level", kernel.level());
+	test::check(kernel.function() != nullptr, "selected function", kernel.level());
+
+	// Calls through the dispatcher, as well as each variant that the CPU can run.
+	test::run(kernel.function(), kernel.level());
+	for (const dispatch_t::variant &v : variants) {
+		if (cc0::wide::supports(v.level)) {
+			test::run(v.function, v.level);
+		}
+	}
+	float r = 0.0f;
+	const float two = 2.0f;
+	kernel(&two, &two, &r, 1);
+	test::check(r == 5.0f, "call operator", kernel.level());
+
+	if (test::failures > 0) {
+		std::printf("dispatch (CC0_WIDE_ISA=%s): %u checks failed\n", env != nullptr ? env : "", unsigned(test::failures));
+		return 1;
+	}
+	std::printf("dispatch (CC0_WIDE_ISA=%s): selected %s, all checks passed\n", env != nullptr ? env : "", cc0::wide::isa_name(kernel.level()));
+	return 0;
+}
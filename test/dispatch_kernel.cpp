@@ -0,0 +1,25 @@
+/// @file dispatch_kernel.cpp
+/// @brief A kernel for the dispatch test. Compiled once for each instruction set level, with each copy named after its level via CC0_WIDE_VARIANT.
+/// @author github.com/SirJonthe
+/// @date 2022, 2023
+/// @copyright Public domain.
+/// @license CC0 1.0
+
+#include <cstddef>
+#include "../wdispatch.h"
+
+/// @brief Computes 'a * b + 1' for each element. The inputs are small integers, so the result is exact whether or not the multiply and add are fused.
+///
+/// @returns the instruction set level the kernel was compiled for.
+cc0::wide::isa CC0_WIDE_VARIANT(dispatch_kernel)(const float *a, const float *b, float *out, size_t n)
+{
+	typedef cc0::wide::wide_float<32,8> wide_t;
+	typedef cc0::wide::wide_bool<32,8>  mask_t;
+	for (size_t i = 0; i < n; i += wide_t::width) {
+		const mask_t m = cc0::wide::tail_mask<wide_t>(n - i);
+		const wide_t x = cc0::wide::load_masked<wide_t>(a + i, m);
+		const wide_t y = cc0::wide::load_masked<wide_t>(b + i, m);
+		cc0::wide::store_masked(out + i, cc0::wide::fma(x, y, wide_t(1.0f)), m);
+	}
+	return CC0_WIDE_ISA;
+}
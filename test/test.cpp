@@ -0,0 +1,1689 @@
+/// @file test.cpp
+/// @brief Checks the behavior of the wide types against serial reference implementations. Exits with a non-zero status if any check fails.
+/// @author github.com/SirJonthe
+/// @date 2022, 2023
+/// @copyright Public domain.
+/// @license CC0 1.0
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../wexpr.h"
+#include "../wide.h"
+#include "../wmath.h"
+#include "../wsort.h"
+#include "../wvector.h"
+
+#define TEST_STRINGIFY_(x) #x
+#define TEST_STRINGIFY(x) TEST_STRINGIFY_(x)
+
+namespace test
+{
+
+/// @brief The number of failed checks.
+static uint32_t failures = 0;
+
+
+/// @brief Records a failed check if the condition is false.
+inline bool check(bool condition, const char *what, const char *type, uint32_t depth, uint32_t width, size_t n)
+{
+	if (!condition) {
+		std::fprintf(stderr, "FAIL %s %s<%u,%u> n=%u\n", what, type, unsigned(depth), unsigned(width), unsigned(n));
+		++failures;
+	}
+	return condition;
+}
+
+
+/// @brief Generates a deterministic pseudo-random value.
+inline uint64_t random(uint64_t &state)
+{
+	state = state * 6364136223846793005ull + 1442695040888963407ull;
+	return state >> 11;
+}
+
+
+/// @brief The name of the serial type of a wide type, for reporting failures.
+template < typename serial_t >
+const char *name( void )
+{
+	return std::numeric_limits<serial_t>::is_integer ? (std::numeric_limits<serial_t>::is_signed ? "int" : "uint") : "float";
+}
+
+
+/// @brief Generates the elements of an array. Patterns 0 and 1 are random values from a wide and a narrow range, where the latter has many duplicates, 2 is ascending, 3 is descending, and 4 mixes random values with the extremes of the type, i.e. NaN, infinity, and signed zeroes for floating-point types.
+template < typename serial_t >
+std::vector<serial_t> generate(size_t n, uint32_t pattern, uint64_t seed)
+{
+	typedef std::numeric_limits<serial_t> limits;
+	std::vector<serial_t> v(n);
+	for (size_t i = 0; i < n; ++i) {
+		const uint64_t r = test::random(seed);
+		switch (pattern) {
+		case 0:
+			if (limits::is_integer) { std::memcpy(&v[i], &r, sizeof(serial_t)); }
+			else                    { v[i] = serial_t((double(r % 2000001) - 1000000.0) / 7.0); }
+			break;
+		case 1: v[i] = serial_t(r % 7); break;
+		case 2: v[i] = serial_t(i % 100); break;
+		case 3: v[i] = serial_t(100 - i % 100); break;
+		default:
+			switch (r % 8) {
+			case 0:  v[i] = limits::has_quiet_NaN ? limits::quiet_NaN() : limits::max(); break;
+			case 1:  v[i] = limits::has_infinity ? limits::infinity() : limits::max(); break;
+			case 2:  v[i] = limits::has_infinity ? -limits::infinity() : limits::lowest(); break;
+			case 3:  v[i] = limits::is_integer ? serial_t(0) : serial_t(-0.0); break;
+			default: v[i] = serial_t(r % 100); break;
+			}
+			break;
+		}
+	}
+	return v;
+}
+
+
+/// @brief Returns true if the serial value is NaN.
+template < typename serial_t >
+bool is_nan(serial_t x)
+{
+	return x != x;
+}
+
+
+/// @brief Returns true if the array holds the same values as the input sorted by std::sort, followed by the NaN values of the input.
+template < typename serial_t >
+bool sorted(const std::vector<serial_t> &result, std::vector<serial_t> input)
+{
+	const size_t ordered = size_t(std::partition(input.begin(), input.end(), [](serial_t x) { return !test::is_nan(x); }) - input.begin());
+	std::sort(input.begin(), input.begin() + ordered);
+	if (result.size() != input.size()) {
+		return false;
+	}
+	for (size_t i = 0; i < result.size(); ++i) {
+		if (i < ordered ? result[i] != input[i] : !test::is_nan(result[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+
+/// @brief Returns true if the arrays hold the same values in any order, counting NaN values as equal.
+template < typename serial_t >
+bool permutation(std::vector<serial_t> a, std::vector<serial_t> b)
+{
+	const auto less = [](serial_t x, serial_t y) { return test::is_nan(x) ? false : (test::is_nan(y) || x < y); };
+	std::sort(a.begin(), a.end(), less);
+	std::sort(b.begin(), b.end(), less);
+	for (size_t i = 0; i < a.size(); ++i) {
+		if (!(a[i] == b[i] || (test::is_nan(a[i]) && test::is_nan(b[i])))) {
+			return false;
+		}
+	}
+	return a.size() == b.size();
+}
+
+
+/// @brief Returns true if two serial values are the same. Floating-point values must also have the same sign, and NaN values are the same as each other.
+template < typename serial_t >
+bool same(serial_t a, serial_t b)
+{
+	return std::numeric_limits<serial_t>::is_integer ? a == b : ((a == b && std::signbit(a) == std::signbit(b)) || (test::is_nan(a) && test::is_nan(b)));
+}
+
+
+/// @brief Returns true if the lanes of a wide value are the same as the expected serial values.
+template < typename wide_t >
+bool equal(const wide_t &x, const typename wide_t::serial_t *expected)
+{
+	typename wide_t::serial_t o[wide_t::width];
+	cc0::wide::store(o, x);
+	for (uint32_t i = 0; i < wide_t::width; ++i) {
+		if (!test::same(o[i], expected[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+
+/// @brief Returns a random serial value. Integers cover the whole range of the type, while floating-point values lie within [-range, range].
+template < typename serial_t >
+serial_t value(uint64_t &seed, double range = 1000.0)
+{
+	const uint64_t r = test::random(seed);
+	serial_t       o;
+	if (std::numeric_limits<serial_t>::is_integer) { std::memcpy(&o, &r, sizeof(serial_t)); }
+	else                                          { o = serial_t((double(r % 2000001) / 1000000.0 - 1.0) * range); }
+	return o;
+}
+
+}
+
+// Checks that each lane of a wide expression equals a serial expression of the lane index 'i', converted to the serial type of the wide expression. Expects 'iteration' to be defined.
+#define TEST_LANES(what, wide_expr, serial_expr) \
+	do { \
+		typedef typename std::decay<decltype(wide_expr)>::type result_t; \
+		typename result_t::serial_t expected_[result_t::width]; \
+		for (uint32_t i = 0; i < result_t::width; ++i) { expected_[i] = typename result_t::serial_t(serial_expr); } \
+		test::check(test::equal(wide_expr, expected_), what, test::name<typename result_t::serial_t>(), result_t::depth, result_t::width, iteration); \
+	} while (false)
+
+// Checks that each lane of a wide mask expression is set if, and only if, a serial condition of the lane index 'i' holds.
+#define TEST_MASK(what, wide_expr, serial_cond) \
+	TEST_LANES(what, wide_expr, (serial_cond) ? ~uint64_t(0) : uint64_t(0))
+
+namespace test
+{
+
+
+/// @brief Checks the integer operators and conversions against the same operations on each lane. The generic build runs the same checks, so this compares each native backend with the generic implementation.
+template < typename wide_t >
+void operators(std::true_type)
+{
+	typedef typename wide_t::serial_t                         serial_t;
+	typedef cc0::wide::wide_bool<wide_t::depth,wide_t::width> mask_t;
+	typedef typename mask_t::serial_t                         bits_t;
+	typedef typename std::conditional<std::numeric_limits<serial_t>::is_signed, cc0::wide::wide_uint<wide_t::depth,wide_t::width>, cc0::wide::wide_int<wide_t::depth,wide_t::width> >::type other_t;
+	typedef typename other_t::serial_t                        other_serial_t;
+	const uint32_t W      = wide_t::width;
+	const bool     sign   = std::numeric_limits<serial_t>::is_signed;
+	const uint32_t narrow = wide_t::depth < 32 ? 0 : wide_t::depth / 2;
+	uint64_t       seed   = W * wide_t::depth;
+	for (uint32_t iteration = 0; iteration < 200; ++iteration) {
+		serial_t a[W], b[W], d[W], s[W];
+		bits_t   m[W];
+		for (uint32_t i = 0; i < W; ++i) {
+			a[i] = test::value<serial_t>(seed);
+			b[i] = test::random(seed) % 4 == 0 ? a[i] : test::value<serial_t>(seed);
+			// Signed overflow is undefined in the generic implementation above 16 bits, where the lanes are not promoted to int.
+			if (sign && narrow > 0) {
+				a[i] = serial_t(a[i] >> (narrow + 1));
+				b[i] = serial_t(b[i] >> (narrow + 1));
+			}
+			d[i] = b[i] == 0 || (sign && b[i] == serial_t(-1)) ? serial_t(7) : b[i];
+			s[i] = serial_t(test::random(seed) % wide_t::depth);
+			m[i] = test::random(seed) % 2 ? bits_t(~bits_t(0)) : bits_t(0);
+		}
+		const wide_t x = cc0::wide::load<wide_t>(a);
+		const wide_t y = cc0::wide::load<wide_t>(b);
+		const wide_t z = cc0::wide::load<wide_t>(d);
+		const wide_t k = cc0::wide::load<wide_t>(s);
+		const mask_t c = cc0::wide::load<mask_t>(m);
+
+		TEST_LANES("+",       x + y,    uint64_t(a[i]) + uint64_t(b[i]));
+		TEST_LANES("-",       x - y,    uint64_t(a[i]) - uint64_t(b[i]));
+		TEST_LANES("+ s",     x + b[0], uint64_t(a[i]) + uint64_t(b[0]));
+		TEST_LANES("s -",     b[0] - x, uint64_t(b[0]) - uint64_t(a[i]));
+		TEST_LANES("/",       x / z,    a[i] / d[i]);
+		TEST_LANES("%",       x % z,    a[i] % d[i]);
+		TEST_LANES("&",       x & y,    a[i] & b[i]);
+		TEST_LANES("|",       x | y,    a[i] | b[i]);
+		TEST_LANES("^",       x ^ y,    a[i] ^ b[i]);
+		TEST_LANES("~",       ~x,       ~a[i]);
+		TEST_LANES(">>",      x >> k,   a[i] >> s[i]);
+		TEST_LANES(">> s",    x >> s[0], a[i] >> s[0]);
+		TEST_LANES("<<",      x << k,   uint64_t(a[i]) << s[i]);
+		TEST_LANES("<< s",    x << s[0], uint64_t(a[i]) << s[0]);
+		TEST_LANES("cmov",    cc0::wide::cmov(c, x, y),    m[i] ? a[i] : b[i]);
+		TEST_LANES("cmov s",  cc0::wide::cmov(c, b[0], y), m[i] ? b[0] : b[i]);
+		TEST_LANES("bool",    wide_t(x == y),              a[i] == b[i] ? 1 : 0);
+		TEST_LANES("convert", wide_t(other_t(x)),          a[i]);
+		TEST_LANES("convert", other_t(x),                  other_serial_t(a[i]));
+
+		// The products of the lanes halved above fit the signed types.
+		const wide_t h = sign && narrow > 0 ? x >> serial_t(narrow - 1) : x;
+		serial_t     g[W];
+		cc0::wide::store(g, h);
+		TEST_LANES("*",       h * y,    uint64_t(g[i]) * uint64_t(b[i]));
+		TEST_LANES("* s",     h * b[0], uint64_t(g[i]) * uint64_t(b[0]));
+
+		wide_t u = x;
+		TEST_LANES("++",      u++,      a[i]);
+		TEST_LANES("++",      u,        uint64_t(a[i]) + 1);
+		TEST_LANES("--",      --u,      a[i]);
+
+		TEST_MASK("==",       x == y,    a[i] == b[i]);
+		TEST_MASK("!=",       x != y,    a[i] != b[i]);
+		TEST_MASK("<",        x <  y,    a[i] <  b[i]);
+		TEST_MASK(">",        x >  y,    a[i] >  b[i]);
+		TEST_MASK("<=",       x <= y,    a[i] <= b[i]);
+		TEST_MASK(">=",       x >= y,    a[i] >= b[i]);
+		TEST_MASK("< s",      x <  b[0], a[i] <  b[0]);
+		TEST_MASK("s <",      b[0] < x,  b[0] <  a[i]);
+		TEST_MASK("mask",     mask_t(x), a[i] != 0);
+		TEST_MASK("&",        c & (x < y),  m[i] && a[i] < b[i]);
+		TEST_MASK("|",        c | (x < y),  m[i] || a[i] < b[i]);
+		TEST_MASK("^",        c ^ (x < y),  (m[i] != 0) != (a[i] < b[i]));
+		TEST_MASK("!",        !c,           m[i] == 0);
+		TEST_MASK("cmov",     cc0::wide::cmov(c, x < y, x > y), m[i] ? a[i] < b[i] : a[i] > b[i]);
+		bool any = false;
+		for (uint32_t i = 0; i < W; ++i) { any = any || m[i] != 0; }
+		test::check(bool(c) == any, "bool", test::name<serial_t>(), wide_t::depth, W, iteration);
+	}
+}
+
+
+/// @brief Checks the floating-point operators and conversions against the same operations on each lane, including signed zeroes, infinities, and NaN.
+template < typename wide_t >
+void operators(std::false_type)
+{
+	typedef typename wide_t::serial_t                         serial_t;
+	typedef std::numeric_limits<serial_t>                     limits;
+	typedef cc0::wide::wide_bool<wide_t::depth,wide_t::width> mask_t;
+	typedef typename mask_t::serial_t                         bits_t;
+	typedef cc0::wide::wide_int<wide_t::depth,wide_t::width>  int_t;
+	typedef cc0::wide::wide_uint<wide_t::depth,wide_t::width> uint_t;
+	typedef typename int_t::serial_t                          int_serial_t;
+	typedef typename uint_t::serial_t                         uint_serial_t;
+	const uint32_t W         = wide_t::width;
+	const serial_t special[] = { serial_t(0), serial_t(-0.0), limits::infinity(), -limits::infinity(), limits::quiet_NaN(), limits::denorm_min(), limits::max() };
+	uint64_t       seed      = W * wide_t::depth;
+	for (uint32_t iteration = 0; iteration < 200; ++iteration) {
+		serial_t      a[W], b[W], f[W], g[W];
+		int_serial_t  n[W];
+		uint_serial_t u[W];
+		bits_t        m[W];
+		for (uint32_t i = 0; i < W; ++i) {
+			a[i] = test::random(seed) % 8 == 0 ? special[test::random(seed) % 7] : test::value<serial_t>(seed);
+			b[i] = test::random(seed) % 8 == 0 ? special[test::random(seed) % 7] : (test::random(seed) % 4 == 0 ? a[i] : test::value<serial_t>(seed));
+			f[i] = test::value<serial_t>(seed, 1.0e9);
+			g[i] = std::fabs(f[i]) * serial_t(2);
+			n[i] = int_serial_t(test::value<int_serial_t>(seed) >> 1);
+			u[i] = test::value<uint_serial_t>(seed);
+			m[i] = test::random(seed) % 2 ? bits_t(~bits_t(0)) : bits_t(0);
+		}
+		const wide_t x = cc0::wide::load<wide_t>(a);
+		const wide_t y = cc0::wide::load<wide_t>(b);
+		const mask_t c = cc0::wide::load<mask_t>(m);
+
+		TEST_LANES("+",       x + y,    a[i] + b[i]);
+		TEST_LANES("-",       x - y,    a[i] - b[i]);
+		TEST_LANES("*",       x * y,    a[i] * b[i]);
+		TEST_LANES("/",       x / y,    a[i] / b[i]);
+		TEST_LANES("+ s",     x + b[0], a[i] + b[0]);
+		TEST_LANES("s /",     b[0] / x, b[0] / a[i]);
+		TEST_LANES("-x",      -x,       -a[i]);
+		TEST_LANES("cmov",    cc0::wide::cmov(c, x, y),    m[i] ? a[i] : b[i]);
+		TEST_LANES("cmov s",  cc0::wide::cmov(c, x, b[0]), m[i] ? a[i] : b[0]);
+		TEST_LANES("bool",    wide_t(x < y),               a[i] < b[i] ? 1 : 0);
+		TEST_LANES("from int",  wide_t(cc0::wide::load<int_t>(n)),  serial_t(n[i]));
+		TEST_LANES("from uint", wide_t(cc0::wide::load<uint_t>(u)), serial_t(u[i]));
+		TEST_LANES("to int",    int_t(cc0::wide::load<wide_t>(f)),  f[i]);
+		TEST_LANES("to uint",   uint_t(cc0::wide::load<wide_t>(g)), g[i]);
+
+		TEST_MASK("==",       x == y,    a[i] == b[i]);
+		TEST_MASK("!=",       x != y,    a[i] != b[i]);
+		TEST_MASK("<",        x <  y,    a[i] <  b[i]);
+		TEST_MASK(">",        x >  y,    a[i] >  b[i]);
+		TEST_MASK("<=",       x <= y,    a[i] <= b[i]);
+		TEST_MASK(">=",       x >= y,    a[i] >= b[i]);
+		TEST_MASK(">= s",     x >= b[0], a[i] >= b[0]);
+		TEST_MASK("mask",     mask_t(x), a[i] != 0);
+	}
+}
+
+
+/// @brief Combines the lanes of an array pairwise in the same order as the reductions, i.e. the upper half of the remaining lanes into the lower half.
+template < typename serial_t, uint32_t W, typename op_t >
+serial_t pairwise(const serial_t (&x)[W], op_t op)
+{
+	serial_t t[W];
+	std::copy(x, x + W, t);
+	for (uint32_t n = W / 2; n > 0; n /= 2) {
+		for (uint32_t i = 0; i < n; ++i) { t[i] = op(t[i], t[i + n]); }
+	}
+	return t[0];
+}
+
+
+/// @brief Checks the reductions against the same combination of the lanes, and the mask queries against the lanes of random, empty, and full masks.
+template < typename wide_t >
+void reductions( void )
+{
+	typedef typename wide_t::serial_t                         serial_t;
+	typedef cc0::wide::wide_bool<wide_t::depth,wide_t::width> mask_t;
+	typedef typename mask_t::serial_t                         bits_t;
+	const uint32_t W       = wide_t::width;
+	const bool     integer = std::numeric_limits<serial_t>::is_integer;
+	uint64_t       seed    = W * wide_t::depth + 3;
+	for (uint32_t iteration = 0; iteration < 200; ++iteration) {
+		serial_t a[W];
+		bits_t   m[W];
+		for (uint32_t i = 0; i < W; ++i) {
+			a[i] = iteration % 10 == 9 && !integer && i == iteration % W ? std::numeric_limits<serial_t>::quiet_NaN() : test::value<serial_t>(seed);
+			m[i] = iteration == 1 || (iteration > 1 && test::random(seed) % (iteration % 4 + 2) != 0) ? bits_t(~bits_t(0)) : bits_t(0);
+		}
+		const wide_t x = cc0::wide::load<wide_t>(a);
+		const mask_t c = cc0::wide::load<mask_t>(m);
+
+		test::check(test::same(cc0::wide::reduce_add(x), test::pairwise(a, [](serial_t l, serial_t r) { return serial_t(l + r); })), "reduce_add", test::name<serial_t>(), wide_t::depth, W, iteration);
+		test::check(test::same(cc0::wide::reduce_min(x), test::pairwise(a, [](serial_t l, serial_t r) { return l < r ? l : r; })), "reduce_min", test::name<serial_t>(), wide_t::depth, W, iteration);
+		test::check(test::same(cc0::wide::reduce_max(x), test::pairwise(a, [](serial_t l, serial_t r) { return r < l ? l : r; })), "reduce_max", test::name<serial_t>(), wide_t::depth, W, iteration);
+
+		uint64_t bits  = 0;
+		uint32_t count = 0;
+		for (uint32_t i = 0; i < W; ++i) {
+			bits  |= uint64_t(m[i] != 0) << i;
+			count += uint32_t(m[i] != 0);
+		}
+		test::check(cc0::wide::movemask(c) == bits, "movemask", test::name<serial_t>(), wide_t::depth, W, iteration);
+		test::check(cc0::wide::popcount(c) == count, "popcount", test::name<serial_t>(), wide_t::depth, W, iteration);
+		test::check(cc0::wide::any(c) == (count > 0), "any", test::name<serial_t>(), wide_t::depth, W, iteration);
+		test::check(cc0::wide::all(c) == (count == W), "all", test::name<serial_t>(), wide_t::depth, W, iteration);
+		test::check(cc0::wide::none(c) == (count == 0), "none", test::name<serial_t>(), wide_t::depth, W, iteration);
+	}
+}
+
+
+/// @brief Checks the bitwise reductions of integers, which have no floating-point counterpart.
+template < typename wide_t >
+void bitwise_reductions( void )
+{
+	typedef typename wide_t::serial_t serial_t;
+	const uint32_t W    = wide_t::width;
+	uint64_t       seed = W * wide_t::depth + 5;
+	for (uint32_t iteration = 0; iteration < 200; ++iteration) {
+		serial_t a[W];
+		for (uint32_t i = 0; i < W; ++i) {
+			// Sets most bits for some of the iterations, so that the AND is not always zero.
+			a[i] = iteration % 2 ? serial_t(test::value<serial_t>(seed) | test::value<serial_t>(seed) | test::value<serial_t>(seed)) : test::value<serial_t>(seed);
+		}
+		const wide_t x = cc0::wide::load<wide_t>(a);
+		test::check(cc0::wide::reduce_and(x) == test::pairwise(a, [](serial_t l, serial_t r) { return serial_t(l & r); }), "reduce_and", test::name<serial_t>(), wide_t::depth, W, iteration);
+		test::check(cc0::wide::reduce_or(x)  == test::pairwise(a, [](serial_t l, serial_t r) { return serial_t(l | r); }), "reduce_or",  test::name<serial_t>(), wide_t::depth, W, iteration);
+		test::check(cc0::wide::reduce_xor(x) == test::pairwise(a, [](serial_t l, serial_t r) { return serial_t(l ^ r); }), "reduce_xor", test::name<serial_t>(), wide_t::depth, W, iteration);
+	}
+}
+
+
+/// @brief Checks that popcount counts beyond the range of the serial type of the mask.
+template < uint32_t Depth, uint32_t Width >
+void popcount_wide_mask( void )
+{
+	const cc0::wide::wide_bool<Depth,Width> c(true);
+	test::check(cc0::wide::popcount(c) == Width, "popcount", "bool", Depth, Width, Width);
+	test::check(cc0::wide::popcount(!c) == 0, "popcount", "bool", Depth, Width, 0);
+}
+
+
+/// @brief Checks the aligned, unaligned, and streaming loads and stores, and the masked loads and stores on the tail of an array, where memory past the end must not be accessed.
+template < typename wide_t >
+void memory( void )
+{
+	typedef typename wide_t::serial_t                         serial_t;
+	typedef cc0::wide::wide_bool<wide_t::depth,wide_t::width> mask_t;
+	typedef typename mask_t::serial_t                         bits_t;
+	const uint32_t W    = wide_t::width;
+	uint64_t       seed = W * wide_t::depth + 7;
+	for (uint32_t iteration = 0; iteration < 100; ++iteration) {
+		alignas(wide_t) serial_t a[2 * W];
+		alignas(wide_t) serial_t o[2 * W];
+		for (uint32_t i = 0; i < 2 * W; ++i) { a[i] = test::value<serial_t>(seed); }
+		const uint32_t k = iteration % W;
+		TEST_LANES("load",         cc0::wide::load<wide_t>(a + k),      a[k + i]);
+		TEST_LANES("load_aligned", cc0::wide::load_aligned<wide_t>(a),  a[i]);
+		cc0::wide::store(o + k, cc0::wide::load<wide_t>(a));
+		test::check(std::memcmp(o + k, a, sizeof(wide_t)) == 0, "store", test::name<serial_t>(), wide_t::depth, W, iteration);
+		cc0::wide::store_aligned(o, cc0::wide::load<wide_t>(a + k));
+		test::check(std::memcmp(o, a + k, sizeof(wide_t)) == 0, "store_aligned", test::name<serial_t>(), wide_t::depth, W, iteration);
+		cc0::wide::stream_store(o + W, cc0::wide::load<wide_t>(a + k));
+		cc0::wide::stream_fence();
+		test::check(std::memcmp(o + W, a + k, sizeof(wide_t)) == 0, "stream_store", test::name<serial_t>(), wide_t::depth, W, iteration);
+
+		// The tail is the last 'n' elements of a vector, so that memory checkers catch accesses past the end.
+		const uint32_t n = iteration % (W + 1);
+		const std::vector<serial_t> tail(a, a + n);
+		const mask_t                t = cc0::wide::tail_mask<wide_t>(n);
+		TEST_MASK("tail_mask",   t, i < n);
+		TEST_LANES("load_masked", cc0::wide::load_masked<wide_t>(tail.data(), t), i < n ? a[i] : serial_t(0));
+		std::vector<serial_t> out(n);
+		cc0::wide::store_masked(out.data(), cc0::wide::load<wide_t>(a + W), t);
+		test::check(std::equal(out.begin(), out.end(), a + W, [](serial_t l, serial_t r) { return test::same(l, r); }), "store_masked", test::name<serial_t>(), wide_t::depth, W, iteration);
+
+		// Masks that are not a prefix must leave the lanes in between untouched.
+		bits_t m[W];
+		for (uint32_t i = 0; i < W; ++i) { m[i] = test::random(seed) % 2 ? bits_t(~bits_t(0)) : bits_t(0); }
+		const mask_t c = cc0::wide::load<mask_t>(m);
+		TEST_LANES("load_masked", cc0::wide::load_masked<wide_t>(a, c), m[i] ? a[i] : serial_t(0));
+		std::memcpy(o, a, sizeof(wide_t));
+		cc0::wide::store_masked(o, cc0::wide::load<wide_t>(a + W), c);
+		TEST_LANES("store_masked", cc0::wide::load<wide_t>(o), m[i] ? a[W + i] : a[i]);
+	}
+}
+
+
+/// @brief Checks gather and scatter, with and without masks, for indices with many duplicates. Where several lanes scatter to the same index, the highest active lane must remain in memory.
+template < typename wide_t >
+void gather( void )
+{
+	typedef typename wide_t::serial_t                         serial_t;
+	typedef cc0::wide::wide_bool<wide_t::depth,wide_t::width> mask_t;
+	typedef typename mask_t::serial_t                         bits_t;
+	typedef cc0::wide::wide_int<wide_t::depth,wide_t::width>  index_t;
+	typedef typename index_t::serial_t                        offset_t;
+	const uint32_t W    = wide_t::width;
+	const uint32_t N    = 100;
+	uint64_t       seed = W * wide_t::depth + 11;
+	for (uint32_t iteration = 0; iteration < 200; ++iteration) {
+		serial_t table[N];
+		offset_t k[W];
+		bits_t   m[W];
+		serial_t a[W];
+		// Fewer distinct indices than lanes for some iterations, which forces duplicates.
+		const uint32_t distinct = iteration % 2 ? W / 2 + 1 : N;
+		for (uint32_t i = 0; i < N; ++i) { table[i] = test::value<serial_t>(seed); }
+		for (uint32_t i = 0; i < W; ++i) {
+			k[i] = offset_t(test::random(seed) % distinct);
+			m[i] = test::random(seed) % 2 ? bits_t(~bits_t(0)) : bits_t(0);
+			a[i] = test::value<serial_t>(seed);
+		}
+		const index_t index = cc0::wide::load<index_t>(k);
+		const mask_t  c     = cc0::wide::load<mask_t>(m);
+		const wide_t  x     = cc0::wide::load<wide_t>(a);
+		TEST_LANES("gather", cc0::wide::gather<wide_t>(table, index),    table[k[i]]);
+		TEST_LANES("gather", cc0::wide::gather<wide_t>(table, index, c), m[i] ? table[k[i]] : serial_t(0));
+
+		serial_t expected[N];
+		serial_t scattered[N];
+		std::copy(table, table + N, expected);
+		std::copy(table, table + N, scattered);
+		for (uint32_t i = 0; i < W; ++i) { expected[k[i]] = a[i]; }
+		cc0::wide::scatter(scattered, index, x);
+		test::check(std::equal(scattered, scattered + N, expected, [](serial_t l, serial_t r) { return test::same(l, r); }), "scatter", test::name<serial_t>(), wide_t::depth, W, iteration);
+
+		std::copy(table, table + N, expected);
+		std::copy(table, table + N, scattered);
+		for (uint32_t i = 0; i < W; ++i) {
+			if (m[i]) { expected[k[i]] = a[i]; }
+		}
+		cc0::wide::scatter(scattered, index, x, c);
+		test::check(std::equal(scattered, scattered + N, expected, [](serial_t l, serial_t r) { return test::same(l, r); }), "scatter masked", test::name<serial_t>(), wide_t::depth, W, iteration);
+	}
+}
+
+
+/// @brief Checks a wide_vector against a std::vector holding the same elements, both through the serial view and through the wide view, where the padding lanes past the last element must be zero.
+template < typename wide_t, size_t Alignment >
+bool same_contents(const cc0::wide::wide_vector<wide_t,Alignment> &v, const std::vector<typename wide_t::serial_t> &expected)
+{
+	typedef typename wide_t::serial_t serial_t;
+	const uint32_t W = wide_t::width;
+	if (v.size() != expected.size() || v.wide_size() != (expected.size() + W - 1) / W || size_t(v.end() - v.begin()) != v.wide_size() || size_t(v.serial_end() - v.serial_begin()) != v.size()) {
+		return false;
+	}
+	if (v.wide_size() > 0 && (reinterpret_cast<uintptr_t>(v.data()) % Alignment != 0 || static_cast<const void*>(v.data()) != static_cast<const void*>(v.wide_data()))) {
+		return false;
+	}
+	std::vector<serial_t> padded(expected);
+	padded.resize(v.wide_size() * W, serial_t(0));
+	for (size_t i = 0; i < expected.size(); ++i) {
+		if (!test::same(v[i], expected[i])) { return false; }
+	}
+	for (size_t b = 0; b < v.wide_size(); ++b) {
+		if (!test::equal(v.block(b), padded.data() + b * W)) { return false; }
+	}
+	return true;
+}
+
+
+/// @brief Checks wide_vector against std::vector under a random sequence of insertions, removals, and resizes, as well as the tail masks, shared storage of the serial and wide views, copies, and moves.
+template < typename wide_t, size_t Alignment >
+void container( void )
+{
+	typedef typename wide_t::serial_t                   serial_t;
+	typedef cc0::wide::wide_vector<wide_t,Alignment>    vector_t;
+	const uint32_t W    = wide_t::width;
+	uint64_t       seed = W * wide_t::depth + Alignment;
+	vector_t              v;
+	std::vector<serial_t> e;
+	for (uint32_t iteration = 0; iteration < 300; ++iteration) {
+		const serial_t x = test::value<serial_t>(seed);
+		switch (test::random(seed) % 8) {
+		case 0:
+		case 1:
+		case 2:
+			v.push_back(x);
+			e.push_back(x);
+			break;
+		case 3:
+		case 4:
+			if (!e.empty()) {
+				v.pop_back();
+				e.pop_back();
+			}
+			break;
+		case 5: {
+			const size_t n = test::random(seed) % (4 * W + 1);
+			v.resize(n, x);
+			e.resize(n, x);
+			break;
+		}
+		case 6:
+			if (iteration % 5 == 0) {
+				v.clear();
+				e.clear();
+			}
+			break;
+		default: {
+			// Writes through one view must be visible through the other.
+			if (!e.empty()) {
+				const size_t b = test::random(seed) % v.wide_size();
+				const size_t n = e.size() - b * W < W ? e.size() - b * W : W;
+				serial_t     r[W];
+				for (uint32_t i = 0; i < W; ++i) { r[i] = test::value<serial_t>(seed); }
+				v.block(b) = cc0::wide::load<wide_t>(r);
+				std::copy(r, r + n, e.begin() + b * W);
+				// The write above also set the padding lanes, which are cleared again through the serial view.
+				for (size_t i = b * W + n; i < (b + 1) * W; ++i) { v.data()[i] = serial_t(0); }
+				v[e.size() - 1] = x;
+				e.back() = x;
+			}
+			break;
+		}
+		}
+		test::check(v.capacity() >= v.size() && test::same_contents(v, e), "wide_vector", test::name<serial_t>(), wide_t::depth, W, iteration);
+		for (size_t b = 0; b <= v.wide_size(); ++b) {
+			TEST_MASK("wide_vector mask", v.mask(b), b * W + i < v.size());
+		}
+
+		if (iteration % 10 == 0) {
+			vector_t c(v);
+			test::check(test::same_contents(c, e) && (c.empty() || c.data() != v.data()), "wide_vector copy", test::name<serial_t>(), wide_t::depth, W, iteration);
+			if (!c.empty()) {
+				c[0] = serial_t(c[0] + serial_t(1));
+				test::check(test::same_contents(v, e), "wide_vector copy", test::name<serial_t>(), wide_t::depth, W, iteration);
+			}
+			vector_t s(1, x);
+			s = v;
+			vector_t l(5 * W, x);
+			l = v;
+			test::check(test::same_contents(s, e) && test::same_contents(l, e), "wide_vector copy assign", test::name<serial_t>(), wide_t::depth, W, iteration);
+			const serial_t *p = l.data();
+			vector_t m(std::move(l));
+			test::check(test::same_contents(m, e) && m.data() == p && l.empty() && test::same_contents(l, std::vector<serial_t>()), "wide_vector move", test::name<serial_t>(), wide_t::depth, W, iteration);
+			s = std::move(m);
+			test::check(test::same_contents(s, e) && s.data() == p, "wide_vector move assign", test::name<serial_t>(), wide_t::depth, W, iteration);
+		}
+	}
+	static_assert(std::is_nothrow_move_constructible<vector_t>::value && std::is_nothrow_move_assignable<vector_t>::value, "wide_vector must be nothrow movable");
+}
+
+
+/// @brief Checks loading and storing N fields per record against serial indexing, for the given number of fields.
+template < typename wide_t, size_t N >
+void aos(uint64_t &seed, uint32_t iteration)
+{
+	typedef typename wide_t::serial_t serial_t;
+	const uint32_t W = wide_t::width;
+	serial_t records[N * W];
+	serial_t out[N * W];
+	wide_t   fields[N];
+	for (uint32_t i = 0; i < N * W; ++i) { records[i] = test::value<serial_t>(seed); }
+	cc0::wide::load_aos(records, fields);
+	for (uint32_t f = 0; f < N; ++f) {
+		TEST_LANES("load_aos", fields[f], records[i * N + f]);
+	}
+	cc0::wide::store_aos(out, fields);
+	test::check(std::memcmp(out, records, sizeof(out)) == 0, "store_aos", test::name<serial_t>(), wide_t::depth, W, iteration);
+}
+
+
+/// @brief Checks the functions that move lanes within and between wide values against serial indexing.
+template < typename wide_t >
+void lanes( void )
+{
+	typedef typename wide_t::serial_t                        serial_t;
+	typedef cc0::wide::wide_int<wide_t::depth,wide_t::width> index_t;
+	typedef typename index_t::serial_t                       offset_t;
+	const int32_t W    = int32_t(wide_t::width);
+	uint64_t      seed = uint64_t(W) * wide_t::depth + 13;
+	for (uint32_t iteration = 0; iteration < 100; ++iteration) {
+		serial_t a[wide_t::width];
+		serial_t b[wide_t::width];
+		offset_t k[wide_t::width];
+		for (int32_t i = 0; i < W; ++i) {
+			a[i] = test::value<serial_t>(seed);
+			b[i] = test::value<serial_t>(seed);
+			k[i] = test::value<offset_t>(seed);
+		}
+		const wide_t x = cc0::wide::load<wide_t>(a);
+		const wide_t y = cc0::wide::load<wide_t>(b);
+		TEST_LANES("permute",       cc0::wide::permute(x, cc0::wide::load<index_t>(k)), a[uint32_t(k[i]) & uint32_t(W - 1)]);
+		TEST_LANES("interleave_lo", cc0::wide::interleave_lo(x, y),                      i % 2 ? b[i / 2] : a[i / 2]);
+		TEST_LANES("interleave_hi", cc0::wide::interleave_hi(x, y),                      i % 2 ? b[W / 2 + i / 2] : a[W / 2 + i / 2]);
+		TEST_LANES("rotate_lanes",  cc0::wide::rotate_lanes<1>(x),                       a[(i + 1) % W]);
+		TEST_LANES("rotate_lanes",  cc0::wide::rotate_lanes<-3>(x),                      a[(int32_t(i) - 3 + 4 * W) % W]);
+		TEST_LANES("shift_lanes",   cc0::wide::shift_lanes<1>(x),                        int32_t(i) + 1 < W ? a[i + 1] : serial_t(0));
+		TEST_LANES("shift_lanes",   cc0::wide::shift_lanes<-3>(x),                       int32_t(i) - 3 >= 0 ? a[i - 3] : serial_t(0));
+
+		serial_t m[wide_t::width * wide_t::width];
+		wide_t   rows[wide_t::width];
+		for (int32_t i = 0; i < W * W; ++i) { m[i] = test::value<serial_t>(seed); }
+		for (int32_t r = 0; r < W; ++r)     { rows[r] = cc0::wide::load<wide_t>(m + r * W); }
+		cc0::wide::transpose(rows);
+		for (int32_t r = 0; r < W; ++r) {
+			TEST_LANES("transpose", rows[r], m[i * W + r]);
+		}
+
+		test::aos<wide_t,3>(seed, iteration);
+		test::aos<wide_t,wide_t::width>(seed, iteration);
+	}
+}
+
+
+/// @brief Checks rcp, rsqrt, and their approximations against the exact results, within the relative error documented for 32-bit native types and exactly otherwise, as well as the results for signed zero, infinity, NaN, and negative input.
+template < typename wide_t >
+void reciprocals( void )
+{
+	typedef typename wide_t::serial_t     serial_t;
+	typedef std::numeric_limits<serial_t> limits;
+	const uint32_t W       = wide_t::width;
+	const double   approx  = wide_t::depth == 32 ? 1.5 / 4096.0 : 0.0;
+	const double   refined = wide_t::depth == 32 ? 1.0 / 4194304.0 : 0.0;
+	const serial_t special[] = { serial_t(0), serial_t(-0.0), limits::infinity(), -limits::infinity(), limits::quiet_NaN() };
+	const size_t   S         = sizeof(special) / sizeof(special[0]);
+	uint64_t       seed      = W * wide_t::depth + 17;
+	for (uint32_t iteration = 0; iteration < 1000; ++iteration) {
+		serial_t x[W];
+		for (uint32_t i = 0; i < W; ++i) {
+			// Magnitudes stay well within the normal range, so that neither the input nor the result is subnormal.
+			const double m = 1.0 + double(test::random(seed) % 1000000) / 1000000.0;
+			x[i] = serial_t(std::ldexp(test::random(seed) % 2 ? -m : m, int(test::random(seed) % 201) - 100));
+			if (iteration % 10 == 0) { x[i] = special[(iteration / 10 * W + i) % S]; }
+		}
+		serial_t o[4][W];
+		const wide_t v = cc0::wide::load<wide_t>(x);
+		cc0::wide::store(o[0], cc0::wide::rcp_approx(v));
+		cc0::wide::store(o[1], cc0::wide::rcp(v));
+		cc0::wide::store(o[2], cc0::wide::rsqrt_approx(v));
+		cc0::wide::store(o[3], cc0::wide::rsqrt(v));
+		bool ok[4] = { true, true, true, true };
+		for (uint32_t i = 0; i < W; ++i) {
+			const serial_t r = serial_t(1) / x[i];
+			const serial_t s = serial_t(1) / std::sqrt(x[i]);
+			if (iteration % 10 == 0) {
+				ok[0] = ok[0] && test::same(o[0][i], r);
+				ok[1] = ok[1] && test::same(o[1][i], r);
+				ok[2] = ok[2] && test::same(o[2][i], s);
+				ok[3] = ok[3] && test::same(o[3][i], s);
+			} else {
+				ok[0] = ok[0] && std::fabs(double(o[0][i]) - double(r)) <= approx * std::fabs(double(r));
+				ok[1] = ok[1] && std::fabs(double(o[1][i]) - double(r)) <= refined * std::fabs(double(r));
+				ok[2] = ok[2] && (x[i] < serial_t(0) ? test::is_nan(o[2][i]) : std::fabs(double(o[2][i]) - double(s)) <= approx * std::fabs(double(s)));
+				ok[3] = ok[3] && (x[i] < serial_t(0) ? test::is_nan(o[3][i]) : std::fabs(double(o[3][i]) - double(s)) <= refined * std::fabs(double(s)));
+			}
+		}
+		test::check(ok[0], "rcp_approx",   test::name<serial_t>(), wide_t::depth, W, iteration);
+		test::check(ok[1], "rcp",          test::name<serial_t>(), wide_t::depth, W, iteration);
+		test::check(ok[2], "rsqrt_approx", test::name<serial_t>(), wide_t::depth, W, iteration);
+		test::check(ok[3], "rsqrt",        test::name<serial_t>(), wide_t::depth, W, iteration);
+	}
+}
+
+
+/// @brief Checks fma, fms, and fnma against std::fma. Native types with FMA support must round only once and match exactly, other types must be within the error of a separate multiply and add. Products and sums of the special values are exact, so all types must match exactly for these, including NaN from infinity times zero or infinity minus infinity.
+template < typename wide_t >
+void fused( void )
+{
+	typedef typename wide_t::serial_t     serial_t;
+	typedef std::numeric_limits<serial_t> limits;
+	const uint32_t W = wide_t::width;
+#if defined(CC0_WIDE_NATIVE_FMA) && defined(CC0_WIDE_NATIVE_AVX2)
+	const bool exact = (wide_t::depth == 32 && W == 4) || (wide_t::depth == 32 && W == 8) || (wide_t::depth == 64 && W == 4);
+#elif defined(CC0_WIDE_NATIVE_FMA) && defined(CC0_WIDE_NATIVE_SSE4_1)
+	const bool exact = wide_t::depth == 32 && W == 4;
+#else
+	const bool exact = false;
+#endif
+	const serial_t special[] = { serial_t(0), serial_t(-0.0), serial_t(1), serial_t(-1), serial_t(2.5), limits::infinity(), -limits::infinity(), limits::quiet_NaN() };
+	const size_t   S         = sizeof(special) / sizeof(special[0]);
+	uint64_t       seed      = W * wide_t::depth + 19;
+	for (uint32_t iteration = 0; iteration < 1000; ++iteration) {
+		serial_t a[W];
+		serial_t b[W];
+		serial_t c[W];
+		for (uint32_t i = 0; i < W; ++i) {
+			a[i] = test::value<serial_t>(seed);
+			b[i] = test::value<serial_t>(seed);
+			c[i] = test::value<serial_t>(seed);
+			if (iteration % 2 == 0) {
+				const size_t k = (iteration / 2 * W + i) % (S * S * S);
+				a[i] = special[k % S];
+				b[i] = special[k / S % S];
+				c[i] = special[k / (S * S)];
+			}
+		}
+		const wide_t x = cc0::wide::load<wide_t>(a);
+		const wide_t y = cc0::wide::load<wide_t>(b);
+		const wide_t z = cc0::wide::load<wide_t>(c);
+		serial_t o[3][W];
+		cc0::wide::store(o[0], cc0::wide::fma(x, y, z));
+		cc0::wide::store(o[1], cc0::wide::fms(x, y, z));
+		cc0::wide::store(o[2], cc0::wide::fnma(x, y, z));
+		bool ok[3] = { true, true, true };
+		for (uint32_t i = 0; i < W; ++i) {
+			const serial_t r[3]      = { std::fma(a[i], b[i], c[i]), std::fma(a[i], b[i], -c[i]), std::fma(-a[i], b[i], c[i]) };
+			const double   tolerance = 2.0 * double(limits::epsilon()) * (std::fabs(double(a[i]) * double(b[i])) + std::fabs(double(c[i])));
+			for (uint32_t f = 0; f < 3; ++f) {
+				ok[f] = ok[f] && (test::same(o[f][i], r[f]) || (!exact && iteration % 2 == 1 && std::fabs(double(o[f][i]) - double(r[f])) <= tolerance));
+			}
+		}
+		test::check(ok[0], "fma",  test::name<serial_t>(), wide_t::depth, W, iteration);
+		test::check(ok[1], "fms",  test::name<serial_t>(), wide_t::depth, W, iteration);
+		test::check(ok[2], "fnma", test::name<serial_t>(), wide_t::depth, W, iteration);
+	}
+}
+
+
+/// @brief Checks sqrt against std::sqrt, which is correctly rounded, on random bit patterns, i.e. including negative, subnormal, infinite, and NaN input. Also checks that the iterative square roots in wmath.h share its NaN semantics, i.e. NaN exactly for negative and NaN input.
+template < typename wide_t >
+void square_root( void )
+{
+	typedef typename wide_t::serial_t     serial_t;
+	typedef std::numeric_limits<serial_t> limits;
+	const uint32_t W         = wide_t::width;
+	const serial_t special[] = { serial_t(0), serial_t(-0.0), serial_t(-1), limits::infinity(), -limits::infinity(), limits::quiet_NaN(), -limits::denorm_min(), limits::denorm_min() };
+	const size_t   S         = sizeof(special) / sizeof(special[0]);
+	uint64_t       seed      = W * wide_t::depth + 29;
+	for (uint32_t iteration = 0; iteration < 1000; ++iteration) {
+		serial_t x[W];
+		serial_t y[W];
+		for (uint32_t i = 0; i < W; ++i) {
+			const uint64_t r = test::random(seed) ^ (test::random(seed) << 32);
+			std::memcpy(&x[i], &r, sizeof(serial_t));
+			y[i] = iteration % 4 == 0 ? special[(iteration / 4 * W + i) % S] : test::value<serial_t>(seed);
+			if (iteration % 4 == 0) { x[i] = y[i]; }
+		}
+		serial_t o[3][W];
+		cc0::wide::store(o[0], cc0::wide::sqrt(cc0::wide::load<wide_t>(x)));
+		cc0::wide::store(o[1], cc0::wide::sqrt_nr(cc0::wide::load<wide_t>(y)));
+		cc0::wide::store(o[2], cc0::wide::sqrt_bs(cc0::wide::load<wide_t>(y)));
+		bool ok[3] = { true, true, true };
+		for (uint32_t i = 0; i < W; ++i) {
+			const bool undefined = test::is_nan(y[i]) || y[i] < serial_t(0);
+			ok[0] = ok[0] && test::same(o[0][i], std::sqrt(x[i]));
+			ok[1] = ok[1] && test::is_nan(o[1][i]) == undefined;
+			ok[2] = ok[2] && test::is_nan(o[2][i]) == undefined;
+		}
+		test::check(ok[0], "sqrt",    test::name<serial_t>(), wide_t::depth, W, iteration);
+		test::check(ok[1], "sqrt_nr", test::name<serial_t>(), wide_t::depth, W, iteration);
+		test::check(ok[2], "sqrt_bs", test::name<serial_t>(), wide_t::depth, W, iteration);
+	}
+}
+
+
+/// @brief Checks division and remainder by a divider against the built-in operators on each lane, for random divisors as well as one, minus one, powers of two, and the extremes of the type, and dividends that include the extremes of the type.
+template < typename wide_t >
+void divider( void )
+{
+	typedef typename wide_t::serial_t     serial_t;
+	typedef std::numeric_limits<serial_t> limits;
+	const uint32_t W         = wide_t::width;
+	const serial_t special[] = { serial_t(1), serial_t(-1), serial_t(2), serial_t(3), serial_t(7), serial_t(10), serial_t(serial_t(1) << (wide_t::depth - 2)), limits::max(), limits::min(), serial_t(limits::max() / 3) };
+	const size_t   S         = sizeof(special) / sizeof(special[0]);
+	uint64_t       seed      = W * wide_t::depth + 31;
+	for (uint32_t iteration = 0; iteration < 2000; ++iteration) {
+		serial_t d = iteration < 2 * S ? special[iteration % S] : test::value<serial_t>(seed);
+		if (d == serial_t(0)) { d = serial_t(1); }
+		if (iteration % 2 == 1 && limits::is_signed && d != limits::min()) { d = serial_t(-d); }
+		serial_t a[W];
+		for (uint32_t i = 0; i < W; ++i) {
+			a[i] = test::value<serial_t>(seed);
+			if (iteration % 3 == 0) { a[i] = i % 3 == 0 ? limits::min() : (i % 3 == 1 ? limits::max() : serial_t(0)); }
+			// The quotient of the lowest value and minus one does not fit the type.
+			if (a[i] == limits::min() && d == serial_t(-1) && limits::is_signed) { a[i] = serial_t(a[i] + serial_t(1)); }
+		}
+		const cc0::wide::divider<wide_t> div(d);
+		const wide_t                     x = cc0::wide::load<wide_t>(a);
+		TEST_LANES("divider /", x / div, a[i] / d);
+		TEST_LANES("divider %", x % div, a[i] % d);
+		test::check(div.divisor() == d, "divider divisor", test::name<serial_t>(), wide_t::depth, W, iteration);
+	}
+}
+
+
+/// @brief Checks the integer logarithms and parity tests of wmath.h, which were rewritten in terms of bit operations and comparisons, against serial loops.
+template < typename wide_t >
+void integer_math( void )
+{
+	typedef typename wide_t::serial_t serial_t;
+	const uint32_t W    = wide_t::width;
+	uint64_t       seed = W * wide_t::depth + 37;
+	for (uint32_t iteration = 0; iteration < 200; ++iteration) {
+		serial_t a[W];
+		int32_t  l2[W];
+		int32_t  l10[W];
+		for (uint32_t i = 0; i < W; ++i) {
+			a[i] = test::value<serial_t>(seed);
+			if (iteration % 2 == 0) { a[i] = serial_t(a[i] >> (test::random(seed) % wide_t::depth)); }
+			l2[i]  = -1;
+			l10[i] = -1;
+			for (serial_t n = a[i]; n > 0; n = serial_t(n / 2))  { ++l2[i]; }
+			for (serial_t n = a[i]; n > 0; n = serial_t(n / 10)) { ++l10[i]; }
+		}
+		const wide_t x = cc0::wide::load<wide_t>(a);
+		TEST_LANES("log2",  cc0::wide::log2(x),  l2[i]);
+		TEST_LANES("log10", cc0::wide::log10(x), l10[i]);
+		TEST_MASK("even",   cc0::wide::even(x),  a[i] % 2 == 0);
+		TEST_MASK("odd",    cc0::wide::odd(x),   a[i] % 2 != 0);
+	}
+}
+
+
+/// @brief Checks the bit operations against serial loops over the bits of each lane, for random bit patterns as well as zero, all bits set, and single set bits.
+template < typename wide_t >
+void bits( void )
+{
+	typedef typename wide_t::serial_t                     serial_t;
+	typedef typename std::make_unsigned<serial_t>::type   userial_t;
+	const uint32_t D    = wide_t::depth;
+	const uint32_t W    = wide_t::width;
+	const uint64_t all  = D == 64 ? ~uint64_t(0) : (uint64_t(1) << D) - 1;
+	uint64_t       seed = W * D + 41;
+	// Rotates the lowest 'D' bits towards the most significant bit.
+	const auto rotl = [D, all](uint64_t u, uint64_t n) { const uint32_t s = uint32_t(n % D); return s == 0 ? u : ((u << s) | (u >> (D - s))) & all; };
+	for (uint32_t iteration = 0; iteration < 500; ++iteration) {
+		serial_t a[W];
+		serial_t b[W];
+		uint64_t u[W];
+		uint64_t v[W];
+		for (uint32_t i = 0; i < W; ++i) {
+			a[i] = test::value<serial_t>(seed);
+			b[i] = test::value<serial_t>(seed);
+			if (iteration % 4 == 0) {
+				const uint32_t k = test::random(seed) % 4;
+				a[i] = k == 0 ? serial_t(0) : (k == 1 ? serial_t(~userial_t(0)) : (k == 2 ? serial_t(1) : serial_t(userial_t(1) << (D - 1))));
+			}
+			u[i] = uint64_t(userial_t(a[i]));
+			v[i] = uint64_t(userial_t(b[i]));
+		}
+		int32_t n = int32_t(test::random(seed) % (4 * D)) - int32_t(2 * D);
+		const wide_t x = cc0::wide::load<wide_t>(a);
+		const wide_t y = cc0::wide::load<wide_t>(b);
+		uint64_t count[W], swapped[W], reversed[W], width[W], trailing[W];
+		for (uint32_t i = 0; i < W; ++i) {
+			count[i] = swapped[i] = reversed[i] = width[i] = 0;
+			trailing[i] = D;
+			for (uint32_t k = 0; k < D; ++k) {
+				const uint64_t bit = (u[i] >> k) & 1;
+				count[i]    += bit;
+				reversed[i] |= bit << (D - 1 - k);
+				width[i]     = bit ? k + 1 : width[i];
+				trailing[i]  = bit && trailing[i] == D ? k : trailing[i];
+			}
+			for (uint32_t k = 0; k < D; k += 8) {
+				swapped[i] |= ((u[i] >> k) & 0xff) << (D - 8 - k);
+			}
+		}
+		TEST_LANES("popcount",    cc0::wide::popcount(x),    count[i]);
+		TEST_LANES("byteswap",    cc0::wide::byteswap(x),    swapped[i]);
+		TEST_LANES("bit_reverse", cc0::wide::bit_reverse(x), reversed[i]);
+		TEST_LANES("countl_zero", cc0::wide::countl_zero(x), D - width[i]);
+		TEST_LANES("countr_zero", cc0::wide::countr_zero(x), trailing[i]);
+		TEST_LANES("bit_width",   cc0::wide::bit_width(x),   width[i]);
+		TEST_LANES("rotl",        cc0::wide::rotl(x, n),     rotl(u[i], uint64_t(int64_t(n) + 2 * D)));
+		TEST_LANES("rotr",        cc0::wide::rotr(x, n),     rotl(u[i], uint64_t(2 * D - int64_t(n))));
+		TEST_LANES("rotl lanes",  cc0::wide::rotl(x, y),     rotl(u[i], v[i] % D));
+		TEST_LANES("rotr lanes",  cc0::wide::rotr(x, y),     rotl(u[i], D - v[i] % D));
+	}
+}
+
+
+/// @brief Returns the upper half of the full product of two serial integers narrower than 64 bits, computed in 64 bits.
+template < typename serial_t >
+serial_t mulhi(serial_t a, serial_t b, std::false_type)
+{
+	typedef typename std::conditional<std::numeric_limits<serial_t>::is_signed, int64_t, uint64_t>::type product_t;
+	return serial_t((product_t(a) * product_t(b)) >> (sizeof(serial_t) * 8));
+}
+
+
+/// @brief Returns the upper half of the full product of two 64-bit serial integers, computed from 32-bit halves so that it does not rely on a wider type.
+template < typename serial_t >
+serial_t mulhi(serial_t a, serial_t b, std::true_type)
+{
+	const uint64_t x  = uint64_t(a);
+	const uint64_t y  = uint64_t(b);
+	const uint64_t ll = (x & 0xffffffff) * (y & 0xffffffff);
+	const uint64_t lh = (x & 0xffffffff) * (y >> 32);
+	const uint64_t hl = (x >> 32) * (y & 0xffffffff);
+	const uint64_t hh = (x >> 32) * (y >> 32);
+	const uint64_t m  = (ll >> 32) + (lh & 0xffffffff) + (hl & 0xffffffff);
+	uint64_t       hi = hh + (lh >> 32) + (hl >> 32) + (m >> 32);
+	// The signed product differs from the unsigned one by the other factor for each negative factor.
+	if (a < serial_t(0)) { hi -= y; }
+	if (b < serial_t(0)) { hi -= x; }
+	return serial_t(hi);
+}
+
+
+/// @brief Checks widen and narrow_saturate against converting and clamping each lane. Only available for bit depths that can be widened and narrowed.
+template < typename wide_t >
+void widening(std::false_type)
+{}
+
+template < typename wide_t >
+void widening(std::true_type)
+{
+	typedef typename wide_t::serial_t     serial_t;
+	typedef std::numeric_limits<serial_t> limits;
+	typedef decltype(cc0::wide::widen(std::declval<wide_t>()))          wider_t;
+	typedef decltype(cc0::wide::narrow_saturate(std::declval<wide_t>())) narrower_t;
+	typedef typename wider_t::serial_t    wide_serial_t;
+	typedef typename narrower_t::serial_t narrow_serial_t;
+	typedef std::numeric_limits<narrow_serial_t> narrow_limits;
+	const uint32_t W    = wide_t::width;
+	uint64_t       seed = W * wide_t::depth + 43;
+	for (uint32_t iteration = 0; iteration < 500; ++iteration) {
+		serial_t a[W];
+		serial_t b[W];
+		for (uint32_t i = 0; i < W; ++i) {
+			a[i] = test::value<serial_t>(seed);
+			b[i] = test::value<serial_t>(seed);
+			// Values around the limits of the narrower type.
+			if (iteration % 2 == 0) { b[i] = serial_t(test::random(seed) % 2 ? narrow_limits::max() : narrow_limits::min()) + serial_t(int(test::random(seed) % 3) - 1); }
+			if (iteration % 5 == 0) { a[i] = test::random(seed) % 2 ? limits::max() : limits::min(); }
+		}
+		const wide_t x = cc0::wide::load<wide_t>(a);
+		const wide_t y = cc0::wide::load<wide_t>(b);
+		const auto   clamp = [](serial_t v) { return v < serial_t(narrow_limits::min()) ? narrow_limits::min() : (v > serial_t(narrow_limits::max()) ? narrow_limits::max() : narrow_serial_t(v)); };
+		TEST_LANES("widen_lo",        cc0::wide::widen_lo(x),           wide_serial_t(a[i]));
+		TEST_LANES("widen_hi",        cc0::wide::widen_hi(x),           wide_serial_t(a[W / 2 + i]));
+		TEST_LANES("widen",           cc0::wide::widen(x),              wide_serial_t(a[i]));
+		TEST_LANES("narrow_saturate", cc0::wide::narrow_saturate(x),    clamp(a[i]));
+		TEST_LANES("narrow_saturate", cc0::wide::narrow_saturate(y),    clamp(b[i]));
+		TEST_LANES("narrow_saturate", cc0::wide::narrow_saturate(x, y), i < W ? clamp(a[i]) : clamp(b[i - W]));
+	}
+}
+
+
+/// @brief Checks the saturating and averaging arithmetic and mulhi against serial computations that can not overflow, with many operands at the limits of the type.
+template < typename wide_t >
+void saturate( void )
+{
+	typedef typename wide_t::serial_t     serial_t;
+	typedef std::numeric_limits<serial_t> limits;
+	const uint32_t W    = wide_t::width;
+	uint64_t       seed = W * wide_t::depth + 47;
+	for (uint32_t iteration = 0; iteration < 500; ++iteration) {
+		serial_t a[W];
+		serial_t b[W];
+		for (uint32_t i = 0; i < W; ++i) {
+			a[i] = test::value<serial_t>(seed);
+			b[i] = test::value<serial_t>(seed);
+			if (iteration % 3 == 0) { a[i] = test::random(seed) % 2 ? serial_t(limits::max() - serial_t(test::random(seed) % 3)) : serial_t(limits::min() + serial_t(test::random(seed) % 3)); }
+		}
+		const wide_t x = cc0::wide::load<wide_t>(a);
+		const wide_t y = cc0::wide::load<wide_t>(b);
+		TEST_LANES("adds",  cc0::wide::adds(x, y),  b[i] > serial_t(0) ? (a[i] > serial_t(limits::max() - b[i]) ? limits::max() : serial_t(a[i] + b[i])) : (a[i] < serial_t(limits::min() - b[i]) ? limits::min() : serial_t(a[i] + b[i])));
+		TEST_LANES("subs",  cc0::wide::subs(x, y),  b[i] > serial_t(0) ? (a[i] < serial_t(limits::min() + b[i]) ? limits::min() : serial_t(a[i] - b[i])) : (a[i] > serial_t(limits::max() + b[i]) ? limits::max() : serial_t(a[i] - b[i])));
+		TEST_LANES("avg",   cc0::wide::avg(x, y),   serial_t((a[i] >> 1) + (b[i] >> 1) + ((a[i] | b[i]) & 1)));
+		TEST_LANES("mulhi", cc0::wide::mulhi(x, y), test::mulhi(a[i], b[i], std::integral_constant<bool,(sizeof(serial_t) == 8)>()));
+	}
+	test::widening<wide_t>(std::integral_constant<bool,(wide_t::depth > 8 && wide_t::depth < 64 && wide_t::width > 1)>());
+}
+
+
+/// @brief Decodes the bits of a half-precision value from its fields, for comparison with the conversions under test.
+inline double decode_half(uint32_t h)
+{
+	const uint32_t e = (h >> 10) & 0x1f;
+	const uint32_t m = h & 0x3ff;
+	const double   v = e == 0x1f ? (m == 0 ? std::numeric_limits<double>::infinity() : std::numeric_limits<double>::quiet_NaN()) : (e == 0 ? std::ldexp(double(m), -24) : std::ldexp(double(m | 0x400), int(e) - 25));
+	return (h & 0x8000) ? -v : v;
+}
+
+
+/// @brief Returns true if the bits of a half-precision value are the correctly rounded (to nearest, ties to even) conversion of a finite single-precision value, i.e. no neighbouring value is closer, and a tie picks an even mantissa. Values of at least 65520 round to infinity.
+inline bool rounds_to_nearest_even(float f, uint32_t h)
+{
+	const double   a = std::fabs(double(f));
+	const uint32_t m = h & 0x7fff;
+	if ((h & 0x8000) != (std::signbit(f) ? 0x8000u : 0u)) {
+		return false;
+	}
+	if (a >= 65520.0) {
+		return m == 0x7c00;
+	}
+	if (m >= 0x7c00) {
+		return false;
+	}
+	// The value above the largest finite half-precision value is 65536, as if the exponent was not limited.
+	const double d  = std::fabs(a - test::decode_half(m));
+	const double lo = m > 0 ? std::fabs(a - test::decode_half(m - 1)) : d + 1.0;
+	const double hi = std::fabs(a - (m + 1 == 0x7c00 ? 65536.0 : test::decode_half(m + 1)));
+	return d <= lo && d <= hi && ((d != lo && d != hi) || m % 2 == 0);
+}
+
+
+/// @brief Checks the half-precision and bfloat16 conversions. All 65536 bit patterns of each must survive a round trip through single precision, where NaN is quieted but keeps its sign and payload. Single-precision values, including ties, subnormal results, overflow, and NaN, must round to nearest even, and agree with the serial float16 and bfloat16 classes.
+template < uint32_t W >
+void half_precision( void )
+{
+	typedef cc0::wide::wide_float<32,W> wide_t;
+	typedef cc0::wide::wide_float<16,W> half_t;
+	uint64_t seed = W + 53;
+	for (uint32_t iteration = 0; iteration < 65536 / W; ++iteration) {
+		uint16_t             h[W];
+		cc0::wide::float16   f16[W];
+		cc0::wide::bfloat16  b16[W];
+		float                o[W];
+		for (uint32_t i = 0; i < W; ++i) {
+			h[i]          = uint16_t(iteration * W + i);
+			f16[i].bits   = h[i];
+			b16[i].bits   = h[i];
+		}
+		bool ok = true;
+		cc0::wide::store(o, cc0::wide::widen(cc0::wide::load<half_t>(f16)));
+		for (uint32_t i = 0; i < W; ++i) {
+			const double r = test::decode_half(h[i]);
+			ok = ok && (test::is_nan(r) ? test::is_nan(o[i]) && std::signbit(o[i]) == std::signbit(r) : double(o[i]) == r && std::signbit(o[i]) == std::signbit(r));
+			ok = ok && test::same(o[i], float(f16[i]));
+		}
+		test::check(ok, "float16 widen", "float", 16, W, iteration);
+
+		cc0::wide::float16 n16[W];
+		cc0::wide::store_narrow(n16, cc0::wide::load_widen<wide_t>(f16));
+		ok = true;
+		for (uint32_t i = 0; i < W; ++i) {
+			const bool nan = (h[i] & 0x7c00) == 0x7c00 && (h[i] & 0x3ff) != 0;
+			ok = ok && n16[i].bits == (nan ? uint16_t(h[i] | 0x200) : h[i]);
+		}
+		test::check(ok, "float16 round trip", "float", 16, W, iteration);
+
+		cc0::wide::bfloat16 nb16[W];
+		cc0::wide::store(o, cc0::wide::load_widen<wide_t>(b16));
+		cc0::wide::store_narrow(nb16, cc0::wide::load<wide_t>(o));
+		ok = true;
+		for (uint32_t i = 0; i < W; ++i) {
+			const bool nan = (h[i] & 0x7f80) == 0x7f80 && (h[i] & 0x7f) != 0;
+			uint32_t   u;
+			std::memcpy(&u, &o[i], sizeof(u));
+			ok = ok && u == uint32_t(h[i]) << 16 && nb16[i].bits == (nan ? uint16_t(h[i] | 0x40) : h[i]);
+		}
+		test::check(ok, "bfloat16 round trip", "float", 16, W, iteration);
+	}
+
+	for (uint32_t iteration = 0; iteration < 10000; ++iteration) {
+		float    x[W];
+		uint32_t u[W];
+		for (uint32_t i = 0; i < W; ++i) {
+			const uint32_t k = test::random(seed) % 4;
+			if (k == 0) {
+				// Random bit patterns, which mostly overflow or underflow half precision.
+				u[i] = uint32_t(test::random(seed));
+				std::memcpy(&x[i], &u[i], sizeof(x[i]));
+			} else if (k == 1) {
+				// Ties halfway between two consecutive half-precision values, which are exact in single precision.
+				const uint32_t m = uint32_t(test::random(seed) % 0x7c00);
+				x[i] = float((test::decode_half(m) + (m + 1 == 0x7c00 ? 65536.0 : test::decode_half(m + 1))) / 2.0);
+			} else {
+				// Random values over the range of half precision, including subnormal results.
+				const double v = (1.0 + double(test::random(seed) % 1000000) / 1000000.0) * std::ldexp(1.0, int(test::random(seed) % 48) - 30);
+				x[i] = float(test::random(seed) % 2 ? -v : v);
+			}
+			std::memcpy(&u[i], &x[i], sizeof(u[i]));
+		}
+		cc0::wide::float16  n16[W];
+		cc0::wide::bfloat16 nb16[W];
+		const wide_t        v = cc0::wide::load<wide_t>(x);
+		cc0::wide::store_narrow(n16, v);
+		cc0::wide::store_narrow(nb16, v);
+		bool ok16 = true;
+		bool okb  = true;
+		for (uint32_t i = 0; i < W; ++i) {
+			const uint32_t lower = u[i] & 0xffff;
+			const uint16_t b     = test::is_nan(x[i]) ? uint16_t((u[i] >> 16) | 0x40) : uint16_t((u[i] >> 16) + ((lower > 0x8000 || (lower == 0x8000 && ((u[i] >> 16) & 1))) ? 1 : 0));
+			ok16 = ok16 && (test::is_nan(x[i]) ? (n16[i].bits & 0x7e00) == 0x7e00 : test::rounds_to_nearest_even(x[i], n16[i].bits)) && n16[i].bits == cc0::wide::float16(x[i]).bits;
+			okb  = okb && nb16[i].bits == b && nb16[i].bits == cc0::wide::bfloat16(x[i]).bits;
+		}
+		test::check(ok16, "float16 narrow", "float", 16, W, iteration);
+		test::check(okb,  "bfloat16 narrow", "float", 16, W, iteration);
+	}
+}
+
+
+/// @brief Computes 'a * b + c' in a single rounding for floating-point values.
+template < typename serial_t >
+serial_t fused_mul_add(serial_t a, serial_t b, serial_t c, std::false_type)
+{
+	return std::fma(a, b, c);
+}
+
+
+/// @brief Computes 'a * b + c' for integers, which are exact either way.
+template < typename serial_t >
+serial_t fused_mul_add(serial_t a, serial_t b, serial_t c, std::true_type)
+{
+	return serial_t(a * b + c);
+}
+
+
+/// @brief Checks expression templates against the plain operators. The node types must show that multiplications followed by an addition or subtraction are contracted, including with scalar operands, nested unary nodes, and a second product as the term. Each lane must match either the plain operators or the fused serial computation, and the plain operators exactly on operands where both are exact.
+template < typename wide_t >
+void expressions( void )
+{
+	typedef typename wide_t::serial_t serial_t;
+	typedef std::integral_constant<bool,std::numeric_limits<serial_t>::is_integer> integer_t;
+	typedef cc0::wide::expr::terminal<wide_t>                                       t;
+	typedef cc0::wide::expr::scalar<wide_t>                                         s;
+	typedef cc0::wide::expr::binary<cc0::wide::expr::__wide_expr_mul,t,t>          mul_t;
+	using cc0::wide::expr::lazy;
+	using cc0::wide::expr::ternary;
+	using cc0::wide::expr::__wide_expr_fma;
+	using cc0::wide::expr::__wide_expr_fms;
+	using cc0::wide::expr::__wide_expr_fnma;
+	const wide_t *p = nullptr;
+	static_assert(std::is_same<decltype(lazy(*p) * *p + *p), ternary<__wide_expr_fma,t,t,t>>::value, "a*b+c must contract to fma");
+	static_assert(std::is_same<decltype(*p + lazy(*p) * *p), ternary<__wide_expr_fma,t,t,t>>::value, "c+a*b must contract to fma");
+	static_assert(std::is_same<decltype(lazy(*p) * *p - *p), ternary<__wide_expr_fms,t,t,t>>::value, "a*b-c must contract to fms");
+	static_assert(std::is_same<decltype(*p - lazy(*p) * *p), ternary<__wide_expr_fnma,t,t,t>>::value, "c-a*b must contract to fnma");
+	static_assert(std::is_same<decltype(lazy(*p) * *p + lazy(*p) * *p), ternary<__wide_expr_fma,t,t,mul_t>>::value, "a*b+c*d must contract to fma");
+	static_assert(std::is_same<decltype(lazy(*p) * serial_t(2) + *p), ternary<__wide_expr_fma,t,s,t>>::value, "a*s+c must contract to fma");
+	static_assert(std::is_same<decltype(serial_t(2) - lazy(*p) * *p), ternary<__wide_expr_fnma,t,t,s>>::value, "s-a*b must contract to fnma");
+	const uint32_t W    = wide_t::width;
+	const serial_t k    = serial_t(3);
+	uint64_t       seed = W * wide_t::depth + 59;
+	for (uint32_t iteration = 0; iteration < 500; ++iteration) {
+		// Small integers keep every product and sum exact, so contraction can not change the result. Integer types always use these, which also avoids overflow.
+		const bool exact = integer_t::value || iteration % 2 == 0;
+		serial_t a[W], b[W], c[W], d[W];
+		for (uint32_t i = 0; i < W; ++i) {
+			a[i] = exact ? serial_t(int(test::random(seed) % 21) - 10) : test::value<serial_t>(seed);
+			b[i] = exact ? serial_t(int(test::random(seed) % 21) - 10) : test::value<serial_t>(seed);
+			c[i] = exact ? serial_t(int(test::random(seed) % 21) - 10) : test::value<serial_t>(seed);
+			d[i] = exact ? serial_t(int(test::random(seed) % 21) - 10) : test::value<serial_t>(seed);
+			if (b[i] == serial_t(0)) { b[i] = serial_t(1); }
+		}
+		const wide_t x = cc0::wide::load<wide_t>(a);
+		const wide_t y = cc0::wide::load<wide_t>(b);
+		const wide_t z = cc0::wide::load<wide_t>(c);
+		const wide_t w = cc0::wide::load<wide_t>(d);
+		#define TEST_EXPR(what, expression, plain, fused) \
+			do { \
+				serial_t o_[wide_t::width]; \
+				serial_t p_[wide_t::width]; \
+				cc0::wide::store(o_, wide_t(expression)); \
+				cc0::wide::store(p_, wide_t(plain)); \
+				bool ok_ = true; \
+				for (uint32_t i = 0; i < W; ++i) { ok_ = ok_ && (test::same(o_[i], p_[i]) || (!exact && test::same(o_[i], serial_t(fused)))); } \
+				test::check(ok_, what, test::name<serial_t>(), wide_t::depth, W, iteration); \
+			} while (false)
+		TEST_EXPR("expr a*b+c",       lazy(x) * y + z,             x * y + z,             test::fused_mul_add(a[i], b[i], c[i], integer_t()));
+		TEST_EXPR("expr c+a*b",       z + lazy(x) * y,             z + x * y,             test::fused_mul_add(a[i], b[i], c[i], integer_t()));
+		TEST_EXPR("expr a*b-c",       lazy(x) * y - z,             x * y - z,             test::fused_mul_add(a[i], b[i], serial_t(-c[i]), integer_t()));
+		TEST_EXPR("expr c-a*b",       z - lazy(x) * y,             z - x * y,             test::fused_mul_add(serial_t(-a[i]), b[i], c[i], integer_t()));
+		TEST_EXPR("expr a*b+c*d",     lazy(x) * y + lazy(z) * w,   x * y + z * w,         test::fused_mul_add(a[i], b[i], serial_t(c[i] * d[i]), integer_t()));
+		TEST_EXPR("expr a*b-c*d",     lazy(x) * y - lazy(z) * w,   x * y - z * w,         test::fused_mul_add(a[i], b[i], serial_t(-(c[i] * d[i])), integer_t()));
+		TEST_EXPR("expr a*k+c",       lazy(x) * k + z,             x * k + z,             test::fused_mul_add(a[i], k, c[i], integer_t()));
+		TEST_EXPR("expr k*a+c",       k * lazy(x) + z,             k * x + z,             test::fused_mul_add(k, a[i], c[i], integer_t()));
+		TEST_EXPR("expr a*b+k",       lazy(x) * y + k,             x * y + k,             test::fused_mul_add(a[i], b[i], k, integer_t()));
+		TEST_EXPR("expr k-a*b",       k - lazy(x) * y,             k - x * y,             test::fused_mul_add(serial_t(-a[i]), b[i], k, integer_t()));
+		TEST_EXPR("expr -a*b+c",      -lazy(x) * y + z,            -x * y + z,            test::fused_mul_add(serial_t(-a[i]), b[i], c[i], integer_t()));
+		TEST_EXPR("expr -(a*b)+c",    -(lazy(x) * y) + z,          -(x * y) + z,          test::fused_mul_add(serial_t(-a[i]), b[i], c[i], integer_t()));
+		TEST_EXPR("expr -(a+b)*c+d",  -(lazy(x) + y) * z + w,      -(x + y) * z + w,      test::fused_mul_add(serial_t(-(a[i] + b[i])), c[i], d[i], integer_t()));
+		TEST_EXPR("expr a/b+c",       lazy(x) / y + z,             x / y + z,             p_[i]);
+		#undef TEST_EXPR
+	}
+}
+
+
+/// @brief Checks the conditional macros against serial branches on each lane. The conditions are true for all, none, or some of the lanes, under a root mask that is either all true or random. Blocks no lane enters must not run, and lanes masked out by an enclosing block must keep their values.
+template < typename wide_t >
+void branches( void )
+{
+	typedef typename wide_t::serial_t                          serial_t;
+	typedef cc0::wide::wide_bool<wide_t::depth,wide_t::width> bool_t;
+	const uint32_t W    = wide_t::width;
+	const serial_t none = serial_t(99);
+	uint64_t       seed = W * wide_t::depth + 61;
+	for (uint32_t iteration = 0; iteration < 600; ++iteration) {
+		serial_t a[W], b[W];
+		bool     m[W];
+		for (uint32_t i = 0; i < W; ++i) {
+			a[i] = serial_t(test::random(seed) % 32);
+			switch (iteration % 3) {
+			case 0:  b[i] = serial_t(a[i] + 1 + test::random(seed) % 4); break;
+			case 1:  b[i] = a[i]; break;
+			default: b[i] = serial_t(test::random(seed) % 32); break;
+			}
+			m[i] = iteration / 3 % 2 == 0 || test::random(seed) % 2 == 0;
+		}
+		const wide_t x = cc0::wide::load<wide_t>(a);
+		const wide_t y = cc0::wide::load<wide_t>(b);
+		wide_t   r = wide_t(none), s = wide_t(none), u = wide_t(none), v = x, w = x;
+		uint32_t taken_if = 0, taken_else = 0, taken_uniform = 0, taken_while = 0, taken_dowhile = 0;
+		{
+			bool_t mask = bool_t(m);
+			CC0_WIDE_IF(x < y)
+				r = CC0_WIDE_SET(x);
+				++taken_if;
+				CC0_WIDE_IF(x < wide_t(serial_t(8)))
+					s = CC0_WIDE_SET(y);
+				CC0_WIDE_END_IF
+			CC0_WIDE_ELSE
+				r = CC0_WIDE_SET(y);
+				++taken_else;
+			CC0_WIDE_END_IF
+			CC0_WIDE_IF_UNIFORM(x < y)
+				u = CC0_WIDE_SET(y);
+				++taken_uniform;
+			CC0_WIDE_ELSE
+				u = CC0_WIDE_SET(x);
+			CC0_WIDE_END_IF
+			CC0_WIDE_WHILE(v < y)
+				v = CC0_WIDE_SET(v + wide_t(serial_t(1)));
+				++taken_while;
+			CC0_WIDE_END_WHILE
+			CC0_WIDE_DOWHILE
+				w = CC0_WIDE_SET(w + wide_t(serial_t(1)));
+				++taken_dowhile;
+			CC0_WIDE_END_DOWHILE(w < y)
+		}
+		serial_t sr[W], ss[W], su[W], sv[W], sw[W];
+		cc0::wide::store(sr, r);
+		cc0::wide::store(ss, s);
+		cc0::wide::store(su, u);
+		cc0::wide::store(sv, v);
+		cc0::wide::store(sw, w);
+		bool     ok_if = true, ok_uniform = true, ok_while = true, ok_dowhile = true, any_if = false, any_else = false;
+		uint32_t while_count = 0, dowhile_count = 0;
+		for (uint32_t i = 0; i < W; ++i) {
+			const bool     taken = m[i] && a[i] < b[i];
+			const uint32_t steps = a[i] < b[i] ? uint32_t(b[i] - a[i]) : 0;
+			any_if = any_if || taken;
+			any_else = any_else || (m[i] && !taken);
+			while_count = m[i] && steps > while_count ? steps : while_count;
+			dowhile_count = m[i] && (steps > 1 ? steps : 1) > dowhile_count ? (steps > 1 ? steps : 1) : dowhile_count;
+			ok_if = ok_if && sr[i] == (m[i] ? (taken ? a[i] : b[i]) : none) && ss[i] == (taken && a[i] < serial_t(8) ? b[i] : none);
+			ok_uniform = ok_uniform && su[i] == (m[i] ? (taken ? b[i] : a[i]) : none);
+			ok_while = ok_while && sv[i] == (m[i] && taken ? b[i] : a[i]);
+			ok_dowhile = ok_dowhile && sw[i] == (m[i] ? (taken ? b[i] : serial_t(a[i] + 1)) : a[i]);
+		}
+		test::check(ok_if && taken_if == uint32_t(any_if) && taken_else == uint32_t(any_else), "CC0_WIDE_IF", test::name<serial_t>(), wide_t::depth, W, iteration);
+		test::check(ok_uniform && taken_uniform == uint32_t(any_if), "CC0_WIDE_IF_UNIFORM", test::name<serial_t>(), wide_t::depth, W, iteration);
+		test::check(ok_while && taken_while == while_count, "CC0_WIDE_WHILE", test::name<serial_t>(), wide_t::depth, W, iteration);
+		test::check(ok_dowhile && taken_dowhile == dowhile_count, "CC0_WIDE_DOWHILE", test::name<serial_t>(), wide_t::depth, W, iteration);
+	}
+}
+
+
+/// @brief Checks wide_sort against std::sort on arrays of several sizes and patterns.
+template < typename wide_t >
+void sort( void )
+{
+	typedef typename wide_t::serial_t serial_t;
+	const uint32_t W       = wide_t::width;
+	const size_t   sizes[] = { 0, 1, 2, 3, W - 1, W, W + 1, CC0_WIDE_SORT_BLOCK * W, CC0_WIDE_SORT_BLOCK * W + 1, 100, 1000, 4099, 20000 };
+	for (size_t n : sizes) {
+		for (uint32_t pattern = 0; pattern < 5; ++pattern) {
+			const std::vector<serial_t> input  = test::generate<serial_t>(n, pattern, n * 5 + pattern);
+			std::vector<serial_t>       result = input;
+			cc0::wide::wide_sort<W>(result.data(), result.size());
+			test::check(test::sorted(result, input), "wide_sort", test::name<serial_t>(), wide_t::depth, W, n);
+		}
+	}
+}
+
+
+/// @brief Checks sort_lanes and merge against std::sort, and that the sorting networks keep all values, including NaN values.
+template < typename wide_t >
+void sort_lanes( void )
+{
+	typedef typename wide_t::serial_t serial_t;
+	const uint32_t W = wide_t::width;
+	for (uint32_t pattern = 0; pattern < 5; ++pattern) {
+		const std::vector<serial_t> input = test::generate<serial_t>(4 * W, pattern, pattern + 11);
+		wide_t x[4];
+		for (uint32_t i = 0; i < 4; ++i) { x[i] = cc0::wide::load<wide_t>(input.data() + i * W); }
+
+		std::vector<serial_t> one(W);
+		cc0::wide::store(one.data(), cc0::wide::sort_lanes(x[0]));
+		std::vector<serial_t> all(4 * W);
+		cc0::wide::sort_lanes(x);
+		for (uint32_t i = 0; i < 4; ++i) { cc0::wide::store(all.data() + i * W, x[i]); }
+		std::vector<serial_t> merged(2 * W);
+		cc0::wide::merge(x[0], x[3]);
+		cc0::wide::store(merged.data(), x[0]);
+		cc0::wide::store(merged.data() + W, x[3]);
+
+		const std::vector<serial_t> first(input.begin(), input.begin() + W);
+		std::vector<serial_t> ends(all.begin(), all.begin() + W);
+		ends.insert(ends.end(), all.end() - W, all.end());
+		if (pattern < 4) {
+			std::vector<serial_t> expected = input;
+			std::sort(expected.begin(), expected.end());
+			test::check(test::sorted(one, first), "sort_lanes", test::name<serial_t>(), wide_t::depth, W, W);
+			test::check(all == expected, "sort_lanes[4]", test::name<serial_t>(), wide_t::depth, W, 4 * W);
+			test::check(test::sorted(merged, ends), "merge", test::name<serial_t>(), wide_t::depth, W, 2 * W);
+		} else {
+			test::check(test::permutation(one, first), "sort_lanes keeps values", test::name<serial_t>(), wide_t::depth, W, W);
+			test::check(test::permutation(all, input), "sort_lanes[4] keeps values", test::name<serial_t>(), wide_t::depth, W, 4 * W);
+			test::check(test::permutation(merged, ends), "merge keeps values", test::name<serial_t>(), wide_t::depth, W, 2 * W);
+		}
+	}
+}
+
+
+/// @brief Checks compress, expand, compress_store, and expand_load against serial loops, for random masks.
+template < typename wide_t >
+void compress( void )
+{
+	typedef typename wide_t::serial_t                           serial_t;
+	typedef cc0::wide::wide_bool<wide_t::depth,wide_t::width>   mask_t;
+	typedef typename mask_t::serial_t                           bits_t;
+	const uint32_t W    = wide_t::width;
+	uint64_t       seed = W;
+	for (uint32_t iteration = 0; iteration < 1000; ++iteration) {
+		serial_t v[W];
+		bits_t   b[W];
+		for (uint32_t i = 0; i < W; ++i) {
+			v[i] = serial_t(test::random(seed) % 100 + 1);
+			b[i] = (iteration == 0 || test::random(seed) % 2 == 0) ? bits_t(0) : bits_t(~bits_t(0));
+		}
+		if (iteration == 1) {
+			for (uint32_t i = 0; i < W; ++i) { b[i] = bits_t(~bits_t(0)); }
+		}
+		const wide_t x = cc0::wide::load<wide_t>(v);
+		const mask_t m = cc0::wide::load<mask_t>(b);
+
+		serial_t compressed[W] = {};
+		serial_t expanded[W]   = {};
+		uint32_t n             = 0;
+		for (uint32_t i = 0; i < W; ++i) {
+			if (b[i] != 0) {
+				compressed[n] = v[i];
+				expanded[i]   = v[n];
+				++n;
+			}
+		}
+
+		serial_t o[W + 2];
+		cc0::wide::store(o, cc0::wide::compress(x, m));
+		test::check(std::memcmp(o, compressed, sizeof(compressed)) == 0, "compress", test::name<serial_t>(), wide_t::depth, W, n);
+		cc0::wide::store(o, cc0::wide::expand(x, m));
+		test::check(std::memcmp(o, expanded, sizeof(expanded)) == 0, "expand", test::name<serial_t>(), wide_t::depth, W, n);
+
+		// Elements past the stored ones must not be written.
+		for (uint32_t i = 0; i < W + 2; ++i) { o[i] = serial_t(0x55); }
+		const uint32_t stored  = cc0::wide::compress_store(o + 1, x, m);
+		bool           written = stored == n && o[0] == serial_t(0x55) && std::memcmp(o + 1, compressed, n * sizeof(serial_t)) == 0;
+		for (uint32_t i = n + 1; i < W + 2; ++i) { written = written && o[i] == serial_t(0x55); }
+		test::check(written, "compress_store", test::name<serial_t>(), wide_t::depth, W, n);
+
+		cc0::wide::store(o, cc0::wide::expand_load<wide_t>(v, m));
+		test::check(std::memcmp(o, expanded, sizeof(expanded)) == 0, "expand_load", test::name<serial_t>(), wide_t::depth, W, n);
+	}
+}
+
+
+/// @brief Checks the sine and cosine against the serial functions for inputs of all magnitudes, including those beyond the range reduction, infinities, and NaN.
+///
+/// @param tolerance the largest absolute error allowed.
+template < cc0::wide::precision Precision, typename wide_t >
+void trig(typename wide_t::serial_t tolerance)
+{
+	typedef typename wide_t::serial_t serial_t;
+	const uint32_t W    = wide_t::width;
+	uint64_t       seed = W;
+	for (double magnitude = 1.0; magnitude < 1.0e20; magnitude *= 10.0) {
+		for (uint32_t iteration = 0; iteration < 100; ++iteration) {
+			serial_t x[W];
+			for (uint32_t i = 0; i < W; ++i) {
+				x[i] = serial_t(magnitude * (double(test::random(seed) % 2000001) / 1000000.0 - 1.0));
+			}
+			if (iteration == 0) {
+				x[0] = std::numeric_limits<serial_t>::infinity();
+				x[1] = std::numeric_limits<serial_t>::quiet_NaN();
+			}
+			serial_t s[W];
+			serial_t c[W];
+			cc0::wide::store(s, cc0::wide::sin<Precision>(cc0::wide::load<wide_t>(x)));
+			cc0::wide::store(c, cc0::wide::cos<Precision>(cc0::wide::load<wide_t>(x)));
+			bool ok = true;
+			for (uint32_t i = 0; i < W; ++i) {
+				// The reference is computed in double rather than long double, since GCC 12 may leave the x87 registers in MMX state after vectorized code, which turns long double arithmetic into NaN.
+				const double rs = std::sin(double(x[i]));
+				const double rc = std::cos(double(x[i]));
+				ok = ok && (test::is_nan(rs) ? test::is_nan(s[i]) : std::fabs(s[i] - rs) <= tolerance);
+				ok = ok && (test::is_nan(rc) ? test::is_nan(c[i]) : std::fabs(c[i] - rc) <= tolerance);
+			}
+			test::check(ok, "sin/cos", test::name<serial_t>(), wide_t::depth, W, size_t(magnitude));
+		}
+	}
+}
+
+
+/// @brief Checks asin, acos, atan, and atan2 against the double precision std:: functions, within a relative error, over their domains and on the special cases of the C standard, i.e. signed zeros, infinities, NaN, and input outside of [-1, 1] for asin and acos.
+///
+/// @param tolerance the largest relative error allowed.
+template < cc0::wide::precision Precision, typename wide_t >
+void inverse_trig(double tolerance)
+{
+	typedef typename wide_t::serial_t     serial_t;
+	typedef std::numeric_limits<serial_t> limits;
+	const uint32_t W         = wide_t::width;
+	const serial_t special[] = { serial_t(0), serial_t(-0.0), serial_t(1), serial_t(-1), serial_t(1.5), serial_t(-1.5), limits::infinity(), -limits::infinity(), limits::quiet_NaN() };
+	const size_t   S         = sizeof(special) / sizeof(special[0]);
+	uint64_t       seed      = W * wide_t::depth + 23;
+	const auto     near      = [tolerance](serial_t o, double r) { return test::is_nan(r) ? test::is_nan(o) : (r == 0.0 ? test::same(o, serial_t(r)) : std::fabs(double(o) - r) <= tolerance * std::fabs(r)); };
+	for (uint32_t iteration = 0; iteration < 1000; ++iteration) {
+		serial_t x[W];
+		serial_t a[W];
+		serial_t y[W];
+		for (uint32_t i = 0; i < W; ++i) {
+			const double u = double(test::random(seed) % 2000001) / 1000000.0 - 1.0;
+			x[i] = serial_t(u);
+			a[i] = serial_t(u * std::pow(10.0, double(test::random(seed) % 9) - 3.0));
+			y[i] = serial_t((double(test::random(seed) % 2000001) / 1000000.0 - 1.0) * std::pow(10.0, double(test::random(seed) % 9) - 3.0));
+			if (iteration % 4 == 0) {
+				const size_t k = (iteration / 4 * W + i) % (S * S);
+				x[i] = special[k % S];
+				a[i] = special[k % S];
+				y[i] = special[k / S];
+			}
+		}
+		serial_t o[4][W];
+		cc0::wide::store(o[0], cc0::wide::asin<Precision>(cc0::wide::load<wide_t>(x)));
+		cc0::wide::store(o[1], cc0::wide::acos<Precision>(cc0::wide::load<wide_t>(x)));
+		cc0::wide::store(o[2], cc0::wide::atan<Precision>(cc0::wide::load<wide_t>(a)));
+		cc0::wide::store(o[3], cc0::wide::atan2<Precision>(cc0::wide::load<wide_t>(y), cc0::wide::load<wide_t>(a)));
+		bool ok[4] = { true, true, true, true };
+		for (uint32_t i = 0; i < W; ++i) {
+			ok[0] = ok[0] && near(o[0][i], std::asin(double(x[i])));
+			ok[1] = ok[1] && near(o[1][i], std::acos(double(x[i])));
+			ok[2] = ok[2] && near(o[2][i], std::atan(double(a[i])));
+			ok[3] = ok[3] && near(o[3][i], std::atan2(double(y[i]), double(a[i])));
+		}
+		test::check(ok[0], "asin",  test::name<serial_t>(), wide_t::depth, W, iteration);
+		test::check(ok[1], "acos",  test::name<serial_t>(), wide_t::depth, W, iteration);
+		test::check(ok[2], "atan",  test::name<serial_t>(), wide_t::depth, W, iteration);
+		test::check(ok[3], "atan2", test::name<serial_t>(), wide_t::depth, W, iteration);
+	}
+}
+
+
+/// @brief Checks pow against std::pow, within a relative error of a few units in the last place for random operands with results up to around 1e20, and exactly for the special cases of the C standard.
+template < typename wide_t >
+void pow( void )
+{
+	typedef typename wide_t::serial_t serial_t;
+	typedef std::numeric_limits<serial_t> limits;
+	const uint32_t W         = wide_t::width;
+	const double   tolerance = 4.0 * limits::epsilon();
+	const serial_t special[] = { serial_t(0), serial_t(-0.0), serial_t(1), serial_t(-1), serial_t(2), serial_t(-2), serial_t(0.5), serial_t(-3), limits::infinity(), -limits::infinity(), limits::quiet_NaN(), limits::denorm_min(), limits::max() };
+	const size_t   S         = sizeof(special) / sizeof(special[0]);
+	uint64_t       seed      = W;
+	for (uint32_t iteration = 0; iteration < 2000 + S * S / W + 1; ++iteration) {
+		serial_t a[W];
+		serial_t b[W];
+		for (uint32_t i = 0; i < W; ++i) {
+			const size_t k = (iteration - 2000) * W + i;
+			if (iteration < 2000) {
+				a[i] = serial_t(double(test::random(seed) % 1000001) / 100000.0);
+				b[i] = serial_t((double(test::random(seed) % 2000001) / 1000000.0 - 1.0) * 20.0);
+			} else {
+				a[i] = special[(k / S) % S];
+				b[i] = special[k % S];
+			}
+		}
+		serial_t o[W];
+		cc0::wide::store(o, cc0::wide::pow(cc0::wide::load<wide_t>(a), cc0::wide::load<wide_t>(b)));
+		bool ok = true;
+		for (uint32_t i = 0; i < W; ++i) {
+			const serial_t ref = std::pow(a[i], b[i]);
+			if (test::is_nan(ref) || std::fabs(ref) == limits::infinity() || ref == serial_t(0) || std::fabs(ref) < limits::min() || iteration >= 2000) {
+				ok = ok && (test::is_nan(ref) ? test::is_nan(o[i]) : (o[i] == ref || std::fabs(double(o[i]) - double(ref)) <= tolerance * std::fabs(double(ref)) + double(limits::denorm_min())));
+			} else {
+				ok = ok && std::fabs(double(o[i]) - double(ref)) <= tolerance * std::fabs(double(ref));
+			}
+		}
+		test::check(ok, "pow", test::name<serial_t>(), wide_t::depth, W, iteration);
+	}
+}
+
+
+/// @brief Checks that the math functions accept the depth and width as their only template arguments, as well as no template arguments, and then use the accurate precision.
+template < uint32_t Depth, uint32_t Width >
+void default_precision( void )
+{
+	typedef cc0::wide::wide_float<Depth,Width> wide_t;
+	typedef typename wide_t::serial_t          serial_t;
+	using cc0::wide::precision;
+	uint64_t seed = Width;
+	for (uint32_t iteration = 0; iteration < 10; ++iteration) {
+		serial_t a[Width];
+		serial_t b[Width];
+		for (uint32_t i = 0; i < Width; ++i) {
+			a[i] = serial_t(double(test::random(seed) % 2001) / 1000.0 - 1.0);
+			b[i] = serial_t(double(test::random(seed) % 2001) / 1000.0 + 0.5);
+		}
+		const wide_t x = cc0::wide::load<wide_t>(a);
+		const wide_t y = cc0::wide::load<wide_t>(b);
+		wide_t s1, c1, s2, c2, s3, c3;
+		cc0::wide::sincos<Depth,Width>(x, s1, c1);
+		cc0::wide::sincos(x, s2, c2);
+		cc0::wide::sincos<precision::accurate>(x, s3, c3);
+		const wide_t explicit_args[] = {
+			cc0::wide::sin<Depth,Width>(x), cc0::wide::cos<Depth,Width>(x), cc0::wide::tan<Depth,Width>(x),
+			cc0::wide::asin<Depth,Width>(x), cc0::wide::acos<Depth,Width>(x), cc0::wide::atan<Depth,Width>(x), cc0::wide::atan2<Depth,Width>(x, y),
+			cc0::wide::exp<Depth,Width>(x), cc0::wide::exp2<Depth,Width>(x), cc0::wide::log<Depth,Width>(y), cc0::wide::log2<Depth,Width>(y), cc0::wide::log10<Depth,Width>(y), cc0::wide::pow<Depth,Width>(y, x),
+			s1, c1
+		};
+		const wide_t deduced_args[] = {
+			cc0::wide::sin(x), cc0::wide::cos(x), cc0::wide::tan(x),
+			cc0::wide::asin(x), cc0::wide::acos(x), cc0::wide::atan(x), cc0::wide::atan2(x, y),
+			cc0::wide::exp(x), cc0::wide::exp2(x), cc0::wide::log(y), cc0::wide::log2(y), cc0::wide::log10(y), cc0::wide::pow(y, x),
+			s2, c2
+		};
+		const wide_t accurate[] = {
+			cc0::wide::sin<precision::accurate>(x), cc0::wide::cos<precision::accurate>(x), cc0::wide::tan<precision::accurate>(x),
+			cc0::wide::asin<precision::accurate>(x), cc0::wide::acos<precision::accurate>(x), cc0::wide::atan<precision::accurate>(x), cc0::wide::atan2<precision::accurate>(x, y),
+			cc0::wide::exp<precision::accurate>(x), cc0::wide::exp2<precision::accurate>(x), cc0::wide::log<precision::accurate>(y), cc0::wide::log2<precision::accurate>(y), cc0::wide::log10<precision::accurate>(y), cc0::wide::pow<precision::accurate>(y, x),
+			s3, c3
+		};
+		test::check(std::memcmp(explicit_args, accurate, sizeof(accurate)) == 0, "explicit depth and width", "float", Depth, Width, iteration);
+		test::check(std::memcmp(deduced_args, accurate, sizeof(accurate)) == 0, "deduced depth and width", "float", Depth, Width, iteration);
+	}
+}
+
+
+/// @brief Runs all checks on each of the given wide types.
+template < typename... wide_t >
+void all( void )
+{
+	const int expand[] = { 0, (test::operators<wide_t>(std::integral_constant<bool,std::numeric_limits<typename wide_t::serial_t>::is_integer>()), test::reductions<wide_t>(), test::memory<wide_t>(), test::gather<wide_t>(), test::lanes<wide_t>(), test::container<wide_t,CC0_WIDE_CACHE_LINE_SIZE>(), test::sort<wide_t>(), test::sort_lanes<wide_t>(), test::compress<wide_t>(), test::branches<wide_t>(), 0)... };
+	(void)expand;
+}
+
+
+/// @brief Runs the checks of the integer-only operations on each of the given wide integer types.
+template < typename... wide_t >
+void integers( void )
+{
+	const int expand[] = { 0, (test::bitwise_reductions<wide_t>(), test::divider<wide_t>(), test::bits<wide_t>(), test::saturate<wide_t>(), 0)... };
+	(void)expand;
+}
+
+
+/// @brief Runs the checks of the signed integer-only operations on each of the given wide integer types.
+template < typename... wide_t >
+void signed_integers( void )
+{
+	const int expand[] = { 0, (test::integer_math<wide_t>(), test::expressions<wide_t>(), 0)... };
+	(void)expand;
+}
+
+
+/// @brief Runs the checks of the floating-point-only operations on each of the given wide floating-point types.
+template < typename... wide_t >
+void floats( void )
+{
+	const int expand[] = { 0, (test::reciprocals<wide_t>(), test::fused<wide_t>(), test::square_root<wide_t>(), test::expressions<wide_t>(), 0)... };
+	(void)expand;
+}
+
+}
+
+
+int main( void )
+{
+	using namespace cc0::wide;
+
+	test::all<
+		wide_float<32,4>, wide_float<32,8>, wide_float<32,16>, wide_float<64,2>, wide_float<64,4>,
+		wide_int<8,16>, wide_int<16,8>, wide_int<16,16>, wide_int<32,4>, wide_int<32,8>, wide_int<64,4>,
+		wide_uint<8,16>, wide_uint<32,8>, wide_uint<64,2>
+	>();
+	test::integers<
+		wide_int<8,16>, wide_int<16,8>, wide_int<16,16>, wide_int<32,4>, wide_int<32,8>, wide_int<64,2>, wide_int<64,4>,
+		wide_uint<8,16>, wide_uint<8,32>, wide_uint<16,8>, wide_uint<32,4>, wide_uint<32,8>, wide_uint<64,2>, wide_uint<64,4>
+	>();
+	test::signed_integers<
+		wide_int<8,16>, wide_int<16,8>, wide_int<32,4>, wide_int<32,8>, wide_int<64,2>, wide_int<64,4>
+	>();
+	test::floats<
+		wide_float<32,4>, wide_float<32,8>, wide_float<32,16>, wide_float<64,2>, wide_float<64,4>
+	>();
+	test::half_precision<4>();
+	test::half_precision<8>();
+	test::half_precision<16>();
+	test::popcount_wide_mask<8,256>();
+	test::popcount_wide_mask<16,64>();
+	test::container<wide_float<32,8>,256>();
+
+	test::trig< precision::accurate, wide_float<32,4> >(4.0f * std::numeric_limits<float>::epsilon());
+	test::trig< precision::accurate, wide_float<32,8> >(4.0f * std::numeric_limits<float>::epsilon());
+	test::trig< precision::accurate, wide_float<64,2> >(4.0 * std::numeric_limits<double>::epsilon());
+	test::trig< precision::accurate, wide_float<64,4> >(4.0 * std::numeric_limits<double>::epsilon());
+	test::trig< precision::balanced, wide_float<32,8> >(1.0e-5f);
+	test::trig< precision::balanced, wide_float<64,4> >(1.0e-10);
+	test::inverse_trig< precision::accurate, wide_float<32,4> >(4.0 * std::numeric_limits<float>::epsilon());
+	test::inverse_trig< precision::accurate, wide_float<32,8> >(4.0 * std::numeric_limits<float>::epsilon());
+	test::inverse_trig< precision::accurate, wide_float<64,2> >(4.0 * std::numeric_limits<double>::epsilon());
+	test::inverse_trig< precision::accurate, wide_float<64,4> >(4.0 * std::numeric_limits<double>::epsilon());
+	test::inverse_trig< precision::balanced, wide_float<32,8> >(2.0e-5);
+	test::inverse_trig< precision::balanced, wide_float<64,4> >(1.0e-10);
+	test::inverse_trig< precision::fast, wide_float<32,8> >(1.0e-3);
+	test::inverse_trig< precision::fast, wide_float<64,4> >(1.0e-3);
+	test::pow< wide_float<32,4> >();
+	test::pow< wide_float<32,8> >();
+	test::pow< wide_float<64,2> >();
+	test::pow< wide_float<64,4> >();
+	test::default_precision<32,4>();
+	test::default_precision<64,4>();
+
+	if (test::failures > 0) {
+		std::printf("%s: %u checks failed\n", TEST_STRINGIFY(CC0_WIDE_ISA_NAMESPACE), unsigned(test::failures));
+		return 1;
+	}
+	std::printf("%s: all checks passed\n", TEST_STRINGIFY(CC0_WIDE_ISA_NAMESPACE));
+	return 0;
+}
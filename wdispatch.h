@@ -0,0 +1,263 @@
+/// @file wdispatch.h
+/// @brief Contains runtime detection of the instruction sets supported by the CPU, and selection between variants of a function compiled for different instruction sets.
+/// @author github.com/SirJonthe
+/// @date 2022, 2023
+/// @copyright Public domain.
+/// @license CC0 1.0
+
+#ifndef CC0_WDISPATCH_H_INCLUDED__
+#define CC0_WDISPATCH_H_INCLUDED__
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <utility>
+#include "wide.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	#include <intrin.h>
+	#define CC0_WIDE_CPUID_MSVC
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+	#include <cpuid.h>
+	#define CC0_WIDE_CPUID_GNU
+#endif
+
+// The functions below are shared by all translation units, whatever instruction set each is compiled for, so the linker keeps only one of their copies. Compiling them for the baseline instruction set makes that copy safe to run on any CPU.
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+	#define CC0_WIDE_BASELINE __attribute__((target("arch=x86-64")))
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__i386__)
+	#define CC0_WIDE_BASELINE __attribute__((target("arch=i686")))
+#else
+	#define CC0_WIDE_BASELINE
+#endif
+
+/// @brief The instruction set level the current translation unit is compiled for, as a 'cc0::wide::isa' value.
+///
+/// @sa CC0_WIDE_VARIANT
+#define CC0_WIDE_ISA cc0::wide::isa::CC0_WIDE_ISA_BASE
+
+/// @brief Appends the instruction set level the current translation unit is compiled for to a function name, e.g. 'kernel' becomes 'kernel_avx2'. Use this to give each variant of a function a unique name.
+///
+/// @sa CC0_WIDE_ISA
+#define CC0_WIDE_VARIANT(name) CC0_WIDE_CONCAT(name, _, CC0_WIDE_ISA_BASE, )
+
+namespace cc0
+{
+namespace wide
+{
+
+/// @brief The instruction set levels a function variant can be compiled for, from least to most capable.
+///
+/// @note 'avx2' corresponds to the x86-64-v3 level, which also includes FMA and F16C, so variants at this level may be compiled with '-mavx2 -mfma -mf16c'.
+enum class isa : uint32_t
+{
+	generic,
+	sse2,
+	sse4_1,
+	avx2
+};
+
+
+/// @brief The instruction set extensions supported by the CPU and the operating system.
+class cpu_features
+{
+public:
+	bool sse2;
+	bool sse4_1;
+	bool avx;
+	bool avx2;
+	bool fma;
+	bool f16c;
+	bool avx512f;
+};
+
+
+/// @brief Queries the CPU for supported instruction set extensions.
+CC0_WIDE_BASELINE inline void __wide_cpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4])
+{
+	regs[0] = regs[1] = regs[2] = regs[3] = 0;
+#if defined(CC0_WIDE_CPUID_MSVC)
+	int r[4];
+	__cpuidex(r, int(leaf), int(subleaf));
+	for (int i = 0; i < 4; ++i) { regs[i] = uint32_t(r[i]); }
+#elif defined(CC0_WIDE_CPUID_GNU)
+	unsigned int a, b, c, d;
+	if (__get_cpuid_count(leaf, subleaf, &a, &b, &c, &d)) {
+		regs[0] = a; regs[1] = b; regs[2] = c; regs[3] = d;
+	}
+#else
+	(void)leaf;
+	(void)subleaf;
+#endif
+}
+
+
+/// @brief Queries which register states the operating system saves on context switches. The wider registers can only be used if the operating system saves them.
+CC0_WIDE_BASELINE inline uint64_t __wide_xgetbv( void )
+{
+#if defined(CC0_WIDE_CPUID_MSVC)
+	return uint64_t(_xgetbv(0));
+#elif defined(CC0_WIDE_CPUID_GNU)
+	uint32_t lo, hi;
+	__asm__ __volatile__("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+	return (uint64_t(hi) << 32) | lo;
+#else
+	return 0;
+#endif
+}
+
+
+/// @brief Detects the instruction set extensions supported by the CPU and the operating system.
+CC0_WIDE_BASELINE inline cpu_features __wide_detect_cpu_features( void )
+{
+	cpu_features f;
+	uint32_t r1[4], r7[4];
+	__wide_cpuid(1, 0, r1);
+	__wide_cpuid(7, 0, r7);
+	const bool     osxsave = (r1[2] & (1u << 27)) != 0;
+	const uint64_t xcr0    = osxsave ? __wide_xgetbv() : 0;
+	const bool     ymm     = (xcr0 & 0x06) == 0x06;
+	const bool     zmm     = (xcr0 & 0xe6) == 0xe6;
+	f.sse2    = (r1[3] & (1u << 26)) != 0;
+	f.sse4_1  = (r1[2] & (1u << 19)) != 0;
+	f.avx     = (r1[2] & (1u << 28)) != 0 && ymm;
+	f.avx2    = (r7[1] & (1u << 5)) != 0 && f.avx;
+	f.fma     = (r1[2] & (1u << 12)) != 0 && f.avx;
+	f.f16c    = (r1[2] & (1u << 29)) != 0 && f.avx;
+	f.avx512f = (r7[1] & (1u << 16)) != 0 && zmm;
+	return f;
+}
+
+
+/// @brief Returns the instruction set extensions supported by the CPU and the operating system. The CPU is queried once, on the first call.
+///
+/// @returns the supported extensions.
+CC0_WIDE_BASELINE inline const cpu_features &cpu( void )
+{
+	static const cpu_features features = __wide_detect_cpu_features();
+	return features;
+}
+
+
+/// @brief Determines if the CPU can run code compiled for the given instruction set level.
+///
+/// @param level the instruction set level.
+///
+/// @returns true if supported.
+CC0_WIDE_BASELINE inline bool supports(isa level)
+{
+	const cpu_features &f = cc0::wide::cpu();
+	switch (level) {
+	case isa::generic: return true;
+	case isa::sse2:    return f.sse2;
+	case isa::sse4_1:  return f.sse2 && f.sse4_1;
+	case isa::avx2:    return f.sse2 && f.sse4_1 && f.avx2 && f.fma && f.f16c;
+	}
+	return false;
+}
+
+
+/// @brief Returns the name of an instruction set level, matching the names accepted by the CC0_WIDE_ISA environment variable.
+///
+/// @param level the instruction set level.
+///
+/// @returns the name.
+CC0_WIDE_BASELINE inline const char *isa_name(isa level)
+{
+	switch (level) {
+	case isa::generic: return "generic";
+	case isa::sse2:    return "sse2";
+	case isa::sse4_1:  return "sse4_1";
+	case isa::avx2:    return "avx2";
+	}
+	return "unknown";
+}
+
+
+/// @brief Returns the most capable instruction set level that variants may be selected for. This is normally 'avx2', but can be lowered by setting the CC0_WIDE_ISA environment variable to the name of a level, which is useful for testing the less capable variants on a capable machine. The environment is read once, on the first call.
+///
+/// @note The variable must match one of the names returned by 'isa_name' exactly. Any other value, including an empty one, is treated as if the variable was not set, and returns 'avx2'. Falling back to a lower level instead could leave a dispatcher without a supported variant.
+///
+/// @returns the maximum instruction set level.
+CC0_WIDE_BASELINE inline isa max_isa( void )
+{
+	struct env
+	{
+		CC0_WIDE_BASELINE static isa read( void )
+		{
+			const char *name = std::getenv("CC0_WIDE_ISA");
+			if (name != nullptr) {
+				for (uint32_t i = 0; i <= uint32_t(isa::avx2); ++i) {
+					if (std::strcmp(name, cc0::wide::isa_name(isa(i))) == 0) {
+						return isa(i);
+					}
+				}
+			}
+			// Unset or unknown, so nothing is capped.
+			return isa::avx2;
+		}
+	};
+	static const isa level = env::read();
+	return level;
+}
+
+template < typename signature_t >
+class dispatch;
+
+
+/// @brief Selects the most capable variant of a function that the CPU supports. Each variant is typically compiled in a separate translation unit with its own instruction set flags, and named via CC0_WIDE_VARIANT.
+///
+/// @note The variant is selected once, when the dispatcher is constructed. Variants above the level returned by 'max_isa' are ignored, so setting the CC0_WIDE_ISA environment variable forces less capable variants.
+/// @note A variant that all target CPUs support should always be provided, e.g. 'isa::sse2' on x86-64 or 'isa::generic' elsewhere. If none of the variants are supported, calling the dispatcher is undefined.
+/// @note The functions in this file, including the members of the dispatcher, are compiled for the baseline instruction set on GCC and Clang, so they are safe to call from any variant. Other compilers have no per-function target, so on those they should only be called, and dispatchers only constructed, in translation units compiled for the baseline instruction set.
+/// @note Code shared between the variants, such as a kernel template, must be declared inside 'inline namespace CC0_WIDE_ISA_NAMESPACE' unless wide types appear in its signature. Otherwise the linker may merge the instantiations of different translation units and run code compiled for the wrong instruction set.
+///
+/// @sa CC0_WIDE_VARIANT
+template < typename return_t, typename... args_t >
+class dispatch<return_t(args_t...)>
+{
+public:
+	typedef return_t (*function_t)(args_t...);
+
+	/// @brief A function compiled for a given instruction set level.
+	struct variant
+	{
+		isa        level;
+		function_t function;
+	};
+
+private:
+	function_t m_function;
+	isa        m_level;
+
+public:
+	/// @brief Selects the most capable supported variant out of the given variants.
+	///
+	/// @param variants the variants to select from, in any order.
+	CC0_WIDE_BASELINE dispatch(std::initializer_list<variant> variants) : m_function(nullptr), m_level(isa::generic)
+	{
+		for (const variant &v : variants) {
+			if (v.level <= cc0::wide::max_isa() && cc0::wide::supports(v.level) && (m_function == nullptr || v.level > m_level)) {
+				m_function = v.function;
+				m_level    = v.level;
+			}
+		}
+	}
+
+	/// @brief Calls the selected variant.
+	CC0_WIDE_BASELINE return_t operator()(args_t... args) const { return m_function(std::forward<args_t>(args)...); }
+
+	/// @brief Returns the selected variant, or null if none of the variants are supported.
+	CC0_WIDE_BASELINE function_t function( void ) const { return m_function; }
+
+	/// @brief Returns the instruction set level of the selected variant.
+	CC0_WIDE_BASELINE isa level( void ) const { return m_level; }
+};
+
+}
+}
+
+#undef CC0_WIDE_BASELINE
+
+#endif // CC0_WDISPATCH_H_INCLUDED__
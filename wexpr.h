@@ -0,0 +1,371 @@
+/// @file wexpr.h
+/// @brief Contains expression templates for wide data types, which evaluate a chain of arithmetic operations in a single pass instead of one pass per operator.
+/// @author github.com/SirJonthe
+/// @date 2022, 2023
+/// @copyright Public domain.
+/// @license CC0 1.0
+
+#ifndef CC0_WEXPR_H_INCLUDED__
+#define CC0_WEXPR_H_INCLUDED__
+
+#include <cstdint>
+#include <cmath>
+#include <type_traits>
+#include "wide.h"
+
+#define EXPROP(op, fn) \
+	template < typename l_t, typename r_t, typename pair_t = __wide_expr_pair<l_t,r_t> > \
+	inline binary<fn, typename pair_t::left_t, typename pair_t::right_t> operator op(const l_t &l, const r_t &r) \
+	{ \
+		return binary<fn, typename pair_t::left_t, typename pair_t::right_t>(pair_t::left(l), pair_t::right(r)); \
+	}
+
+#define EXPRFUSEDOP(op, mul_r, l_mul, mul_mul) \
+	template < typename a_t, typename b_t, typename r_t, typename pair_t = __wide_expr_pair<binary<__wide_expr_mul,a_t,b_t>,r_t> > \
+	inline ternary<mul_r, a_t, b_t, typename pair_t::right_t> operator op(const binary<__wide_expr_mul,a_t,b_t> &l, const r_t &r) \
+	{ \
+		return ternary<mul_r, a_t, b_t, typename pair_t::right_t>(l.left(), l.right(), pair_t::right(r)); \
+	} \
+	template < typename l_t, typename a_t, typename b_t, typename pair_t = __wide_expr_pair<l_t,binary<__wide_expr_mul,a_t,b_t>> > \
+	inline ternary<l_mul, a_t, b_t, typename pair_t::left_t> operator op(const l_t &l, const binary<__wide_expr_mul,a_t,b_t> &r) \
+	{ \
+		return ternary<l_mul, a_t, b_t, typename pair_t::left_t>(r.left(), r.right(), pair_t::left(l)); \
+	} \
+	template < typename a_t, typename b_t, typename c_t, typename d_t > \
+	inline ternary<mul_mul, a_t, b_t, binary<__wide_expr_mul,c_t,d_t>> operator op(const binary<__wide_expr_mul,a_t,b_t> &l, const binary<__wide_expr_mul,c_t,d_t> &r) \
+	{ \
+		static_assert(std::is_same<typename binary<__wide_expr_mul,a_t,b_t>::value_type, typename binary<__wide_expr_mul,c_t,d_t>::value_type>::value, "Operands must be of the same wide type"); \
+		return ternary<mul_mul, a_t, b_t, binary<__wide_expr_mul,c_t,d_t>>(l.left(), l.right(), r); \
+	}
+
+namespace cc0
+{
+namespace wide
+{
+inline namespace CC0_WIDE_ISA_NAMESPACE
+{
+namespace expr
+{
+
+/// @brief Computes 'a * b + c' for serial and wide values. Rounds only once where FMA is enabled at compile time.
+template < typename T >
+inline T __wide_expr_fmadd(const T &a, const T &b, const T &c)
+{
+	return a * b + c;
+}
+
+template < uint32_t Depth, uint32_t Width >
+inline wide_float<Depth,Width> __wide_expr_fmadd(const wide_float<Depth,Width> &a, const wide_float<Depth,Width> &b, const wide_float<Depth,Width> &c)
+{
+	return cc0::wide::fma(a, b, c);
+}
+
+
+/// @brief Computes 'a * b - c' for serial and wide values. Rounds only once where FMA is enabled at compile time.
+template < typename T >
+inline T __wide_expr_fmsub(const T &a, const T &b, const T &c)
+{
+	return a * b - c;
+}
+
+template < uint32_t Depth, uint32_t Width >
+inline wide_float<Depth,Width> __wide_expr_fmsub(const wide_float<Depth,Width> &a, const wide_float<Depth,Width> &b, const wide_float<Depth,Width> &c)
+{
+	return cc0::wide::fms(a, b, c);
+}
+
+
+/// @brief Computes 'c - a * b' for serial and wide values. Rounds only once where FMA is enabled at compile time.
+template < typename T >
+inline T __wide_expr_fnmadd(const T &a, const T &b, const T &c)
+{
+	return c - a * b;
+}
+
+template < uint32_t Depth, uint32_t Width >
+inline wide_float<Depth,Width> __wide_expr_fnmadd(const wide_float<Depth,Width> &a, const wide_float<Depth,Width> &b, const wide_float<Depth,Width> &c)
+{
+	return cc0::wide::fnma(a, b, c);
+}
+
+#if defined(CC0_WIDE_NATIVE_FMA)
+	// With FMA enabled, std::fma compiles to a single instruction, which the compiler is free to vectorize along with the rest of the lane loop.
+	inline float  __wide_expr_fmadd(float a, float b, float c)    { return std::fma(a, b, c); }
+	inline double __wide_expr_fmadd(double a, double b, double c) { return std::fma(a, b, c); }
+	inline float  __wide_expr_fmsub(float a, float b, float c)    { return std::fma(a, b, -c); }
+	inline double __wide_expr_fmsub(double a, double b, double c) { return std::fma(a, b, -c); }
+	inline float  __wide_expr_fnmadd(float a, float b, float c)   { return std::fma(-a, b, c); }
+	inline double __wide_expr_fnmadd(double a, double b, double c) { return std::fma(-a, b, c); }
+#endif
+
+// The operations of the expression nodes. Each applies to a lane as well as to a whole wide value.
+struct __wide_expr_add { template < typename T > static T apply(const T &a, const T &b) { return a + b; } };
+struct __wide_expr_sub { template < typename T > static T apply(const T &a, const T &b) { return a - b; } };
+struct __wide_expr_mul { template < typename T > static T apply(const T &a, const T &b) { return a * b; } };
+struct __wide_expr_div { template < typename T > static T apply(const T &a, const T &b) { return a / b; } };
+struct __wide_expr_neg { template < typename T > static T apply(const T &a) { return -a; } };
+struct __wide_expr_fma { template < typename T > static T apply(const T &a, const T &b, const T &c) { return __wide_expr_fmadd(a, b, c); } };
+struct __wide_expr_fms { template < typename T > static T apply(const T &a, const T &b, const T &c) { return __wide_expr_fmsub(a, b, c); } };
+struct __wide_expr_fnma { template < typename T > static T apply(const T &a, const T &b, const T &c) { return __wide_expr_fnmadd(a, b, c); } };
+
+template < typename... >
+struct __wide_expr_void { typedef void type; };
+
+
+/// @brief Common base of all expression nodes.
+class __wide_expr_base {};
+
+template < typename T >
+struct __wide_expr_is_node : std::is_base_of<__wide_expr_base, T> {};
+
+
+/// @brief Determines if a wide type stores a native register, in which case whole registers are operated on instead of individual lanes.
+template < typename wide_t >
+class __wide_expr_is_native
+{
+private:
+	template < typename T > static std::true_type  test(const typename T::native_t*);
+	template < typename T > static std::false_type test(...);
+
+public:
+	static constexpr bool value = decltype(test<wide_t>(nullptr))::value;
+};
+
+template < typename expr_t >
+typename expr_t::value_type eval(const expr_t &e);
+
+
+/// @brief Adds evaluation on conversion to the expression nodes.
+template < typename derived_t, typename wide_t >
+class node : public __wide_expr_base
+{
+public:
+	typedef wide_t                     value_type;
+	typedef typename wide_t::serial_t serial_t;
+
+public:
+	/// @brief Evaluates the expression.
+	operator wide_t( void ) const { return cc0::wide::expr::eval(static_cast<const derived_t&>(*this)); }
+};
+
+
+/// @brief A wide value used as an operand in an expression. Only refers to the value, so the value must outlive the expression.
+///
+/// @sa lazy
+template < typename wide_t >
+class terminal : public node<terminal<wide_t>, wide_t>
+{
+private:
+	const wide_t &m_value;
+
+public:
+	explicit terminal(const wide_t &value) : m_value(value) {}
+	typename wide_t::serial_t lane(uint32_t i) const { return cc0::wide::serialize(m_value)[i]; }
+	wide_t                    value( void ) const     { return m_value; }
+};
+
+
+/// @brief A serial value used as an operand in an expression, applying to all lanes.
+template < typename wide_t >
+class scalar : public node<scalar<wide_t>, wide_t>
+{
+private:
+	typename wide_t::serial_t m_value;
+
+public:
+	explicit scalar(typename wide_t::serial_t value) : m_value(value) {}
+	typename wide_t::serial_t lane(uint32_t) const { return m_value; }
+	wide_t                    value( void ) const   { return wide_t(m_value); }
+};
+
+
+/// @brief An operation on one operand.
+template < typename op_t, typename a_t >
+class unary : public node<unary<op_t,a_t>, typename a_t::value_type>
+{
+public:
+	typedef typename a_t::value_type  wide_t;
+	typedef typename wide_t::serial_t serial_t;
+
+private:
+	a_t m_a;
+
+public:
+	explicit unary(const a_t &a) : m_a(a) {}
+	serial_t lane(uint32_t i) const { return op_t::apply(m_a.lane(i)); }
+	wide_t   value( void ) const     { return op_t::apply(m_a.value()); }
+};
+
+
+/// @brief An operation on two operands.
+template < typename op_t, typename l_t, typename r_t >
+class binary : public node<binary<op_t,l_t,r_t>, typename l_t::value_type>
+{
+public:
+	typedef typename l_t::value_type  wide_t;
+	typedef typename wide_t::serial_t serial_t;
+
+private:
+	l_t m_l;
+	r_t m_r;
+
+public:
+	binary(const l_t &l, const r_t &r) : m_l(l), m_r(r) {}
+	serial_t   lane(uint32_t i) const { return op_t::apply(m_l.lane(i), m_r.lane(i)); }
+	wide_t     value( void ) const     { return op_t::apply(m_l.value(), m_r.value()); }
+	const l_t &left( void ) const     { return m_l; }
+	const r_t &right( void ) const    { return m_r; }
+};
+
+
+/// @brief An operation on three operands. Produced by contracting a multiplication and an addition or subtraction into a fused multiply-add.
+template < typename op_t, typename a_t, typename b_t, typename c_t >
+class ternary : public node<ternary<op_t,a_t,b_t,c_t>, typename a_t::value_type>
+{
+public:
+	typedef typename a_t::value_type  wide_t;
+	typedef typename wide_t::serial_t serial_t;
+
+private:
+	a_t m_a;
+	b_t m_b;
+	c_t m_c;
+
+public:
+	ternary(const a_t &a, const b_t &b, const c_t &c) : m_a(a), m_b(b), m_c(c) {}
+	serial_t lane(uint32_t i) const { return op_t::apply(m_a.lane(i), m_b.lane(i), m_c.lane(i)); }
+	wide_t   value( void ) const     { return op_t::apply(m_a.value(), m_b.value(), m_c.value()); }
+};
+
+
+/// @brief Turns an operand of an expression into a node. Expression nodes are kept as-is, wide values become terminals, and serial values become scalars. Other types have no 'type', which disables the operators for them.
+template < typename wide_t, typename T, typename = void >
+struct __wide_expr_operand {};
+
+template < typename wide_t, typename T >
+struct __wide_expr_operand<wide_t, T, typename std::enable_if<__wide_expr_is_node<T>::value && std::is_same<typename T::value_type, wide_t>::value>::type>
+{
+	typedef T type;
+	static const T &make(const T &x) { return x; }
+};
+
+template < typename wide_t >
+struct __wide_expr_operand<wide_t, wide_t, void>
+{
+	typedef terminal<wide_t> type;
+	static type make(const wide_t &x) { return type(x); }
+};
+
+template < typename wide_t, typename T >
+struct __wide_expr_operand<wide_t, T, typename std::enable_if<std::is_arithmetic<T>::value>::type>
+{
+	typedef scalar<wide_t> type;
+	static type make(T x) { return type(typename wide_t::serial_t(x)); }
+};
+
+
+/// @brief Finds the wide type of a pair of operands, where at least one of the operands must be an expression node.
+template < typename l_t, typename r_t, typename = void >
+struct __wide_expr_common {};
+
+template < typename l_t, typename r_t >
+struct __wide_expr_common<l_t, r_t, typename std::enable_if<__wide_expr_is_node<l_t>::value>::type> { typedef typename l_t::value_type type; };
+
+template < typename l_t, typename r_t >
+struct __wide_expr_common<l_t, r_t, typename std::enable_if<!__wide_expr_is_node<l_t>::value && __wide_expr_is_node<r_t>::value>::type> { typedef typename r_t::value_type type; };
+
+
+/// @brief Turns a pair of operands into nodes. Has no members unless both operands are valid, which keeps the operators from applying to other types.
+template < typename l_t, typename r_t, typename = void >
+struct __wide_expr_pair {};
+
+template < typename l_t, typename r_t >
+struct __wide_expr_pair<l_t, r_t, typename __wide_expr_void<typename __wide_expr_operand<typename __wide_expr_common<l_t,r_t>::type, l_t>::type, typename __wide_expr_operand<typename __wide_expr_common<l_t,r_t>::type, r_t>::type>::type>
+{
+	typedef typename __wide_expr_common<l_t,r_t>::type wide_t;
+	typedef typename __wide_expr_operand<wide_t,l_t>::type left_t;
+	typedef typename __wide_expr_operand<wide_t,r_t>::type right_t;
+	static left_t  left(const l_t &l)  { return __wide_expr_operand<wide_t,l_t>::make(l); }
+	static right_t right(const r_t &r) { return __wide_expr_operand<wide_t,r_t>::make(r); }
+};
+
+
+/// @brief Starts an expression from a wide value. Operators applied to the result build an expression instead of computing a wide value right away. The expression is evaluated when converted to the wide type, or via 'eval'.
+///
+/// @note An expression only refers to the wide values it uses, so it should be evaluated within the statement it is built in, and not be stored in an 'auto' variable for later.
+///
+/// @param x the wide value.
+///
+/// @returns the expression.
+///
+/// @sa eval
+template < typename wide_t >
+inline terminal<wide_t> lazy(const wide_t &x)
+{
+	return terminal<wide_t>(x);
+}
+
+
+/// @brief Evaluates an expression whose value type stores a native register, operating on whole registers.
+template < typename expr_t >
+inline typename expr_t::value_type __wide_expr_eval(const expr_t &e, std::true_type)
+{
+	return e.value();
+}
+
+
+/// @brief Evaluates an expression whose value type stores an array, computing all operations of each lane at once in a single loop.
+template < typename expr_t >
+inline typename expr_t::value_type __wide_expr_eval(const expr_t &e, std::false_type)
+{
+	typedef typename expr_t::value_type wide_t;
+	wide_t o;
+	typename wide_t::serial_t *out = cc0::wide::serialize(o);
+	for (uint32_t i = 0; i < wide_t::width; ++i) {
+		out[i] = e.lane(i);
+	}
+	return o;
+}
+
+
+/// @brief Evaluates an expression. Wide types that store an array are evaluated in a single loop over the lanes, while wide types that store a native register are evaluated one operation at a time, since their intermediate values are registers rather than temporaries in memory. In both cases, multiplications followed by an addition or subtraction are contracted into fused multiply-adds.
+///
+/// @note Contraction changes the rounding of the result where FMA is enabled at compile time, the same way calling 'fma' would.
+///
+/// @param e the expression.
+///
+/// @returns the wide value of the expression.
+///
+/// @sa lazy
+template < typename expr_t >
+inline typename expr_t::value_type eval(const expr_t &e)
+{
+	return cc0::wide::expr::__wide_expr_eval(e, std::integral_constant<bool, __wide_expr_is_native<typename expr_t::value_type>::value>());
+}
+
+
+/// @brief Negates an expression.
+template < typename a_t >
+inline typename std::enable_if<__wide_expr_is_node<a_t>::value, unary<__wide_expr_neg,a_t>>::type operator-(const a_t &a)
+{
+	return unary<__wide_expr_neg,a_t>(a);
+}
+
+EXPROP(+, __wide_expr_add)
+EXPROP(-, __wide_expr_sub)
+EXPROP(*, __wide_expr_mul)
+EXPROP(/, __wide_expr_div)
+
+// Since these are more specialized than the operators above, multiplications followed by an addition or subtraction select these instead, building a fused node.
+EXPRFUSEDOP(+, __wide_expr_fma, __wide_expr_fma,  __wide_expr_fma)
+EXPRFUSEDOP(-, __wide_expr_fms, __wide_expr_fnma, __wide_expr_fms)
+
+}
+}
+}
+}
+
+#undef EXPROP
+#undef EXPRFUSEDOP
+
+#endif // CC0_WEXPR_H_INCLUDED__
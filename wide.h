@@ -11,8 +11,65 @@
 #include <cstdint>
 #include <limits>
 #include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#if defined(CC0_WIDE_PROFILE)
+	#include <algorithm>
+	#include <cstdio>
+	#include <mutex>
+	#include <vector>
+#endif
+
+// Native backends. Define CC0_WIDE_NO_NATIVE through the build stage to force the generic implementation.
+#if !defined(CC0_WIDE_NO_NATIVE) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+	#include <immintrin.h>
+	#define CC0_WIDE_NATIVE_SSE2
+	#if defined(__SSE4_1__) || defined(__AVX__)
+		#define CC0_WIDE_NATIVE_SSE4_1
+	#endif
+	#if defined(__AVX2__)
+		#define CC0_WIDE_NATIVE_AVX2
+	#endif
+	#if defined(__FMA__)
+		#define CC0_WIDE_NATIVE_FMA
+	#endif
+	#if defined(__F16C__)
+		#define CC0_WIDE_NATIVE_F16C
+	#endif
+#endif
+
+// Everything is declared inside an inline namespace named after the instruction sets enabled at compile time. Translation units compiled for different instruction sets see different definitions of the native types, and the namespace keeps these apart so that such translation units can be linked into the same program (see wdispatch.h).
+#if defined(CC0_WIDE_NATIVE_AVX2)
+	#define CC0_WIDE_ISA_BASE avx2
+#elif defined(CC0_WIDE_NATIVE_SSE4_1)
+	#define CC0_WIDE_ISA_BASE sse4_1
+#elif defined(CC0_WIDE_NATIVE_SSE2)
+	#define CC0_WIDE_ISA_BASE sse2
+#else
+	#define CC0_WIDE_ISA_BASE generic
+#endif
+#if defined(CC0_WIDE_NATIVE_FMA)
+	#define CC0_WIDE_ISA_FMA _fma
+#else
+	#define CC0_WIDE_ISA_FMA
+#endif
+#if defined(CC0_WIDE_NATIVE_F16C)
+	#define CC0_WIDE_ISA_F16C _f16c
+#else
+	#define CC0_WIDE_ISA_F16C
+#endif
+#define CC0_WIDE_CONCAT_(a, b, c, d) a##b##c##d
+#define CC0_WIDE_CONCAT(a, b, c, d) CC0_WIDE_CONCAT_(a, b, c, d)
+#define CC0_WIDE_ISA_NAMESPACE CC0_WIDE_CONCAT(isa_, CC0_WIDE_ISA_BASE, CC0_WIDE_ISA_FMA, CC0_WIDE_ISA_F16C)
 
 #define FOR(x) for (uint32_t i = 0; i < Width; ++i) { x; }
+#if defined(__GNUC__) || defined(__clang__)
+	#define EXPECT(x, v) __builtin_expect(bool(x), v)
+#else
+	#define EXPECT(x, v) (x)
+#endif
 #define CMP(sign)  wide_bool<Depth,Width> o; for (uint32_t i = 0; i < Width; ++i) { o.v[i] = v[i] sign r.v[i] ? wide_bool<Depth,Width>::TRUE_BITS : wide_bool<Depth,Width>::FALSE_BITS; } return o
 #define CMP1(sign) wide_bool<Depth,Width> o; for (uint32_t i = 0; i < Width; ++i) { o.v[i] = v[i] sign r      ? wide_bool<Depth,Width>::TRUE_BITS : wide_bool<Depth,Width>::FALSE_BITS; } return o
 
@@ -31,8 +88,8 @@
 	explicit type(const wide_bool<Depth,Width> &r) { FOR(v[i] = r.v[i] ? serial_t(1) : serial_t(0)) } \
 	type &operator=(const type&) = default; \
 	type &operator=(serial_t r) { FOR(v[i] = r) return *this; } \
-	type &operator=(const cset<type> &test) { *this = cmov(test.mask, test.value, *this); return *this; } \
-	type &operator=(const cset<const type> &test) { *this = cmov(test.mask, test.value, *this); return *this; }
+	type &operator=(const cset<type> &test) { if (test.uniform) { *this = test.value; } else { *this = cmov(test.mask, test.value, *this); } return *this; } \
+	type &operator=(const cset<const type> &test) { if (test.uniform) { *this = test.value; } else { *this = cmov(test.mask, test.value, *this); } return *this; }
 
 #define ASSOP(type, op) \
 	type &operator op(const type &r) { FOR(v[i] op r.v[i]) return *this; } \
@@ -98,10 +155,10 @@
 #define CMPOPOPS(type) \
 	template < uint32_t Depth, uint32_t Width > wide_bool<Depth,Width> operator ==(const typename type<Depth,Width>::serial_t &l, const type<Depth,Width> &r) { return r == l; } \
 	template < uint32_t Depth, uint32_t Width > wide_bool<Depth,Width> operator !=(const typename type<Depth,Width>::serial_t &l, const type<Depth,Width> &r) { return r != l; } \
-	template < uint32_t Depth, uint32_t Width > wide_bool<Depth,Width> operator < (const typename type<Depth,Width>::serial_t &l, const type<Depth,Width> &r) { return r >= l; } \
-	template < uint32_t Depth, uint32_t Width > wide_bool<Depth,Width> operator > (const typename type<Depth,Width>::serial_t &l, const type<Depth,Width> &r) { return r <= l; } \
-	template < uint32_t Depth, uint32_t Width > wide_bool<Depth,Width> operator <=(const typename type<Depth,Width>::serial_t &l, const type<Depth,Width> &r) { return r >  l; } \
-	template < uint32_t Depth, uint32_t Width > wide_bool<Depth,Width> operator >=(const typename type<Depth,Width>::serial_t &l, const type<Depth,Width> &r) { return r <  l; }
+	template < uint32_t Depth, uint32_t Width > wide_bool<Depth,Width> operator < (const typename type<Depth,Width>::serial_t &l, const type<Depth,Width> &r) { return r >  l; } \
+	template < uint32_t Depth, uint32_t Width > wide_bool<Depth,Width> operator > (const typename type<Depth,Width>::serial_t &l, const type<Depth,Width> &r) { return r <  l; } \
+	template < uint32_t Depth, uint32_t Width > wide_bool<Depth,Width> operator <=(const typename type<Depth,Width>::serial_t &l, const type<Depth,Width> &r) { return r >= l; } \
+	template < uint32_t Depth, uint32_t Width > wide_bool<Depth,Width> operator >=(const typename type<Depth,Width>::serial_t &l, const type<Depth,Width> &r) { return r <= l; }
 
 
 /// @brief Establishes a conditional block where the code inside the block is only executed when a lane inside the wide condition is true.
@@ -109,16 +166,39 @@
 /// @note Remember to set up a boolean variable named 'mask' at the root of the function, either as an input parameter or as a local define (all values usually set to all-true).
 /// @note Use CC0_WIDE_SET to set the value of variables not defined within the current scope.
 ///
+/// @note The block is skipped when no lane is true. When all lanes are true, CC0_WIDE_SET inside the block assigns values directly instead of blending them with the previous values.
+///
 /// @param condition the condition where evaluation to true executes the contents of the block.
 ///
+/// @sa CC0_WIDE_IF_UNIFORM
 /// @sa CC0_WIDE_ELSE
 /// @sa CC0_WIDE_END_IF
 /// @sa CC0_WIDE_SET
 #define CC0_WIDE_IF(condition) \
 	{ \
 		const auto &mask0 = mask; \
-		auto mask = (condition) & mask0; \
-		if (bool(mask)) {
+		auto mask = cc0::wide::__wide_branch<false>((condition) & mask0); \
+		CC0_WIDE_PROFILE_SITE_("if") \
+		CC0_WIDE_PROFILE_BLOCK_(mask) \
+		if (mask.active()) {
+
+
+/// @brief Same as CC0_WIDE_IF, but hints to the compiler that the lanes usually agree on the condition, i.e. that the condition is usually true or false for all lanes at once. The code is then laid out for CC0_WIDE_SET to assign values directly.
+///
+/// @note Use for conditions that are coherent across neighbouring data, such as early-outs and rarely taken error paths.
+///
+/// @param condition the condition where evaluation to true executes the contents of the block.
+///
+/// @sa CC0_WIDE_IF
+/// @sa CC0_WIDE_ELSE
+/// @sa CC0_WIDE_END_IF
+#define CC0_WIDE_IF_UNIFORM(condition) \
+	{ \
+		const auto &mask0 = mask; \
+		auto mask = cc0::wide::__wide_branch<true>((condition) & mask0); \
+		CC0_WIDE_PROFILE_SITE_("if") \
+		CC0_WIDE_PROFILE_BLOCK_(mask) \
+		if (mask.active()) {
 
 
 /// @brief Helps setting up a conditional statement where the condition itself is a wide boolean type.
@@ -131,8 +211,9 @@
 /// @sa CC0_WIDE_SET
 #define CC0_WIDE_ELSE \
 		} \
-		mask = !mask & mask0; \
-		if (bool(mask)) {
+		mask = cc0::wide::__wide_branch_else(mask, mask0); \
+		CC0_WIDE_PROFILE_ITERATION_(mask) \
+		if (mask.active()) {
 
 
 /// @brief Concludes a wide conditional statement.
@@ -156,9 +237,12 @@
 #define CC0_WIDE_WHILE(condition) \
 	{ \
 		const auto &mask0 = mask; \
+		CC0_WIDE_PROFILE_SITE_("while") \
+		CC0_WIDE_PROFILE_ENTER_ \
 		do { \
-			auto mask = (condition) & mask0; \
-			if (bool(mask)) {
+			auto mask = cc0::wide::__wide_branch<false>((condition) & mask0); \
+			CC0_WIDE_PROFILE_ITERATION_(mask) \
+			if (mask.active()) {
 
 
 /// @brief Concludes a wide conditional while statement.
@@ -182,9 +266,12 @@
 #define CC0_WIDE_DOWHILE \
 	{ \
 		const auto &mask0 = mask; \
-		auto mask = mask0; \
+		auto mask = cc0::wide::__wide_branch<false>(mask0); \
+		CC0_WIDE_PROFILE_SITE_("do-while") \
+		CC0_WIDE_PROFILE_ENTER_ \
 		do { \
-			if (bool(mask)) {
+			CC0_WIDE_PROFILE_ITERATION_(mask) \
+			if (mask.active()) {
 
 
 /// @brief Concludes a conditional block where the code inside the block is only executed when a lane inside the wide condition is true. Repeats the condition until all lanes evaluate to false, although masks out calculations in lanes evaluating to false as long as CC0_WIDE_SET is used.
@@ -196,7 +283,7 @@
 			} else { \
 				break; \
 			} \
-			mask = (condition) & mask0; \
+			mask = cc0::wide::__wide_branch<false>((condition) & mask0); \
 		} while (true); \
 	}
 
@@ -210,25 +297,319 @@
 /// @sa CC0_WIDE_ELSE
 /// @sa CC0_WIDE_WHILE
 /// @sa CC0_WIDE_DOWHILE
-#define CC0_WIDE_SET(l) cc0::wide::cset<decltype(l)>{ mask, l }
+#define CC0_WIDE_SET(l) cc0::wide::cset<typename std::decay<decltype(l)>::type>{ mask, l, cc0::wide::__wide_uniform(mask) }
+
+// Hooks of the lane-utilization profiler into the conditional macros. Define CC0_WIDE_PROFILE through the build stage to enable the profiler.
+#if defined(CC0_WIDE_PROFILE)
+	#define CC0_WIDE_PROFILE_SITE_(kind)     static const cc0::wide::__wide_profile_site __wide_site(__FILE__, __LINE__, kind);
+	#define CC0_WIDE_PROFILE_ENTER_          cc0::wide::__wide_profile_enter(__wide_site);
+	#define CC0_WIDE_PROFILE_ITERATION_(m)   cc0::wide::__wide_profile_iteration(__wide_site, m);
+	#define CC0_WIDE_PROFILE_BLOCK_(m)       CC0_WIDE_PROFILE_ENTER_ CC0_WIDE_PROFILE_ITERATION_(m)
+#else
+	#define CC0_WIDE_PROFILE_SITE_(kind)
+	#define CC0_WIDE_PROFILE_ENTER_
+	#define CC0_WIDE_PROFILE_ITERATION_(m)
+	#define CC0_WIDE_PROFILE_BLOCK_(m)
+#endif
+
+#if defined(CC0_WIDE_PROFILE)
+
+// The profiler does not depend on the instruction set, so it is kept outside of the instruction set namespace. This way, variants compiled for different instruction sets share the same counters.
+namespace cc0
+{
+namespace wide
+{
+
+/// @brief The counters of a conditional block or loop in the lane-utilization profiler.
+///
+/// @sa profile
+class profile_record
+{
+public:
+	const char *file;         // The file of the site.
+	uint32_t    line;         // The line of the site.
+	const char *kind;         // "if", "while", or "do-while".
+	uint64_t    executions;   // The number of times the site was reached.
+	uint64_t    iterations;   // The number of times a block of the site ran, counting 'if' and 'else' blocks separately, or the number of loop iterations.
+	uint64_t    active_lanes; // The number of lanes that were true in the blocks that ran, summed over all iterations.
+	uint64_t    total_lanes;  // The number of lanes of the blocks that ran, summed over all iterations.
+
+public:
+	/// @brief Returns the average fraction of lanes doing useful work in the blocks that ran.
+	double utilization( void ) const { return total_lanes > 0 ? double(active_lanes) / double(total_lanes) : 1.0; }
+
+	/// @brief Returns the number of lanes that ran the blocks without doing useful work.
+	uint64_t wasted_lanes( void ) const { return total_lanes - active_lanes; }
+};
+
+
+/// @brief A conditional block or loop instrumented by the profiler. Each use of a conditional macro declares one as a static variable, which assigns it an index into the counters.
+class __wide_profile_site
+{
+public:
+	const char *file;
+	uint32_t    line;
+	const char *kind;
+	uint32_t    index;
+
+public:
+	__wide_profile_site(const char *f, uint32_t l, const char *k);
+};
+
+
+/// @brief The counters of a site, without the location of the site.
+class __wide_profile_counters
+{
+public:
+	uint64_t executions;
+	uint64_t iterations;
+	uint64_t active_lanes;
+	uint64_t total_lanes;
+};
+
+
+/// @brief Returns the sites instrumented so far, in the order they were first reached.
+inline std::vector<const __wide_profile_site*> &__wide_profile_sites( void )
+{
+	static std::vector<const __wide_profile_site*> sites;
+	return sites;
+}
+
+
+/// @brief Guards the list of sites, which all threads share.
+inline std::mutex &__wide_profile_mutex( void )
+{
+	static std::mutex mutex;
+	return mutex;
+}
+
+
+/// @brief Returns the counters of the calling thread, indexed by site.
+inline std::vector<__wide_profile_counters> &__wide_profile_thread_counters( void )
+{
+	thread_local std::vector<__wide_profile_counters> counters;
+	return counters;
+}
+
+
+inline __wide_profile_site::__wide_profile_site(const char *f, uint32_t l, const char *k) : file(f), line(l), kind(k)
+{
+	std::lock_guard<std::mutex> lock(__wide_profile_mutex());
+	index = uint32_t(__wide_profile_sites().size());
+	__wide_profile_sites().push_back(this);
+}
+
+
+/// @brief Returns the counters of a site for the calling thread.
+inline __wide_profile_counters &__wide_profile_counters_of(const __wide_profile_site &site)
+{
+	std::vector<__wide_profile_counters> &counters = __wide_profile_thread_counters();
+	if (site.index >= counters.size()) {
+		counters.resize(site.index + 1, __wide_profile_counters{ 0, 0, 0, 0 });
+	}
+	return counters[site.index];
+}
+
+
+/// @brief Records that a site was reached.
+inline void __wide_profile_enter(const __wide_profile_site &site)
+{
+	++__wide_profile_counters_of(site).executions;
+}
+
+
+/// @brief Records that a block of a site ran with a given number of active lanes.
+inline void __wide_profile_block(const __wide_profile_site &site, uint32_t active, uint32_t width)
+{
+	__wide_profile_counters &c = __wide_profile_counters_of(site);
+	++c.iterations;
+	c.active_lanes += active;
+	c.total_lanes  += width;
+}
+
+
+/// @brief Returns the counters of all sites the calling thread has reached, ranked by the number of wasted lanes, so that the sites losing the most work to divergence come first.
+///
+/// @note Only available when CC0_WIDE_PROFILE is defined.
+///
+/// @returns the counters.
+///
+/// @sa profile_report
+/// @sa profile_reset
+inline std::vector<profile_record> profile( void )
+{
+	std::vector<profile_record> records;
+	const std::vector<__wide_profile_counters> &counters = __wide_profile_thread_counters();
+	{
+		std::lock_guard<std::mutex> lock(__wide_profile_mutex());
+		const std::vector<const __wide_profile_site*> &sites = __wide_profile_sites();
+		for (size_t i = 0; i < counters.size() && i < sites.size(); ++i) {
+			const __wide_profile_counters &c = counters[i];
+			if (c.executions > 0) {
+				records.push_back(profile_record{ sites[i]->file, sites[i]->line, sites[i]->kind, c.executions, c.iterations, c.active_lanes, c.total_lanes });
+			}
+		}
+	}
+	std::stable_sort(records.begin(), records.end(), [](const profile_record &a, const profile_record &b) { return a.wasted_lanes() > b.wasted_lanes(); });
+	return records;
+}
+
+
+/// @brief Writes a report of the counters of all sites the calling thread has reached, ranked by the number of wasted lanes.
+///
+/// @note Only available when CC0_WIDE_PROFILE is defined.
+///
+/// @param out the file to write to.
+///
+/// @sa profile
+inline void profile_report(FILE *out = stdout)
+{
+	const std::vector<profile_record> records = cc0::wide::profile();
+	std::fprintf(out, "%4s  %-40s %-8s %12s %12s %10s %11s %14s\n", "rank", "site", "kind", "executions", "iterations", "iter/exec", "utilization", "wasted lanes");
+	for (size_t i = 0; i < records.size(); ++i) {
+		const profile_record &r = records[i];
+		char site[64];
+		const char *file = std::strrchr(r.file, '/');
+		std::snprintf(site, sizeof(site), "%s:%u", file != nullptr ? file + 1 : r.file, unsigned(r.line));
+		std::fprintf(out, "%4u  %-40s %-8s %12llu %12llu %10.2f %10.1f%% %14llu\n", unsigned(i + 1), site, r.kind, (unsigned long long)r.executions, (unsigned long long)r.iterations, double(r.iterations) / double(r.executions), r.utilization() * 100.0, (unsigned long long)r.wasted_lanes());
+	}
+}
+
+
+/// @brief Clears the counters of the calling thread.
+///
+/// @note Only available when CC0_WIDE_PROFILE is defined.
+inline void profile_reset( void )
+{
+	__wide_profile_thread_counters().clear();
+}
+
+}
+}
+
+#endif
 
 namespace cc0
 {
 namespace wide
 {
+inline namespace CC0_WIDE_ISA_NAMESPACE
+{
+
+/// @brief Converts the bits of a half-precision floating-point value to single precision.
+inline float __wide_half_to_float(uint16_t h)
+{
+	// Shifts exponent and mantissa into place and rebiases the exponent. Infinity and NaN need a larger exponent, while subnormal values are normalized via a floating-point subtraction.
+	uint32_t bits = uint32_t(h & 0x7fffu) << 13;
+	const uint32_t exponent = bits & 0x0f800000u;
+	bits += 112u << 23;
+	float f;
+	if (exponent == 0x0f800000u) {
+		bits += 112u << 23;
+		std::memcpy(&f, &bits, sizeof(f));
+	} else if (exponent == 0) {
+		bits += 1u << 23;
+		std::memcpy(&f, &bits, sizeof(f));
+		f -= 6.103515625e-05f; // 2^-14
+	} else {
+		std::memcpy(&f, &bits, sizeof(f));
+	}
+	return (h & 0x8000u) ? -f : f;
+}
+
+
+/// @brief Converts a single-precision floating-point value to the bits of a half-precision value, rounding to nearest even.
+inline uint16_t __wide_float_to_half(float f)
+{
+	uint32_t bits;
+	std::memcpy(&bits, &f, sizeof(bits));
+	const uint32_t sign = bits & 0x80000000u;
+	bits ^= sign;
+	uint32_t o;
+	if (bits >= 0x47800000u) {
+		// Too large for half precision. NaN is kept quiet along with as much of its payload as fits.
+		o = bits > 0x7f800000u ? 0x7e00u | ((bits >> 13) & 0x3ffu) : 0x7c00u;
+	} else if (bits < 0x38800000u) {
+		// Subnormal in half precision. Adding 0.5 aligns the value so that the floating-point adder rounds the mantissa into the lowest bits.
+		std::memcpy(&f, &bits, sizeof(f));
+		f += 0.5f;
+		std::memcpy(&o, &f, sizeof(o));
+		o -= 0x3f000000u;
+	} else {
+		o = (bits + 0xc8000fffu + ((bits >> 13) & 1u)) >> 13;
+	}
+	return uint16_t(o | (sign >> 16));
+}
+
+
+/// @brief Converts the bits of a bfloat16 value to single precision.
+inline float __wide_bfloat16_to_float(uint16_t h)
+{
+	const uint32_t bits = uint32_t(h) << 16;
+	float f;
+	std::memcpy(&f, &bits, sizeof(f));
+	return f;
+}
+
+
+/// @brief Converts a single-precision floating-point value to the bits of a bfloat16 value, rounding to nearest even.
+inline uint16_t __wide_float_to_bfloat16(float f)
+{
+	uint32_t bits;
+	std::memcpy(&bits, &f, sizeof(bits));
+	if ((bits & 0x7fffffffu) > 0x7f800000u) {
+		return uint16_t((bits >> 16) | 0x40u);
+	}
+	return uint16_t((bits + 0x7fffu + ((bits >> 16) & 1u)) >> 16);
+}
+
+
+/// @brief A half-precision (IEEE 754 binary16) floating-point value. Only meant for storage; convert to 'float' to do arithmetic.
+///
+/// @sa bfloat16
+class float16
+{
+public:
+	uint16_t bits;
+
+public:
+	float16( void ) = default;
+	explicit float16(float f) : bits(__wide_float_to_half(f)) {}
+	explicit operator float( void ) const { return __wide_half_to_float(bits); }
+};
+
+
+/// @brief A brain floating-point value, i.e. the upper 16 bits of a single-precision value. Has the same range as 'float', but only 8 bits of precision. Only meant for storage; convert to 'float' to do arithmetic.
+///
+/// @sa float16
+class bfloat16
+{
+public:
+	uint16_t bits;
+
+public:
+	bfloat16( void ) = default;
+	explicit bfloat16(float f) : bits(__wide_float_to_bfloat16(f)) {}
+	explicit operator float( void ) const { return __wide_bfloat16_to_float(bits); }
+};
 
 template < int bits >
 class __wide_types {};
 
+/// @brief Stands in for the floating-point type of bit depths that have none. The integer types refer to 'wide_float' of the same depth in their conversion constructors, so it has to be nameable, but it is not meant to be used.
+class __wide_no_float {};
+
 template <>
 class __wide_types<8>
 {
 public:
-	typedef uint8_t uint_t;
-	typedef int8_t  int_t;
-	typedef uint8_t bool_t;
+	typedef uint8_t         uint_t;
+	typedef int8_t          int_t;
+	typedef uint8_t         bool_t;
+	typedef __wide_no_float float_t;
 };
 
+// 'wide_float<16,Width>' only stores half-precision values. Use 'widen' and 'narrow' to convert to and from 'wide_float<32,Width>' to do arithmetic.
 template <>
 class __wide_types<16>
 {
@@ -236,6 +617,7 @@ public:
 	typedef uint16_t uint_t;
 	typedef int16_t  int_t;
 	typedef uint16_t bool_t;
+	typedef float16  float_t;
 };
 
 template <>
@@ -277,6 +659,7 @@ struct cset
 {
 	const wide_bool<wide_t::depth,wide_t::width> &mask;
 	const wide_t                                  value;
+	const bool                                    uniform; // All lanes of the mask are true, so the value can be assigned without blending.
 };
 
 
@@ -315,19 +698,19 @@ public:
 	
 	wide_bool &operator=(const wide_bool&) = default;
 	wide_bool &operator=(bool r)                            { FOR(v[i] = r ? TRUE_BITS : FALSE_BITS) return *this; }
-	wide_bool &operator=(const cset<wide_bool> &test)       { *this = cmov(test.mask, test.value, *this); return *this; }
-	wide_bool &operator=(const cset<const wide_bool> &test) { *this = cmov(test.mask, test.value, *this); return *this; }
+	wide_bool &operator=(const cset<wide_bool> &test)       { if (test.uniform) { *this = test.value; } else { *this = cmov(test.mask, test.value, *this); } return *this; }
+	wide_bool &operator=(const cset<const wide_bool> &test) { if (test.uniform) { *this = test.value; } else { *this = cmov(test.mask, test.value, *this); } return *this; }
 
 	struct values { serial_t vals[Width]; };
 	wide_bool(const values &vals) : wide_bool(vals.vals) {}
 	wide_bool &operator=(const values &vals) { FOR(v[i] = vals.vals[i]) return *this; }
 
 	wide_bool &operator &=(const wide_bool &r) { FOR(v[i] &= r.v[i]) return *this; }
-	wide_bool &operator &=(bool r)             { FOR(v[i] &= r)      return *this; }
+	wide_bool &operator &=(bool r)             { FOR(v[i] &= r ? TRUE_BITS : FALSE_BITS) return *this; }
 	wide_bool &operator |=(const wide_bool &r) { FOR(v[i] |= r.v[i]) return *this; }
-	wide_bool &operator |=(bool r)             { FOR(v[i] |= r)      return *this; }
+	wide_bool &operator |=(bool r)             { FOR(v[i] |= r ? TRUE_BITS : FALSE_BITS) return *this; }
 	wide_bool &operator ^=(const wide_bool &r) { FOR(v[i] ^= r.v[i]) return *this; }
-	wide_bool &operator ^=(bool r)             { FOR(v[i] ^= r)      return *this; }
+	wide_bool &operator ^=(bool r)             { FOR(v[i] ^= r ? TRUE_BITS : FALSE_BITS) return *this; }
 	
 	wide_bool operator!( void ) const { wide_bool o; FOR(o.v[i] = ~v[i]) return o; }
 
@@ -358,10 +741,10 @@ template < uint32_t Depth, uint32_t Width > wide_bool<Depth,Width> operator ^(bo
 
 template < uint32_t Depth, uint32_t Width > wide_bool<Depth,Width> operator ==(bool l, const wide_bool<Depth,Width> &r) { return wide_bool<Depth,Width>(l) == r; }
 template < uint32_t Depth, uint32_t Width > wide_bool<Depth,Width> operator !=(bool l, const wide_bool<Depth,Width> &r) { return wide_bool<Depth,Width>(l) != r; }
-template < uint32_t Depth, uint32_t Width > wide_bool<Depth,Width> operator < (bool l, const wide_bool<Depth,Width> &r) { return wide_bool<Depth,Width>(l) >= r; }
-template < uint32_t Depth, uint32_t Width > wide_bool<Depth,Width> operator > (bool l, const wide_bool<Depth,Width> &r) { return wide_bool<Depth,Width>(l) <= r; }
-template < uint32_t Depth, uint32_t Width > wide_bool<Depth,Width> operator <=(bool l, const wide_bool<Depth,Width> &r) { return wide_bool<Depth,Width>(l) >  r; }
-template < uint32_t Depth, uint32_t Width > wide_bool<Depth,Width> operator >=(bool l, const wide_bool<Depth,Width> &r) { return wide_bool<Depth,Width>(l) <  r; }
+template < uint32_t Depth, uint32_t Width > wide_bool<Depth,Width> operator < (bool l, const wide_bool<Depth,Width> &r) { return wide_bool<Depth,Width>(l) <  r; }
+template < uint32_t Depth, uint32_t Width > wide_bool<Depth,Width> operator > (bool l, const wide_bool<Depth,Width> &r) { return wide_bool<Depth,Width>(l) >  r; }
+template < uint32_t Depth, uint32_t Width > wide_bool<Depth,Width> operator <=(bool l, const wide_bool<Depth,Width> &r) { return wide_bool<Depth,Width>(l) <= r; }
+template < uint32_t Depth, uint32_t Width > wide_bool<Depth,Width> operator >=(bool l, const wide_bool<Depth,Width> &r) { return wide_bool<Depth,Width>(l) >= r; }
 
 template < uint32_t Depth, uint32_t Width > wide_bool<Depth,Width> operator &&(bool l, const wide_bool<Depth,Width> &r) { return wide_bool<Depth,Width>(l) && r; }
 template < uint32_t Depth, uint32_t Width > wide_bool<Depth,Width> operator ||(bool l, const wide_bool<Depth,Width> &r) { return wide_bool<Depth,Width>(l) && r; }
@@ -379,6 +762,7 @@ public:
 	typedef typename __wide_types<Depth>::int_t serial_t;
 	static constexpr uint32_t width = Width;
 	static constexpr uint32_t depth = Depth;
+	friend class wide_bool<Depth,Width>;
 	friend class wide_float<Depth,Width>;
 	friend class wide_uint<Depth,Width>;
 
@@ -408,6 +792,7 @@ public:
 	typedef typename __wide_types<Depth>::uint_t serial_t;
 	static constexpr uint32_t width = Width;
 	static constexpr uint32_t depth = Depth;
+	friend class wide_bool<Depth,Width>;
 	friend class wide_float<Depth,Width>;
 	friend class wide_int<Depth,Width>;
 
@@ -437,6 +822,7 @@ public:
 	typedef typename __wide_types<Depth>::float_t serial_t;
 	static constexpr uint32_t width = Width;
 	static constexpr uint32_t depth = Depth;
+	friend class wide_bool<Depth,Width>;
 	friend class wide_int<Depth,Width>;
 	friend class wide_uint<Depth,Width>;
 
@@ -454,100 +840,3352 @@ ARITOPOPS(wide_float)
 CMPOPOPS(wide_float)
 
 
-/// @brief Stores 'a' when condition is true, and 'b' when condition is false for each lane in the wide values. This function is used to merge the results of branching paths together into a single wide value.
-///
-/// @param condition the condition for which to merge 'a' and 'b' into a single output.
-/// @param a a wide value.
-/// @param b a wide value.
+
+/// @brief Returns the upper half of the full product of two serial integers.
 ///
-/// @returns the merged results between 'a' and 'b'; lane 'a' when corresponding lane in 'condition' is true, and lane 'b' otherwise.
+/// @param a the first factor.
+/// @param b the second factor.
 ///
-/// @sa wide_cset
-template < typename wide_t >
-wide_t cmov(const wide_bool<wide_t::depth, wide_t::width> &condition, const wide_t &a, const wide_t &b) {
-	const auto o = (*reinterpret_cast<const wide_bool<wide_t::depth, wide_t::width>*>(&a) & condition) | (*reinterpret_cast<const wide_bool<wide_t::depth, wide_t::width>*>(&b) & (!condition));
-	return *reinterpret_cast<const wide_t*>(&o);
+/// @returns the upper half of the product.
+template < typename serial_t >
+inline serial_t __wide_mulhi(serial_t a, serial_t b)
+{
+	typedef typename std::conditional<std::is_signed<serial_t>::value, int64_t, uint64_t>::type product_t;
+	return serial_t((product_t(a) * product_t(b)) >> (sizeof(serial_t) * 8));
 }
 
+inline uint64_t __wide_mulhi(uint64_t a, uint64_t b)
+{
+	const uint64_t lo    = (a & 0xffffffffu) * (b & 0xffffffffu);
+	const uint64_t mid1  = (a >> 32) * (b & 0xffffffffu) + (lo >> 32);
+	const uint64_t mid2  = (a & 0xffffffffu) * (b >> 32) + (mid1 & 0xffffffffu);
+	return (a >> 32) * (b >> 32) + (mid1 >> 32) + (mid2 >> 32);
+}
 
-/// @brief Stores 'a' when condition is true, and 'b' when condition is false for each lane in the wide values. This function is used to merge the results of branching paths together into a single wide value.
-///
-/// @param condition the condition for which to merge 'a' and 'b' into a single output.
-/// @param a a serial value.
-/// @param b a wide value.
-///
-/// @returns the merged results between 'a' and 'b'; lane 'a' when corresponding lane in 'condition' is true, and lane 'b' otherwise.
-///
-/// @sa wide_cset
-template < typename wide_t > wide_t cmov(const wide_bool<wide_t::depth, wide_t::width> &condition, typename wide_t::serial_t a, const wide_t &b) { return cmov(condition, wide_t(a), b); }
+inline int64_t __wide_mulhi(int64_t a, int64_t b)
+{
+	// The signed product differs from the unsigned product of the same bits by 'b * 2^64' if 'a' is negative, and vice versa.
+	const uint64_t hi = __wide_mulhi(uint64_t(a), uint64_t(b)) - (a < 0 ? uint64_t(b) : 0) - (b < 0 ? uint64_t(a) : 0);
+	return int64_t(hi);
+}
 
 
-/// @brief Stores 'a' when condition is true, and 'b' when condition is false for each lane in the wide values. This function is used to merge the results of branching paths together into a single wide value.
-///
-/// @param condition the condition for which to merge 'a' and 'b' into a single output.
-/// @param a a wide value.
-/// @param b a serial value.
-///
-/// @returns the merged results between 'a' and 'b'; lane 'a' when corresponding lane in 'condition' is true, and lane 'b' otherwise.
+
+/// @brief Maps the operations of the wide types onto the instructions of the target architecture for a given bit depth and width. Only specialized for combinations where the target architecture provides a native register, in which case the wide types are specialized to store the native register rather than an array.
 ///
-/// @sa wide_cset
-template < typename wide_t > wide_t cmov(const wide_bool<wide_t::depth, wide_t::width> &condition, const wide_t &a, typename wide_t::serial_t b) { return cmov(condition, a, wide_t(b)); }
+/// @note Operations that have no native instruction fall back to processing each lane individually.
+template < uint32_t Depth, uint32_t Width >
+class __wide_simd {};
 
 
-/// @brief Directly converts pointer to a raw array of basic built-in types into a pointer to a wide type array with an optional memory alignment requirement which defaults to the byte size of the target wide type.
+/// @brief Counts the number of set bits in an integer.
 ///
-/// @note It is recommended to ensure byte alignment requirements with the input array, as otherwise this may cause the resulting wide type pointer to point futher ahead than the input serial pointer.
+/// @param x the integer.
 ///
-/// @note Some architectures may not be able to convert non-aligned input memory. Others may impose performance penalties for operating on non-aligned output memory.
-///
-/// @param stream pointer to the array of serial values to convert to wide values.
-/// @param byte_alignment the number of bytes to align the output memory to. Defaults to the byte count of the wide type, as that is generally safe. If the input memory is not already aligned the output memory will point ahead of the input memory.
-///
-/// @returns pointer to the array of wide values.
-template < typename wide_t > wide_t *wide_cast(typename wide_t::serial_t *stream, size_t byte_alignment = sizeof(wide_t)) { return (stream & ~(byte_alignment - 1)) == stream ? reinterpret_cast<wide_t*>(stream) : nullptr; }
+/// @returns the number of set bits.
+inline uint32_t __wide_popcount(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return uint32_t(__builtin_popcountll(x));
+#else
+	uint32_t n = 0;
+	for (; x != 0; x &= x - 1) { ++n; }
+	return n;
+#endif
+}
 
 
-/// @brief Directly converts pointer to a raw array of basic built-in types into a pointer to a wide type array with an optional memory alignment requirement which defaults to the byte size of the target wide type.
-///
-/// @note It is recommended to ensure byte alignment requirements with the input array, as otherwise this may cause the resulting wide type pointer to point futher ahead than the input serial pointer.
-///
-/// @note Some architectures may not be able to convert non-aligned input memory. Others may impose performance penalties for operating on non-aligned output memory.
-///
-/// @param stream pointer to the array of serial values to convert to wide values.
-/// @param byte_alignment the number of bytes to align the output memory to. Defaults to the byte count of the wide type, as that is generally safe. If the input memory is not already aligned the output memory will point ahead of the input memory.
-///
-/// @returns pointer to the array of wide values.
-template < typename wide_t > const wide_t *wide_cast(const typename wide_t::serial_t *stream, size_t byte_alignment = sizeof(wide_t)) { return (stream & ~(byte_alignment - 1)) == stream ? reinterpret_cast<wide_t*>(stream) : nullptr; }
+#if defined(CC0_WIDE_NATIVE_SSE4_1)
+
+/// @brief Returns the 'compress' entry of '__wide_lane_tables' for a mask, starting at bit 'i' with 'n' true bits below it.
+constexpr uint64_t __wide_compress_entry(uint32_t m, uint32_t i = 0, uint32_t n = 0)
+{
+	return i == 8 ? 0 : (((m >> i) & 1) ? ((uint64_t(i) << (8 * n)) | __wide_compress_entry(m, i + 1, n + 1)) : __wide_compress_entry(m, i + 1, n));
+}
 
 
-/// @brief Casts a wide type into its serial components in order to be able to directly access the internal types of the wide type. This is not generally recommended unless you are flushing data out to a serial array.
-///
-/// @param w the input wide type to access.
-///
-/// @returns pointer to the array of serial values that the input wide value is composed of.
-template < typename wide_t > typename wide_t::serial_t *serialize(wide_t &w) { return reinterpret_cast<typename wide_t::serial_t*>(&w); }
+/// @brief Returns the 'expand' entry of '__wide_lane_tables' for a mask, starting at bit 'i' with 'n' true bits below it.
+constexpr uint64_t __wide_expand_entry(uint32_t m, uint32_t i = 0, uint32_t n = 0)
+{
+	return i == 8 ? 0 : (((m >> i) & 1) ? ((uint64_t(n) << (8 * i)) | __wide_expand_entry(m, i + 1, n + 1)) : __wide_expand_entry(m, i + 1, n));
+}
 
+#define LANE_TABLE_4(f, m)   f(m), f(m + 1), f(m + 2), f(m + 3)
+#define LANE_TABLE_16(f, m)  LANE_TABLE_4(f, m), LANE_TABLE_4(f, m + 4), LANE_TABLE_4(f, m + 8), LANE_TABLE_4(f, m + 12)
+#define LANE_TABLE_64(f, m)  LANE_TABLE_16(f, m), LANE_TABLE_16(f, m + 16), LANE_TABLE_16(f, m + 32), LANE_TABLE_16(f, m + 48)
+#define LANE_TABLE_256(f)    LANE_TABLE_64(f, 0), LANE_TABLE_64(f, 64), LANE_TABLE_64(f, 128), LANE_TABLE_64(f, 192)
 
-/// @brief Casts a wide type into its serial components in order to be able to directly access the internal types of the wide type. This is not generally recommended unless you are flushing data out to a serial array.
-///
-/// @param w the input wide type to access.
+/// @brief Lane indices for compressing and expanding up to eight lanes, looked up by the movemask of the mask. Each entry packs one byte per lane, lowest lane in the lowest byte, and is widened to the lane size by the native backends.
 ///
-/// @returns pointer to the array of serial values that the input wide value is composed of.
-template < typename wide_t > const typename wide_t::serial_t *serialize(const wide_t &w) { return reinterpret_cast<const typename wide_t::serial_t*>(&w); }
+/// @note In 'compress', byte 'k' is the lane of the 'k'th true bit, and bytes past the number of true bits are zero. In 'expand', byte 'i' is the number of true bits below bit 'i' if bit 'i' is true, and zero otherwise.
+/// @note The tables are generated at compile time. They are static members of a template, so that all translation units share one definition without a guarded initialization.
+template < typename unused_t >
+class __wide_lane_tables_t
+{
+public:
+	static constexpr uint64_t compress[256] = { LANE_TABLE_256(__wide_compress_entry) };
+	static constexpr uint64_t expand[256]   = { LANE_TABLE_256(__wide_expand_entry) };
+};
 
-// Useful typedefs. Provide WIDE_DEPTH and WIDE_WIDTH defines through the build stage.
-#if defined(CC0_WIDE_DEPTH) && defined(CC0_WIDE_WIDTH)
-	#define CC0_WIDE_DEFAULTS
-	typedef wide_bool<CC0_WIDE_DEPTH,CC0_WIDE_WIDTH>  bool_t;
-	typedef wide_int<CC0_WIDE_DEPTH,CC0_WIDE_WIDTH>   int_t;
-	typedef wide_uint<CC0_WIDE_DEPTH,CC0_WIDE_WIDTH>  uint_t;
-	typedef wide_float<CC0_WIDE_DEPTH,CC0_WIDE_WIDTH> float_t;
+template < typename unused_t > constexpr uint64_t __wide_lane_tables_t<unused_t>::compress[256];
+template < typename unused_t > constexpr uint64_t __wide_lane_tables_t<unused_t>::expand[256];
+
+typedef __wide_lane_tables_t<void> __wide_lane_tables;
+
+#undef LANE_TABLE_256
+#undef LANE_TABLE_64
+#undef LANE_TABLE_16
+#undef LANE_TABLE_4
+
+#endif
+
+#define LANES(T, expr) \
+	alignas(sizeof(ireg_t)) T x[sizeof(ireg_t) / sizeof(T)]; \
+	alignas(sizeof(ireg_t)) T y[sizeof(ireg_t) / sizeof(T)]; \
+	i_store(x, a); \
+	i_store(y, b); \
+	for (uint32_t i = 0; i < sizeof(ireg_t) / sizeof(T); ++i) { x[i] = T(expr); } \
+	return i_load(x);
+
+#define CONVERT(To, From, store, load) \
+	alignas(sizeof(ireg_t)) From x[sizeof(ireg_t) / sizeof(From)]; \
+	alignas(sizeof(ireg_t)) To   y[sizeof(ireg_t) / sizeof(To)]; \
+	store(x, a); \
+	for (uint32_t i = 0; i < sizeof(ireg_t) / sizeof(To); ++i) { y[i] = To(x[i]); } \
+	return load(y);
+
+#if defined(CC0_WIDE_NATIVE_SSE2)
+
+class __wide_simd_sse
+{
+public:
+	typedef __m128i ireg_t;
+
+	static ireg_t i_zero( void )                  { return _mm_setzero_si128(); }
+	static ireg_t i_load(const void *p)           { return _mm_load_si128(reinterpret_cast<const __m128i*>(p)); }
+	static ireg_t i_loadu(const void *p)          { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+	static void   i_store(void *p, ireg_t a)      { _mm_store_si128(reinterpret_cast<__m128i*>(p), a); }
+	static void   i_storeu(void *p, ireg_t a)     { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), a); }
+	static void   i_stream(void *p, ireg_t a)     { _mm_stream_si128(reinterpret_cast<__m128i*>(p), a); }
+	static ireg_t i_and(ireg_t a, ireg_t b)       { return _mm_and_si128(a, b); }
+	static ireg_t i_andnot(ireg_t a, ireg_t b)    { return _mm_andnot_si128(a, b); }
+	static ireg_t i_or(ireg_t a, ireg_t b)        { return _mm_or_si128(a, b); }
+	static ireg_t i_xor(ireg_t a, ireg_t b)       { return _mm_xor_si128(a, b); }
+	static ireg_t i_not(ireg_t a)                 { return _mm_xor_si128(a, _mm_set1_epi32(-1)); }
+	static bool   i_any(ireg_t a)                 { return _mm_movemask_epi8(a) != 0; }
+#if defined(CC0_WIDE_NATIVE_SSE4_1)
+	static ireg_t i_blend(ireg_t m, ireg_t a, ireg_t b) { return _mm_blendv_epi8(b, a, m); }
+#else
+	static ireg_t i_blend(ireg_t m, ireg_t a, ireg_t b) { return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b)); }
+#endif
+	static ireg_t i_fold(ireg_t a, uint32_t bytes)
+	{
+		switch (bytes) {
+		case 8:  return _mm_srli_si128(a, 8);
+		case 4:  return _mm_srli_si128(a, 4);
+		case 2:  return _mm_srli_si128(a, 2);
+		default: return _mm_srli_si128(a, 1);
+		}
+	}
+	// Counts and reverses the bits of each byte; via 4-bit lookup tables where byte shuffles are available, and via bit-parallel arithmetic otherwise.
+#if defined(CC0_WIDE_NATIVE_SSE4_1)
+	static ireg_t i_popcnt8(ireg_t a)
+	{
+		const ireg_t lut = _mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+		const ireg_t lo  = _mm_set1_epi8(0x0f);
+		return _mm_add_epi8(_mm_shuffle_epi8(lut, _mm_and_si128(a, lo)), _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(a, 4), lo)));
+	}
+	static ireg_t i_bitrev8(ireg_t a)
+	{
+		const ireg_t lut = _mm_setr_epi8(0x0, 0x8, 0x4, 0xc, 0x2, 0xa, 0x6, 0xe, 0x1, 0x9, 0x5, 0xd, 0x3, 0xb, 0x7, 0xf);
+		const ireg_t lo  = _mm_set1_epi8(0x0f);
+		return _mm_or_si128(_mm_slli_epi16(_mm_shuffle_epi8(lut, _mm_and_si128(a, lo)), 4), _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(a, 4), lo)));
+	}
+#else
+	static ireg_t i_popcnt8(ireg_t a)
+	{
+		a = _mm_sub_epi8(a, _mm_and_si128(_mm_srli_epi16(a, 1), _mm_set1_epi8(0x55)));
+		a = _mm_add_epi8(_mm_and_si128(a, _mm_set1_epi8(0x33)), _mm_and_si128(_mm_srli_epi16(a, 2), _mm_set1_epi8(0x33)));
+		return _mm_and_si128(_mm_add_epi8(a, _mm_srli_epi16(a, 4)), _mm_set1_epi8(0x0f));
+	}
+	static ireg_t i_bitrev8(ireg_t a)
+	{
+		a = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(a, 1), _mm_set1_epi8(0x55)), _mm_slli_epi16(_mm_and_si128(a, _mm_set1_epi8(0x55)), 1));
+		a = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(a, 2), _mm_set1_epi8(0x33)), _mm_slli_epi16(_mm_and_si128(a, _mm_set1_epi8(0x33)), 2));
+		return _mm_or_si128(_mm_and_si128(_mm_srli_epi16(a, 4), _mm_set1_epi8(0x0f)), _mm_slli_epi16(_mm_and_si128(a, _mm_set1_epi8(0x0f)), 4));
+	}
+#endif
+};
+
+template <>
+class __wide_simd<8,16> : public __wide_simd_sse
+{
+public:
+	static ireg_t i_set(uint8_t a)                { return _mm_set1_epi8(char(a)); }
+	static ireg_t i_add(ireg_t a, ireg_t b)       { return _mm_add_epi8(a, b); }
+	static ireg_t i_sub(ireg_t a, ireg_t b)       { return _mm_sub_epi8(a, b); }
+	static ireg_t i_mul(ireg_t a, ireg_t b)
+	{
+		const ireg_t even = _mm_and_si128(_mm_mullo_epi16(a, b), _mm_set1_epi16(0x00ff));
+		const ireg_t odd  = _mm_slli_epi16(_mm_mullo_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8)), 8);
+		return _mm_or_si128(even, odd);
+	}
+	static ireg_t i_mulhi(ireg_t a, ireg_t b)
+	{
+		// Sign-extend to 16 bits by unpacking each byte into the upper half of a 16-bit lane and shifting it back down.
+		const ireg_t lo = _mm_mullo_epi16(_mm_srai_epi16(_mm_unpacklo_epi8(a, a), 8), _mm_srai_epi16(_mm_unpacklo_epi8(b, b), 8));
+		const ireg_t hi = _mm_mullo_epi16(_mm_srai_epi16(_mm_unpackhi_epi8(a, a), 8), _mm_srai_epi16(_mm_unpackhi_epi8(b, b), 8));
+		return _mm_packs_epi16(_mm_srai_epi16(lo, 8), _mm_srai_epi16(hi, 8));
+	}
+	static ireg_t u_mulhi(ireg_t a, ireg_t b)
+	{
+		const ireg_t lo = _mm_mullo_epi16(_mm_unpacklo_epi8(a, i_zero()), _mm_unpacklo_epi8(b, i_zero()));
+		const ireg_t hi = _mm_mullo_epi16(_mm_unpackhi_epi8(a, i_zero()), _mm_unpackhi_epi8(b, i_zero()));
+		return _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8));
+	}
+	static ireg_t i_adds(ireg_t a, ireg_t b)      { return _mm_adds_epi8(a, b); }
+	static ireg_t u_adds(ireg_t a, ireg_t b)      { return _mm_adds_epu8(a, b); }
+	static ireg_t i_subs(ireg_t a, ireg_t b)      { return _mm_subs_epi8(a, b); }
+	static ireg_t u_subs(ireg_t a, ireg_t b)      { return _mm_subs_epu8(a, b); }
+	static ireg_t u_avg(ireg_t a, ireg_t b)       { return _mm_avg_epu8(a, b); }
+	static ireg_t i_avg(ireg_t a, ireg_t b)       { const ireg_t s = i_set(0x80); return _mm_xor_si128(_mm_avg_epu8(_mm_xor_si128(a, s), _mm_xor_si128(b, s)), s); }
+	// Sign-extends by unpacking each byte into the upper half of a 16-bit lane and shifting it back down.
+	static ireg_t i_widen_lo(ireg_t a)            { return _mm_srai_epi16(_mm_unpacklo_epi8(a, a), 8); }
+	static ireg_t i_widen_hi(ireg_t a)            { return _mm_srai_epi16(_mm_unpackhi_epi8(a, a), 8); }
+	static ireg_t u_widen_lo(ireg_t a)            { return _mm_unpacklo_epi8(a, i_zero()); }
+	static ireg_t u_widen_hi(ireg_t a)            { return _mm_unpackhi_epi8(a, i_zero()); }
+	static ireg_t i_narrow(ireg_t a, ireg_t b)    { return _mm_packs_epi16(a, b); }
+	// The pack instruction treats its input as signed, so the unsigned input is first clamped via 'x - max(x - 255, 0)'.
+	static ireg_t u_narrow(ireg_t a, ireg_t b)    { const ireg_t m = _mm_set1_epi16(0xff); return _mm_packus_epi16(_mm_sub_epi16(a, _mm_subs_epu16(a, m)), _mm_sub_epi16(b, _mm_subs_epu16(b, m))); }
+	static ireg_t i_shl(ireg_t a, int n)          { return n > 7 ? i_zero() : _mm_and_si128(_mm_sll_epi16(a, _mm_cvtsi32_si128(n)), i_set(uint8_t(0xff << n))); }
+	static ireg_t i_srl(ireg_t a, int n)          { return n > 7 ? i_zero() : _mm_and_si128(_mm_srl_epi16(a, _mm_cvtsi32_si128(n)), i_set(uint8_t(0xff >> n))); }
+	static ireg_t i_sra(ireg_t a, int n)          { n = n > 7 ? 7 : n; const ireg_t s = i_set(uint8_t(0x80 >> n)); return _mm_sub_epi8(_mm_xor_si128(i_srl(a, n), s), s); }
+	static ireg_t i_shlv(ireg_t a, ireg_t b)      { LANES(uint8_t, x[i] << y[i]) }
+	static ireg_t i_srlv(ireg_t a, ireg_t b)      { LANES(uint8_t, x[i] >> y[i]) }
+	static ireg_t i_srav(ireg_t a, ireg_t b)      { LANES(int8_t,  x[i] >> y[i]) }
+	static ireg_t i_eq(ireg_t a, ireg_t b)        { return _mm_cmpeq_epi8(a, b); }
+	static ireg_t i_gt(ireg_t a, ireg_t b)        { return _mm_cmpgt_epi8(a, b); }
+	static ireg_t i_ugt(ireg_t a, ireg_t b)       { const ireg_t s = i_set(0x80); return _mm_cmpgt_epi8(_mm_xor_si128(a, s), _mm_xor_si128(b, s)); }
+	static uint32_t i_movemask(ireg_t a)          { return uint32_t(_mm_movemask_epi8(a)); }
+	static ireg_t i_popcnt(ireg_t a)              { return i_popcnt8(a); }
+	static ireg_t i_bswap(ireg_t a)               { return a; }
+	static ireg_t i_bitrev(ireg_t a)              { return i_bitrev8(a); }
+	static ireg_t i_interleave_lo(ireg_t a, ireg_t b) { return _mm_unpacklo_epi8(a, b); }
+	static ireg_t i_interleave_hi(ireg_t a, ireg_t b) { return _mm_unpackhi_epi8(a, b); }
+#if defined(CC0_WIDE_NATIVE_SSE4_1)
+	static ireg_t i_permute(ireg_t a, ireg_t i)   { return _mm_shuffle_epi8(a, _mm_and_si128(i, _mm_set1_epi8(15))); }
+	// The tables cover eight lanes, so the indices of the upper half are offset by eight and appended after the true lanes of the lower half.
+	static ireg_t i_compress_index(uint32_t m)
+	{
+		const uint64_t lo = __wide_lane_tables::compress[m & 0xff];
+		const uint64_t hi = __wide_lane_tables::compress[m >> 8] + 0x0808080808080808ull;
+		const uint32_t s  = 8 * __wide_popcount(m & 0xff);
+		return _mm_set_epi64x(static_cast<long long>(s > 0 ? hi >> (64 - s) : 0), static_cast<long long>(lo | (s < 64 ? hi << s : 0)));
+	}
+	static ireg_t i_expand_index(uint32_t m)
+	{
+		const uint64_t lo = __wide_lane_tables::expand[m & 0xff];
+		const uint64_t hi = __wide_lane_tables::expand[m >> 8] + 0x0101010101010101ull * uint64_t(__wide_popcount(m & 0xff));
+		return _mm_set_epi64x(static_cast<long long>(hi), static_cast<long long>(lo));
+	}
+#endif
+};
+
+template <>
+class __wide_simd<16,8> : public __wide_simd_sse
+{
+public:
+	static ireg_t i_set(uint16_t a)               { return _mm_set1_epi16(short(a)); }
+	static ireg_t i_add(ireg_t a, ireg_t b)       { return _mm_add_epi16(a, b); }
+	static ireg_t i_sub(ireg_t a, ireg_t b)       { return _mm_sub_epi16(a, b); }
+	static ireg_t i_mul(ireg_t a, ireg_t b)       { return _mm_mullo_epi16(a, b); }
+	static ireg_t i_mulhi(ireg_t a, ireg_t b)     { return _mm_mulhi_epi16(a, b); }
+	static ireg_t u_mulhi(ireg_t a, ireg_t b)     { return _mm_mulhi_epu16(a, b); }
+	static ireg_t i_adds(ireg_t a, ireg_t b)      { return _mm_adds_epi16(a, b); }
+	static ireg_t u_adds(ireg_t a, ireg_t b)      { return _mm_adds_epu16(a, b); }
+	static ireg_t i_subs(ireg_t a, ireg_t b)      { return _mm_subs_epi16(a, b); }
+	static ireg_t u_subs(ireg_t a, ireg_t b)      { return _mm_subs_epu16(a, b); }
+	static ireg_t u_avg(ireg_t a, ireg_t b)       { return _mm_avg_epu16(a, b); }
+	static ireg_t i_avg(ireg_t a, ireg_t b)       { const ireg_t s = i_set(0x8000); return _mm_xor_si128(_mm_avg_epu16(_mm_xor_si128(a, s), _mm_xor_si128(b, s)), s); }
+	static ireg_t i_widen_lo(ireg_t a)            { return _mm_srai_epi32(_mm_unpacklo_epi16(a, a), 16); }
+	static ireg_t i_widen_hi(ireg_t a)            { return _mm_srai_epi32(_mm_unpackhi_epi16(a, a), 16); }
+	static ireg_t u_widen_lo(ireg_t a)            { return _mm_unpacklo_epi16(a, i_zero()); }
+	static ireg_t u_widen_hi(ireg_t a)            { return _mm_unpackhi_epi16(a, i_zero()); }
+	static ireg_t i_narrow(ireg_t a, ireg_t b)    { return _mm_packs_epi32(a, b); }
+	static ireg_t i_shl(ireg_t a, int n)          { return _mm_sll_epi16(a, _mm_cvtsi32_si128(n)); }
+	static ireg_t i_srl(ireg_t a, int n)          { return _mm_srl_epi16(a, _mm_cvtsi32_si128(n)); }
+	static ireg_t i_sra(ireg_t a, int n)          { return _mm_sra_epi16(a, _mm_cvtsi32_si128(n)); }
+	static ireg_t i_shlv(ireg_t a, ireg_t b)      { LANES(uint16_t, x[i] << y[i]) }
+	static ireg_t i_srlv(ireg_t a, ireg_t b)      { LANES(uint16_t, x[i] >> y[i]) }
+	static ireg_t i_srav(ireg_t a, ireg_t b)      { LANES(int16_t,  x[i] >> y[i]) }
+	static ireg_t i_eq(ireg_t a, ireg_t b)        { return _mm_cmpeq_epi16(a, b); }
+	static ireg_t i_gt(ireg_t a, ireg_t b)        { return _mm_cmpgt_epi16(a, b); }
+	static ireg_t i_ugt(ireg_t a, ireg_t b)       { const ireg_t s = i_set(0x8000); return _mm_cmpgt_epi16(_mm_xor_si128(a, s), _mm_xor_si128(b, s)); }
+	static uint32_t i_movemask(ireg_t a)          { return uint32_t(_mm_movemask_epi8(_mm_packs_epi16(a, _mm_setzero_si128()))); }
+	static ireg_t i_popcnt(ireg_t a)              { const ireg_t c = i_popcnt8(a); return _mm_srli_epi16(_mm_add_epi16(c, _mm_slli_epi16(c, 8)), 8); }
+	static ireg_t i_bswap(ireg_t a)               { return _mm_or_si128(_mm_slli_epi16(a, 8), _mm_srli_epi16(a, 8)); }
+	static ireg_t i_bitrev(ireg_t a)              { return i_bitrev8(i_bswap(a)); }
+	static ireg_t i_interleave_lo(ireg_t a, ireg_t b) { return _mm_unpacklo_epi16(a, b); }
+	static ireg_t i_interleave_hi(ireg_t a, ireg_t b) { return _mm_unpackhi_epi16(a, b); }
+#if defined(CC0_WIDE_NATIVE_SSE4_1)
+	static ireg_t i_permute(ireg_t a, ireg_t i)
+	{
+		// Expand lane indices to byte indices, i.e. lane index 'n' becomes bytes '2n' and '2n+1'.
+		const ireg_t b = _mm_slli_epi16(_mm_and_si128(i, _mm_set1_epi16(7)), 1);
+		return _mm_shuffle_epi8(a, _mm_or_si128(b, _mm_slli_epi16(_mm_add_epi16(b, _mm_set1_epi16(1)), 8)));
+	}
+	static ireg_t i_compress_index(uint32_t m)    { return _mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(&__wide_lane_tables::compress[m]))); }
+	static ireg_t i_expand_index(uint32_t m)      { return _mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(&__wide_lane_tables::expand[m]))); }
+	static ireg_t u_narrow(ireg_t a, ireg_t b)    { const ireg_t m = _mm_set1_epi32(0xffff); return _mm_packus_epi32(_mm_min_epu32(a, m), _mm_min_epu32(b, m)); }
+#endif
+#if defined(CC0_WIDE_NATIVE_AVX2)
+	static __m256i i_widen(ireg_t a)              { return _mm256_cvtepi16_epi32(a); }
+	static __m256i u_widen(ireg_t a)              { return _mm256_cvtepu16_epi32(a); }
+	static ireg_t  i_narrow(__m256i a)            { return i_narrow(_mm256_castsi256_si128(a), _mm256_extracti128_si256(a, 1)); }
+	static ireg_t  u_narrow(__m256i a)            { return u_narrow(_mm256_castsi256_si128(a), _mm256_extracti128_si256(a, 1)); }
 #endif
+};
+
+#endif
+
+#if defined(CC0_WIDE_NATIVE_SSE4_1)
 
+template <>
+class __wide_simd<32,4> : public __wide_simd_sse
+{
+public:
+	typedef __m128 freg_t;
+
+	static ireg_t i_set(uint32_t a)               { return _mm_set1_epi32(int(a)); }
+	static ireg_t i_add(ireg_t a, ireg_t b)       { return _mm_add_epi32(a, b); }
+	static ireg_t i_sub(ireg_t a, ireg_t b)       { return _mm_sub_epi32(a, b); }
+	static ireg_t i_mul(ireg_t a, ireg_t b)       { return _mm_mullo_epi32(a, b); }
+	// The 32-bit multiplies produce 64-bit products of the even lanes, so the odd lanes are shifted into place for a second multiply.
+	static ireg_t i_mulhi(ireg_t a, ireg_t b)     { return _mm_blend_epi16(_mm_srli_epi64(_mm_mul_epi32(a, b), 32), _mm_mul_epi32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32)), 0xcc); }
+	static ireg_t u_mulhi(ireg_t a, ireg_t b)     { return _mm_blend_epi16(_mm_srli_epi64(_mm_mul_epu32(a, b), 32), _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32)), 0xcc); }
+	static ireg_t i_shl(ireg_t a, int n)          { return _mm_sll_epi32(a, _mm_cvtsi32_si128(n)); }
+	static ireg_t i_srl(ireg_t a, int n)          { return _mm_srl_epi32(a, _mm_cvtsi32_si128(n)); }
+	static ireg_t i_sra(ireg_t a, int n)          { return _mm_sra_epi32(a, _mm_cvtsi32_si128(n)); }
+#if defined(CC0_WIDE_NATIVE_AVX2)
+	static ireg_t i_shlv(ireg_t a, ireg_t b)      { return _mm_sllv_epi32(a, b); }
+	static ireg_t i_srlv(ireg_t a, ireg_t b)      { return _mm_srlv_epi32(a, b); }
+	static ireg_t i_srav(ireg_t a, ireg_t b)      { return _mm_srav_epi32(a, b); }
+#else
+	static ireg_t i_shlv(ireg_t a, ireg_t b)      { LANES(uint32_t, x[i] << y[i]) }
+	static ireg_t i_srlv(ireg_t a, ireg_t b)      { LANES(uint32_t, x[i] >> y[i]) }
+	static ireg_t i_srav(ireg_t a, ireg_t b)      { LANES(int32_t,  x[i] >> y[i]) }
+#endif
+	static ireg_t i_eq(ireg_t a, ireg_t b)        { return _mm_cmpeq_epi32(a, b); }
+	static ireg_t i_gt(ireg_t a, ireg_t b)        { return _mm_cmpgt_epi32(a, b); }
+	static ireg_t i_ugt(ireg_t a, ireg_t b)       { const ireg_t s = i_set(0x80000000u); return _mm_cmpgt_epi32(_mm_xor_si128(a, s), _mm_xor_si128(b, s)); }
+	static uint32_t i_movemask(ireg_t a)          { return uint32_t(_mm_movemask_ps(_mm_castsi128_ps(a))); }
+	static ireg_t i_popcnt(ireg_t a)              { return _mm_madd_epi16(_mm_maddubs_epi16(i_popcnt8(a), _mm_set1_epi8(1)), _mm_set1_epi16(1)); }
+	static ireg_t i_bswap(ireg_t a)               { return _mm_shuffle_epi8(a, _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12)); }
+	static ireg_t i_bitrev(ireg_t a)              { return i_bitrev8(i_bswap(a)); }
+	static ireg_t i_interleave_lo(ireg_t a, ireg_t b) { return _mm_unpacklo_epi32(a, b); }
+	static ireg_t i_interleave_hi(ireg_t a, ireg_t b) { return _mm_unpackhi_epi32(a, b); }
+	static ireg_t i_permute(ireg_t a, ireg_t i)
+	{
+		// Expand lane indices to byte indices, i.e. lane index 'n' becomes bytes '4n' to '4n+3'.
+		const ireg_t b = _mm_slli_epi32(_mm_and_si128(i, _mm_set1_epi32(3)), 2);
+		return _mm_shuffle_epi8(a, _mm_add_epi32(_mm_mullo_epi32(b, _mm_set1_epi32(0x01010101)), _mm_set1_epi32(0x03020100)));
+	}
+	static ireg_t i_compress_index(uint32_t m)    { return _mm_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(&__wide_lane_tables::compress[m]))); }
+	static ireg_t i_expand_index(uint32_t m)      { return _mm_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(&__wide_lane_tables::expand[m]))); }
+#if defined(CC0_WIDE_NATIVE_AVX2)
+	static __m256i i_widen(ireg_t a)              { return _mm256_cvtepi32_epi64(a); }
+	static __m256i u_widen(ireg_t a)              { return _mm256_cvtepu32_epi64(a); }
+	// There is no instruction that packs 64-bit lanes, so the lanes are clamped first and their lower halves gathered via a permute.
+	static ireg_t i_narrow(__m256i a)
+	{
+		const __m256i hi = _mm256_set1_epi64x(0x7fffffffll);
+		const __m256i lo = _mm256_set1_epi64x(-0x80000000ll);
+		a = _mm256_blendv_epi8(a, hi, _mm256_cmpgt_epi64(a, hi));
+		a = _mm256_blendv_epi8(a, lo, _mm256_cmpgt_epi64(lo, a));
+		return _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(a, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6)));
+	}
+	static ireg_t u_narrow(__m256i a)
+	{
+		const __m256i s  = _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000ull));
+		const __m256i hi = _mm256_set1_epi64x(0xffffffffll);
+		a = _mm256_blendv_epi8(a, hi, _mm256_cmpgt_epi64(_mm256_xor_si256(a, s), _mm256_xor_si256(hi, s)));
+		return _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(a, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6)));
+	}
+#endif
+
+	static freg_t f_set(float a)                  { return _mm_set1_ps(a); }
+	static freg_t f_load(const float *p)          { return _mm_load_ps(p); }
+	static freg_t f_loadu(const float *p)         { return _mm_loadu_ps(p); }
+	static void   f_store(float *p, freg_t a)     { _mm_store_ps(p, a); }
+	static void   f_storeu(float *p, freg_t a)    { _mm_storeu_ps(p, a); }
+	static void   f_stream(float *p, freg_t a)    { _mm_stream_ps(p, a); }
+#if defined(CC0_WIDE_NATIVE_F16C)
+	static freg_t f_load_half(const void *p)      { return _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p))); }
+	static void   f_store_half(void *p, freg_t a) { _mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm_cvtps_ph(a, _MM_FROUND_TO_NEAREST_INT)); }
+#endif
+#if defined(CC0_WIDE_NATIVE_AVX2)
+	static ireg_t i_maskload(const void *p, ireg_t m)         { return _mm_maskload_epi32(reinterpret_cast<const int*>(p), m); }
+	static void   i_maskstore(void *p, ireg_t m, ireg_t a)    { _mm_maskstore_epi32(reinterpret_cast<int*>(p), m, a); }
+	static freg_t f_maskload(const float *p, ireg_t m)        { return _mm_maskload_ps(p, m); }
+	static void   f_maskstore(float *p, ireg_t m, freg_t a)   { _mm_maskstore_ps(p, m, a); }
+	static ireg_t i_gather(const void *p, ireg_t i)                    { return _mm_i32gather_epi32(reinterpret_cast<const int*>(p), i, 4); }
+	static ireg_t i_mgather(const void *p, ireg_t i, ireg_t m)         { return _mm_mask_i32gather_epi32(_mm_setzero_si128(), reinterpret_cast<const int*>(p), i, m, 4); }
+	static freg_t f_gather(const float *p, ireg_t i)                   { return _mm_i32gather_ps(p, i, 4); }
+	static freg_t f_mgather(const float *p, ireg_t i, ireg_t m)        { return _mm_mask_i32gather_ps(_mm_setzero_ps(), p, i, _mm_castsi128_ps(m), 4); }
+#endif
+	static freg_t f_add(freg_t a, freg_t b)       { return _mm_add_ps(a, b); }
+	static freg_t f_sub(freg_t a, freg_t b)       { return _mm_sub_ps(a, b); }
+	static freg_t f_mul(freg_t a, freg_t b)       { return _mm_mul_ps(a, b); }
+	static freg_t f_div(freg_t a, freg_t b)       { return _mm_div_ps(a, b); }
+	static freg_t f_neg(freg_t a)                 { return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+#if defined(CC0_WIDE_NATIVE_FMA)
+	static freg_t f_fmadd(freg_t a, freg_t b, freg_t c)  { return _mm_fmadd_ps(a, b, c); }
+	static freg_t f_fmsub(freg_t a, freg_t b, freg_t c)  { return _mm_fmsub_ps(a, b, c); }
+	static freg_t f_fnmadd(freg_t a, freg_t b, freg_t c) { return _mm_fnmadd_ps(a, b, c); }
+#else
+	static freg_t f_fmadd(freg_t a, freg_t b, freg_t c)  { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+	static freg_t f_fmsub(freg_t a, freg_t b, freg_t c)  { return _mm_sub_ps(_mm_mul_ps(a, b), c); }
+	static freg_t f_fnmadd(freg_t a, freg_t b, freg_t c) { return _mm_sub_ps(c, _mm_mul_ps(a, b)); }
+#endif
+	static freg_t f_rcp(freg_t a)                 { return _mm_rcp_ps(a); }
+	static freg_t f_rsqrt(freg_t a)               { return _mm_rsqrt_ps(a); }
+	static freg_t f_sqrt(freg_t a)                { return _mm_sqrt_ps(a); }
+	static ireg_t f_eq(freg_t a, freg_t b)        { return _mm_castps_si128(_mm_cmpeq_ps(a, b)); }
+	static ireg_t f_ne(freg_t a, freg_t b)        { return _mm_castps_si128(_mm_cmpneq_ps(a, b)); }
+	static ireg_t f_lt(freg_t a, freg_t b)        { return _mm_castps_si128(_mm_cmplt_ps(a, b)); }
+	static ireg_t f_gt(freg_t a, freg_t b)        { return _mm_castps_si128(_mm_cmpgt_ps(a, b)); }
+	static ireg_t f_le(freg_t a, freg_t b)        { return _mm_castps_si128(_mm_cmple_ps(a, b)); }
+	static ireg_t f_ge(freg_t a, freg_t b)        { return _mm_castps_si128(_mm_cmpge_ps(a, b)); }
+	static ireg_t f_bits(freg_t a)                { return _mm_castps_si128(a); }
+	static freg_t f_cast(ireg_t a)                { return _mm_castsi128_ps(a); }
+	static freg_t f_blend(ireg_t m, freg_t a, freg_t b) { return _mm_blendv_ps(b, a, _mm_castsi128_ps(m)); }
+	static ireg_t i_from_f(freg_t a)              { return _mm_cvttps_epi32(a); }
+	static freg_t f_from_i(ireg_t a)              { return _mm_cvtepi32_ps(a); }
+	static freg_t f_from_u(ireg_t a)
+	{
+		const freg_t hi = _mm_cvtepi32_ps(_mm_srli_epi32(a, 16));
+		const freg_t lo = _mm_cvtepi32_ps(_mm_and_si128(a, _mm_set1_epi32(0xffff)));
+		return _mm_add_ps(_mm_mul_ps(hi, _mm_set1_ps(65536.0f)), lo);
+	}
+	static ireg_t u_from_f(freg_t a)
+	{
+		const freg_t two31 = _mm_set1_ps(2147483648.0f);
+		const freg_t big   = _mm_cmpge_ps(a, two31);
+		const ireg_t x     = _mm_cvttps_epi32(_mm_sub_ps(a, _mm_and_ps(big, two31)));
+		return _mm_xor_si128(x, _mm_slli_epi32(_mm_castps_si128(big), 31));
+	}
+};
+
+#endif
+
+#if defined(CC0_WIDE_NATIVE_AVX2)
+
+class __wide_simd_avx
+{
+public:
+	typedef __m256i ireg_t;
+
+	static ireg_t i_zero( void )                  { return _mm256_setzero_si256(); }
+	static ireg_t i_load(const void *p)           { return _mm256_load_si256(reinterpret_cast<const __m256i*>(p)); }
+	static ireg_t i_loadu(const void *p)          { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+	static void   i_store(void *p, ireg_t a)      { _mm256_store_si256(reinterpret_cast<__m256i*>(p), a); }
+	static void   i_storeu(void *p, ireg_t a)     { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), a); }
+	static void   i_stream(void *p, ireg_t a)     { _mm256_stream_si256(reinterpret_cast<__m256i*>(p), a); }
+	static ireg_t i_and(ireg_t a, ireg_t b)       { return _mm256_and_si256(a, b); }
+	static ireg_t i_andnot(ireg_t a, ireg_t b)    { return _mm256_andnot_si256(a, b); }
+	static ireg_t i_or(ireg_t a, ireg_t b)        { return _mm256_or_si256(a, b); }
+	static ireg_t i_xor(ireg_t a, ireg_t b)       { return _mm256_xor_si256(a, b); }
+	static ireg_t i_not(ireg_t a)                 { return _mm256_xor_si256(a, _mm256_set1_epi32(-1)); }
+	static bool   i_any(ireg_t a)                 { return !_mm256_testz_si256(a, a); }
+	static ireg_t i_blend(ireg_t m, ireg_t a, ireg_t b) { return _mm256_blendv_epi8(b, a, m); }
+	static ireg_t i_fold(ireg_t a, uint32_t bytes)
+	{
+		switch (bytes) {
+		case 16: return _mm256_permute2x128_si256(a, a, 1);
+		case 8:  return _mm256_srli_si256(a, 8);
+		case 4:  return _mm256_srli_si256(a, 4);
+		case 2:  return _mm256_srli_si256(a, 2);
+		default: return _mm256_srli_si256(a, 1);
+		}
+	}
+	static ireg_t i_popcnt8(ireg_t a)
+	{
+		const ireg_t lut = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+		const ireg_t lo  = _mm256_set1_epi8(0x0f);
+		return _mm256_add_epi8(_mm256_shuffle_epi8(lut, _mm256_and_si256(a, lo)), _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(a, 4), lo)));
+	}
+	static ireg_t i_bitrev8(ireg_t a)
+	{
+		const ireg_t lut = _mm256_setr_epi8(0x0, 0x8, 0x4, 0xc, 0x2, 0xa, 0x6, 0xe, 0x1, 0x9, 0x5, 0xd, 0x3, 0xb, 0x7, 0xf, 0x0, 0x8, 0x4, 0xc, 0x2, 0xa, 0x6, 0xe, 0x1, 0x9, 0x5, 0xd, 0x3, 0xb, 0x7, 0xf);
+		const ireg_t lo  = _mm256_set1_epi8(0x0f);
+		return _mm256_or_si256(_mm256_slli_epi16(_mm256_shuffle_epi8(lut, _mm256_and_si256(a, lo)), 4), _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(a, 4), lo)));
+	}
+};
+
+template <>
+class __wide_simd<32,8> : public __wide_simd_avx
+{
+public:
+	typedef __m256 freg_t;
+
+	static ireg_t i_set(uint32_t a)               { return _mm256_set1_epi32(int(a)); }
+	static ireg_t i_add(ireg_t a, ireg_t b)       { return _mm256_add_epi32(a, b); }
+	static ireg_t i_sub(ireg_t a, ireg_t b)       { return _mm256_sub_epi32(a, b); }
+	static ireg_t i_mul(ireg_t a, ireg_t b)       { return _mm256_mullo_epi32(a, b); }
+	static ireg_t i_mulhi(ireg_t a, ireg_t b)     { return _mm256_blend_epi32(_mm256_srli_epi64(_mm256_mul_epi32(a, b), 32), _mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32)), 0xaa); }
+	static ireg_t u_mulhi(ireg_t a, ireg_t b)     { return _mm256_blend_epi32(_mm256_srli_epi64(_mm256_mul_epu32(a, b), 32), _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32)), 0xaa); }
+	static ireg_t i_shl(ireg_t a, int n)          { return _mm256_sll_epi32(a, _mm_cvtsi32_si128(n)); }
+	static ireg_t i_srl(ireg_t a, int n)          { return _mm256_srl_epi32(a, _mm_cvtsi32_si128(n)); }
+	static ireg_t i_sra(ireg_t a, int n)          { return _mm256_sra_epi32(a, _mm_cvtsi32_si128(n)); }
+	static ireg_t i_shlv(ireg_t a, ireg_t b)      { return _mm256_sllv_epi32(a, b); }
+	static ireg_t i_srlv(ireg_t a, ireg_t b)      { return _mm256_srlv_epi32(a, b); }
+	static ireg_t i_srav(ireg_t a, ireg_t b)      { return _mm256_srav_epi32(a, b); }
+	static ireg_t i_eq(ireg_t a, ireg_t b)        { return _mm256_cmpeq_epi32(a, b); }
+	static ireg_t i_gt(ireg_t a, ireg_t b)        { return _mm256_cmpgt_epi32(a, b); }
+	static ireg_t i_ugt(ireg_t a, ireg_t b)       { const ireg_t s = i_set(0x80000000u); return _mm256_cmpgt_epi32(_mm256_xor_si256(a, s), _mm256_xor_si256(b, s)); }
+	static uint32_t i_movemask(ireg_t a)          { return uint32_t(_mm256_movemask_ps(_mm256_castsi256_ps(a))); }
+	static ireg_t i_popcnt(ireg_t a)              { return _mm256_madd_epi16(_mm256_maddubs_epi16(i_popcnt8(a), _mm256_set1_epi8(1)), _mm256_set1_epi16(1)); }
+	static ireg_t i_bswap(ireg_t a)               { return _mm256_shuffle_epi8(a, _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12)); }
+	static ireg_t i_bitrev(ireg_t a)              { return i_bitrev8(i_bswap(a)); }
+	static ireg_t i_interleave_lo(ireg_t a, ireg_t b) { return _mm256_permute2x128_si256(_mm256_unpacklo_epi32(a, b), _mm256_unpackhi_epi32(a, b), 0x20); }
+	static ireg_t i_interleave_hi(ireg_t a, ireg_t b) { return _mm256_permute2x128_si256(_mm256_unpacklo_epi32(a, b), _mm256_unpackhi_epi32(a, b), 0x31); }
+	static ireg_t i_permute(ireg_t a, ireg_t i)       { return _mm256_permutevar8x32_epi32(a, _mm256_and_si256(i, _mm256_set1_epi32(7))); }
+	static ireg_t i_compress_index(uint32_t m)        { return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(&__wide_lane_tables::compress[m]))); }
+	static ireg_t i_expand_index(uint32_t m)          { return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(&__wide_lane_tables::expand[m]))); }
+	// The 256-bit unpack instructions interleave within each 128-bit half, so the halves are extended separately instead.
+	static ireg_t i_widen_lo(ireg_t a)            { return _mm256_cvtepi32_epi64(_mm256_castsi256_si128(a)); }
+	static ireg_t i_widen_hi(ireg_t a)            { return _mm256_cvtepi32_epi64(_mm256_extracti128_si256(a, 1)); }
+	static ireg_t u_widen_lo(ireg_t a)            { return _mm256_cvtepu32_epi64(_mm256_castsi256_si128(a)); }
+	static ireg_t u_widen_hi(ireg_t a)            { return _mm256_cvtepu32_epi64(_mm256_extracti128_si256(a, 1)); }
+	static ireg_t i_narrow(ireg_t a, ireg_t b)    { return _mm256_inserti128_si256(_mm256_castsi128_si256(__wide_simd<32,4>::i_narrow(a)), __wide_simd<32,4>::i_narrow(b), 1); }
+	static ireg_t u_narrow(ireg_t a, ireg_t b)    { return _mm256_inserti128_si256(_mm256_castsi128_si256(__wide_simd<32,4>::u_narrow(a)), __wide_simd<32,4>::u_narrow(b), 1); }
+
+	static freg_t f_set(float a)                  { return _mm256_set1_ps(a); }
+	static freg_t f_load(const float *p)          { return _mm256_load_ps(p); }
+	static freg_t f_loadu(const float *p)         { return _mm256_loadu_ps(p); }
+	static void   f_store(float *p, freg_t a)     { _mm256_store_ps(p, a); }
+	static void   f_storeu(float *p, freg_t a)    { _mm256_storeu_ps(p, a); }
+	static void   f_stream(float *p, freg_t a)    { _mm256_stream_ps(p, a); }
+#if defined(CC0_WIDE_NATIVE_F16C)
+	static freg_t f_load_half(const void *p)      { return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))); }
+	static void   f_store_half(void *p, freg_t a) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm256_cvtps_ph(a, _MM_FROUND_TO_NEAREST_INT)); }
+#endif
+	static ireg_t i_maskload(const void *p, ireg_t m)         { return _mm256_maskload_epi32(reinterpret_cast<const int*>(p), m); }
+	static void   i_maskstore(void *p, ireg_t m, ireg_t a)    { _mm256_maskstore_epi32(reinterpret_cast<int*>(p), m, a); }
+	static freg_t f_maskload(const float *p, ireg_t m)        { return _mm256_maskload_ps(p, m); }
+	static void   f_maskstore(float *p, ireg_t m, freg_t a)   { _mm256_maskstore_ps(p, m, a); }
+	static ireg_t i_gather(const void *p, ireg_t i)                    { return _mm256_i32gather_epi32(reinterpret_cast<const int*>(p), i, 4); }
+	static ireg_t i_mgather(const void *p, ireg_t i, ireg_t m)         { return _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), reinterpret_cast<const int*>(p), i, m, 4); }
+	static freg_t f_gather(const float *p, ireg_t i)                   { return _mm256_i32gather_ps(p, i, 4); }
+	static freg_t f_mgather(const float *p, ireg_t i, ireg_t m)        { return _mm256_mask_i32gather_ps(_mm256_setzero_ps(), p, i, _mm256_castsi256_ps(m), 4); }
+	static freg_t f_add(freg_t a, freg_t b)       { return _mm256_add_ps(a, b); }
+	static freg_t f_sub(freg_t a, freg_t b)       { return _mm256_sub_ps(a, b); }
+	static freg_t f_mul(freg_t a, freg_t b)       { return _mm256_mul_ps(a, b); }
+	static freg_t f_div(freg_t a, freg_t b)       { return _mm256_div_ps(a, b); }
+	static freg_t f_neg(freg_t a)                 { return _mm256_xor_ps(a, _mm256_set1_ps(-0.0f)); }
+#if defined(CC0_WIDE_NATIVE_FMA)
+	static freg_t f_fmadd(freg_t a, freg_t b, freg_t c)  { return _mm256_fmadd_ps(a, b, c); }
+	static freg_t f_fmsub(freg_t a, freg_t b, freg_t c)  { return _mm256_fmsub_ps(a, b, c); }
+	static freg_t f_fnmadd(freg_t a, freg_t b, freg_t c) { return _mm256_fnmadd_ps(a, b, c); }
+#else
+	static freg_t f_fmadd(freg_t a, freg_t b, freg_t c)  { return _mm256_add_ps(_mm256_mul_ps(a, b), c); }
+	static freg_t f_fmsub(freg_t a, freg_t b, freg_t c)  { return _mm256_sub_ps(_mm256_mul_ps(a, b), c); }
+	static freg_t f_fnmadd(freg_t a, freg_t b, freg_t c) { return _mm256_sub_ps(c, _mm256_mul_ps(a, b)); }
+#endif
+	static freg_t f_rcp(freg_t a)                 { return _mm256_rcp_ps(a); }
+	static freg_t f_rsqrt(freg_t a)               { return _mm256_rsqrt_ps(a); }
+	static freg_t f_sqrt(freg_t a)                { return _mm256_sqrt_ps(a); }
+	static ireg_t f_eq(freg_t a, freg_t b)        { return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)); }
+	static ireg_t f_ne(freg_t a, freg_t b)        { return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_NEQ_UQ)); }
+	static ireg_t f_lt(freg_t a, freg_t b)        { return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_LT_OQ)); }
+	static ireg_t f_gt(freg_t a, freg_t b)        { return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_GT_OQ)); }
+	static ireg_t f_le(freg_t a, freg_t b)        { return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_LE_OQ)); }
+	static ireg_t f_ge(freg_t a, freg_t b)        { return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_GE_OQ)); }
+	static ireg_t f_bits(freg_t a)                { return _mm256_castps_si256(a); }
+	static freg_t f_cast(ireg_t a)                { return _mm256_castsi256_ps(a); }
+	static freg_t f_blend(ireg_t m, freg_t a, freg_t b) { return _mm256_blendv_ps(b, a, _mm256_castsi256_ps(m)); }
+	static ireg_t i_from_f(freg_t a)              { return _mm256_cvttps_epi32(a); }
+	static freg_t f_from_i(ireg_t a)              { return _mm256_cvtepi32_ps(a); }
+	static freg_t f_from_u(ireg_t a)
+	{
+		const freg_t hi = _mm256_cvtepi32_ps(_mm256_srli_epi32(a, 16));
+		const freg_t lo = _mm256_cvtepi32_ps(_mm256_and_si256(a, _mm256_set1_epi32(0xffff)));
+		return _mm256_add_ps(_mm256_mul_ps(hi, _mm256_set1_ps(65536.0f)), lo);
+	}
+	static ireg_t u_from_f(freg_t a)
+	{
+		const freg_t two31 = _mm256_set1_ps(2147483648.0f);
+		const freg_t big   = _mm256_cmp_ps(a, two31, _CMP_GE_OQ);
+		const ireg_t x     = _mm256_cvttps_epi32(_mm256_sub_ps(a, _mm256_and_ps(big, two31)));
+		return _mm256_xor_si256(x, _mm256_slli_epi32(_mm256_castps_si256(big), 31));
+	}
+};
+
+template <>
+class __wide_simd<64,4> : public __wide_simd_avx
+{
+public:
+	typedef __m256d freg_t;
+
+	static ireg_t i_set(uint64_t a)               { return _mm256_set1_epi64x(static_cast<long long>(a)); }
+	static ireg_t i_add(ireg_t a, ireg_t b)       { return _mm256_add_epi64(a, b); }
+	static ireg_t i_sub(ireg_t a, ireg_t b)       { return _mm256_sub_epi64(a, b); }
+	static ireg_t i_mul(ireg_t a, ireg_t b)
+	{
+		const ireg_t lo    = _mm256_mul_epu32(a, b);
+		const ireg_t cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b), _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+		return _mm256_add_epi64(lo, _mm256_slli_epi64(cross, 32));
+	}
+	static ireg_t i_mulhi(ireg_t a, ireg_t b)     { LANES(int64_t,  __wide_mulhi(x[i], y[i])) }
+	static ireg_t u_mulhi(ireg_t a, ireg_t b)     { LANES(uint64_t, __wide_mulhi(x[i], y[i])) }
+	static ireg_t i_shl(ireg_t a, int n)          { return _mm256_sll_epi64(a, _mm_cvtsi32_si128(n)); }
+	static ireg_t i_srl(ireg_t a, int n)          { return _mm256_srl_epi64(a, _mm_cvtsi32_si128(n)); }
+	static ireg_t i_sra(ireg_t a, int n)          { return _mm256_or_si256(i_srl(a, n), _mm256_sll_epi64(_mm256_cmpgt_epi64(i_zero(), a), _mm_cvtsi32_si128(64 - n))); }
+	static ireg_t i_shlv(ireg_t a, ireg_t b)      { return _mm256_sllv_epi64(a, b); }
+	static ireg_t i_srlv(ireg_t a, ireg_t b)      { return _mm256_srlv_epi64(a, b); }
+	static ireg_t i_srav(ireg_t a, ireg_t b)      { return _mm256_or_si256(_mm256_srlv_epi64(a, b), _mm256_sllv_epi64(_mm256_cmpgt_epi64(i_zero(), a), _mm256_sub_epi64(i_set(64), b))); }
+	static ireg_t i_eq(ireg_t a, ireg_t b)        { return _mm256_cmpeq_epi64(a, b); }
+	static ireg_t i_gt(ireg_t a, ireg_t b)        { return _mm256_cmpgt_epi64(a, b); }
+	static ireg_t i_ugt(ireg_t a, ireg_t b)       { const ireg_t s = i_set(0x8000000000000000ull); return _mm256_cmpgt_epi64(_mm256_xor_si256(a, s), _mm256_xor_si256(b, s)); }
+	static uint32_t i_movemask(ireg_t a)          { return uint32_t(_mm256_movemask_pd(_mm256_castsi256_pd(a))); }
+	static ireg_t i_popcnt(ireg_t a)              { return _mm256_sad_epu8(i_popcnt8(a), i_zero()); }
+	static ireg_t i_bswap(ireg_t a)               { return _mm256_shuffle_epi8(a, _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8)); }
+	static ireg_t i_bitrev(ireg_t a)              { return i_bitrev8(i_bswap(a)); }
+	static ireg_t i_interleave_lo(ireg_t a, ireg_t b) { return _mm256_permute2x128_si256(_mm256_unpacklo_epi64(a, b), _mm256_unpackhi_epi64(a, b), 0x20); }
+	static ireg_t i_interleave_hi(ireg_t a, ireg_t b) { return _mm256_permute2x128_si256(_mm256_unpacklo_epi64(a, b), _mm256_unpackhi_epi64(a, b), 0x31); }
+	static ireg_t i_permute(ireg_t a, ireg_t i)
+	{
+		// Expand 64-bit lane indices to pairs of 32-bit lane indices, i.e. lane index 'n' becomes '2n' and '2n+1'.
+		const ireg_t b = _mm256_slli_epi64(_mm256_and_si256(i, _mm256_set1_epi64x(3)), 1);
+		return _mm256_permutevar8x32_epi32(a, _mm256_or_si256(b, _mm256_slli_epi64(_mm256_add_epi64(b, _mm256_set1_epi64x(1)), 32)));
+	}
+	static ireg_t i_compress_index(uint32_t m)        { return _mm256_cvtepu8_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(&__wide_lane_tables::compress[m]))); }
+	static ireg_t i_expand_index(uint32_t m)          { return _mm256_cvtepu8_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(&__wide_lane_tables::expand[m]))); }
+
+	static freg_t f_set(double a)                 { return _mm256_set1_pd(a); }
+	static freg_t f_load(const double *p)         { return _mm256_load_pd(p); }
+	static freg_t f_loadu(const double *p)        { return _mm256_loadu_pd(p); }
+	static void   f_store(double *p, freg_t a)    { _mm256_store_pd(p, a); }
+	static void   f_storeu(double *p, freg_t a)   { _mm256_storeu_pd(p, a); }
+	static void   f_stream(double *p, freg_t a)   { _mm256_stream_pd(p, a); }
+	static ireg_t i_maskload(const void *p, ireg_t m)         { return _mm256_maskload_epi64(reinterpret_cast<const long long*>(p), m); }
+	static void   i_maskstore(void *p, ireg_t m, ireg_t a)    { _mm256_maskstore_epi64(reinterpret_cast<long long*>(p), m, a); }
+	static freg_t f_maskload(const double *p, ireg_t m)       { return _mm256_maskload_pd(p, m); }
+	static void   f_maskstore(double *p, ireg_t m, freg_t a)  { _mm256_maskstore_pd(p, m, a); }
+	static ireg_t i_gather(const void *p, ireg_t i)                    { return _mm256_i64gather_epi64(reinterpret_cast<const long long*>(p), i, 8); }
+	static ireg_t i_mgather(const void *p, ireg_t i, ireg_t m)         { return _mm256_mask_i64gather_epi64(_mm256_setzero_si256(), reinterpret_cast<const long long*>(p), i, m, 8); }
+	static freg_t f_gather(const double *p, ireg_t i)                  { return _mm256_i64gather_pd(p, i, 8); }
+	static freg_t f_mgather(const double *p, ireg_t i, ireg_t m)       { return _mm256_mask_i64gather_pd(_mm256_setzero_pd(), p, i, _mm256_castsi256_pd(m), 8); }
+	static freg_t f_add(freg_t a, freg_t b)       { return _mm256_add_pd(a, b); }
+	static freg_t f_sub(freg_t a, freg_t b)       { return _mm256_sub_pd(a, b); }
+	static freg_t f_mul(freg_t a, freg_t b)       { return _mm256_mul_pd(a, b); }
+	static freg_t f_div(freg_t a, freg_t b)       { return _mm256_div_pd(a, b); }
+	static freg_t f_neg(freg_t a)                 { return _mm256_xor_pd(a, _mm256_set1_pd(-0.0)); }
+#if defined(CC0_WIDE_NATIVE_FMA)
+	static freg_t f_fmadd(freg_t a, freg_t b, freg_t c)  { return _mm256_fmadd_pd(a, b, c); }
+	static freg_t f_fmsub(freg_t a, freg_t b, freg_t c)  { return _mm256_fmsub_pd(a, b, c); }
+	static freg_t f_fnmadd(freg_t a, freg_t b, freg_t c) { return _mm256_fnmadd_pd(a, b, c); }
+#else
+	static freg_t f_fmadd(freg_t a, freg_t b, freg_t c)  { return _mm256_add_pd(_mm256_mul_pd(a, b), c); }
+	static freg_t f_fmsub(freg_t a, freg_t b, freg_t c)  { return _mm256_sub_pd(_mm256_mul_pd(a, b), c); }
+	static freg_t f_fnmadd(freg_t a, freg_t b, freg_t c) { return _mm256_sub_pd(c, _mm256_mul_pd(a, b)); }
+#endif
+	static freg_t f_sqrt(freg_t a)                { return _mm256_sqrt_pd(a); }
+	static ireg_t f_eq(freg_t a, freg_t b)        { return _mm256_castpd_si256(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)); }
+	static ireg_t f_ne(freg_t a, freg_t b)        { return _mm256_castpd_si256(_mm256_cmp_pd(a, b, _CMP_NEQ_UQ)); }
+	static ireg_t f_lt(freg_t a, freg_t b)        { return _mm256_castpd_si256(_mm256_cmp_pd(a, b, _CMP_LT_OQ)); }
+	static ireg_t f_gt(freg_t a, freg_t b)        { return _mm256_castpd_si256(_mm256_cmp_pd(a, b, _CMP_GT_OQ)); }
+	static ireg_t f_le(freg_t a, freg_t b)        { return _mm256_castpd_si256(_mm256_cmp_pd(a, b, _CMP_LE_OQ)); }
+	static ireg_t f_ge(freg_t a, freg_t b)        { return _mm256_castpd_si256(_mm256_cmp_pd(a, b, _CMP_GE_OQ)); }
+	static ireg_t f_bits(freg_t a)                { return _mm256_castpd_si256(a); }
+	static freg_t f_cast(ireg_t a)                { return _mm256_castsi256_pd(a); }
+	static freg_t f_blend(ireg_t m, freg_t a, freg_t b) { return _mm256_blendv_pd(b, a, _mm256_castsi256_pd(m)); }
+	static ireg_t i_from_f(freg_t a)              { CONVERT(int64_t,  double,   f_store, i_load) }
+	static freg_t f_from_i(ireg_t a)              { CONVERT(double,   int64_t,  i_store, f_load) }
+	static freg_t f_from_u(ireg_t a)              { CONVERT(double,   uint64_t, i_store, f_load) }
+	static ireg_t u_from_f(freg_t a)              { CONVERT(uint64_t, double,   f_store, i_load) }
+};
+
+#endif
+
+#undef LANES
+#undef CONVERT
+
+#define NATIVE_WITH(...) __VA_ARGS__
+#define NATIVE_WITHOUT(...)
+
+#define NATIVE_HEAD(type, kind, D, W, reg_t, blend) \
+public: \
+	typedef __wide_types<D>::kind serial_t; \
+	typedef __wide_simd<D,W>::reg_t native_t; \
+	static constexpr uint32_t width = W; \
+	static constexpr uint32_t depth = D; \
+\
+private: \
+	typedef __wide_simd<D,W> simd; \
+	union { \
+		native_t v; \
+		serial_t serial[W]; /* Makes serialize well-defined under strict aliasing. */ \
+	}; \
+\
+public: \
+	type( void ) = default; \
+	type(const type&) = default; \
+	explicit type(native_t r) : v(r) {} \
+	type &operator=(const type&) = default; \
+	type &operator=(const cset<type> &test) { v = test.uniform ? test.value.v : simd::blend(test.mask.native(), test.value.v, v); return *this; } \
+	type &operator=(const cset<const type> &test) { v = test.uniform ? test.value.v : simd::blend(test.mask.native(), test.value.v, v); return *this; } \
+	const native_t &native( void ) const { return v; }
+
+#define NATIVE_CMP(type, op, set, expr) \
+	wide_bool<depth,width> operator op(const type &r) const     { const native_t a = v; const native_t b = r.v;         return wide_bool<depth,width>(expr); } \
+	wide_bool<depth,width> operator op(const serial_t &r) const { const native_t a = v; const native_t b = simd::set(r); return wide_bool<depth,width>(expr); }
+
+#define NATIVE_ICMPOPS(type, gt) \
+	NATIVE_CMP(type, ==, i_set, simd::i_eq(a, b)) \
+	NATIVE_CMP(type, !=, i_set, simd::i_not(simd::i_eq(a, b))) \
+	NATIVE_CMP(type, <,  i_set, simd::gt(b, a)) \
+	NATIVE_CMP(type, >,  i_set, simd::gt(a, b)) \
+	NATIVE_CMP(type, <=, i_set, simd::i_not(simd::gt(a, b))) \
+	NATIVE_CMP(type, >=, i_set, simd::i_not(simd::gt(b, a)))
+
+#define NATIVE_FCMPOPS(type) \
+	NATIVE_CMP(type, ==, f_set, simd::f_eq(a, b)) \
+	NATIVE_CMP(type, !=, f_set, simd::f_ne(a, b)) \
+	NATIVE_CMP(type, <,  f_set, simd::f_lt(a, b)) \
+	NATIVE_CMP(type, >,  f_set, simd::f_gt(a, b)) \
+	NATIVE_CMP(type, <=, f_set, simd::f_le(a, b)) \
+	NATIVE_CMP(type, >=, f_set, simd::f_ge(a, b))
+
+#define NATIVE_ASSOP(type, op, set, fn) \
+	type &operator op(const type &r) { v = simd::fn(v, r.v);          return *this; } \
+	type &operator op(serial_t r)    { v = simd::fn(v, simd::set(r)); return *this; }
+
+#define NATIVE_LANEOP(type, op) \
+	type &operator op(const type &r) { alignas(sizeof(native_t)) serial_t a[width]; alignas(sizeof(native_t)) serial_t b[width]; simd::i_store(a, v); simd::i_store(b, r.v); for (uint32_t i = 0; i < width; ++i) { a[i] op b[i]; } v = simd::i_load(a); return *this; } \
+	type &operator op(serial_t r)    { alignas(sizeof(native_t)) serial_t a[width]; simd::i_store(a, v); for (uint32_t i = 0; i < width; ++i) { a[i] op r; } v = simd::i_load(a); return *this; }
+
+#define NATIVE_INCOP(type, op, set, fn) \
+	type &operator op( void ) { v = simd::fn(v, simd::set(1)); return *this; } \
+	type  operator op( int )  { type o = *this; v = simd::fn(v, simd::set(1)); return o; }
+
+#define NATIVE_BOOL(D, W, F) \
+template <> \
+class alignas(W * (D / 8)) wide_bool<D,W> \
+{ \
+NATIVE_HEAD(wide_bool, uint_t, D, W, ireg_t, i_blend) \
+	friend class wide_int<D,W>; \
+	friend class wide_uint<D,W>; \
+	friend class wide_float<D,W>; \
+\
+private: \
+	static constexpr serial_t FALSE_BITS = 0; \
+	static constexpr serial_t TRUE_BITS  = std::numeric_limits<serial_t>::max(); \
+\
+public: \
+	wide_bool(bool r) : v(simd::i_set(r ? TRUE_BITS : FALSE_BITS)) {} \
+	explicit wide_bool(const bool *r) { alignas(sizeof(native_t)) serial_t b[W]; for (uint32_t i = 0; i < W; ++i) { b[i] = r[i] ? TRUE_BITS : FALSE_BITS; } v = simd::i_load(b); } \
+	explicit wide_bool(const wide_int<D,W> &r); \
+	explicit wide_bool(const wide_uint<D,W> &r); \
+	F(explicit wide_bool(const wide_float<D,W> &r);) \
+	wide_bool &operator=(bool r) { v = simd::i_set(r ? TRUE_BITS : FALSE_BITS); return *this; } \
+\
+	struct values { serial_t vals[W]; }; \
+	wide_bool(const values &vals) : v(simd::i_loadu(vals.vals)) {} \
+	wide_bool &operator=(const values &vals) { v = simd::i_loadu(vals.vals); return *this; } \
+\
+	wide_bool &operator &=(const wide_bool &r) { v = simd::i_and(v, r.v); return *this; } \
+	wide_bool &operator &=(bool r)             { return *this &= wide_bool(r); } \
+	wide_bool &operator |=(const wide_bool &r) { v = simd::i_or(v, r.v);  return *this; } \
+	wide_bool &operator |=(bool r)             { return *this |= wide_bool(r); } \
+	wide_bool &operator ^=(const wide_bool &r) { v = simd::i_xor(v, r.v); return *this; } \
+	wide_bool &operator ^=(bool r)             { return *this ^= wide_bool(r); } \
+\
+	wide_bool operator!( void ) const { return wide_bool(simd::i_not(v)); } \
+\
+	NATIVE_ICMPOPS(wide_bool, i_ugt) \
+	wide_bool operator&&(const wide_bool &r) const { return (*this) & r; } \
+	wide_bool operator&&(bool r) const             { return (*this) & r; } \
+	wide_bool operator||(const wide_bool &r) const { return (*this) | r; } \
+	wide_bool operator||(bool r) const             { return (*this) | r; } \
+\
+	operator bool( void ) const { return simd::i_any(v); } \
+\
+	static wide_bool wide_true( void )  { return wide_bool(true); } \
+	static wide_bool wide_false( void ) { return wide_bool(false); } \
+};
+
+#define NATIVE_INTEGER(type, kind, from, D, W, F, S, shr, shrv, gt) \
+template <> \
+class alignas(W * (D / 8)) type<D,W> \
+{ \
+NATIVE_HEAD(type, kind, D, W, ireg_t, i_blend) \
+	friend class wide_bool<D,W>; \
+	friend class from<D,W>; \
+	friend class wide_float<D,W>; \
+\
+public: \
+	type(serial_t r) : v(simd::i_set(r)) {} \
+	explicit type(const serial_t *r) : v(simd::i_loadu(r)) {} \
+	explicit type(const from<D,W> &r); \
+	F(explicit type(const wide_float<D,W> &r);) \
+	explicit type(const wide_bool<D,W> &r) : v(simd::i_and(r.v, simd::i_set(1))) {} \
+	type &operator=(serial_t r) { v = simd::i_set(r); return *this; } \
+\
+	struct values { serial_t vals[W]; }; \
+	type(const values &vals) : type(vals.vals) {} \
+	type &operator=(const values &vals) { v = simd::i_loadu(vals.vals); return *this; } \
+\
+	NATIVE_ASSOP(type, +=, i_set, i_add) \
+	NATIVE_ASSOP(type, -=, i_set, i_sub) \
+	NATIVE_ASSOP(type, *=, i_set, i_mul) \
+	NATIVE_LANEOP(type, /=) \
+	NATIVE_INCOP(type, ++, i_set, i_add) \
+	NATIVE_INCOP(type, --, i_set, i_sub) \
+	NATIVE_LANEOP(type, %=) \
+	type &operator <<=(const type &r) { v = simd::i_shlv(v, r.v); return *this; } \
+	type &operator <<=(serial_t r)    { v = simd::i_shl(v, int(r)); return *this; } \
+	type &operator >>=(const type &r) { v = simd::shrv(v, r.v);   return *this; } \
+	type &operator >>=(serial_t r)    { v = simd::shr(v, int(r));   return *this; } \
+	NATIVE_ASSOP(type, &=, i_set, i_and) \
+	NATIVE_ASSOP(type, |=, i_set, i_or) \
+	NATIVE_ASSOP(type, ^=, i_set, i_xor) \
+	type operator~( void ) const { return type(simd::i_not(v)); } \
+	S(type operator-( void ) const { return type(simd::i_sub(simd::i_zero(), v)); }) \
+	NATIVE_ICMPOPS(type, gt) \
+};
+
+#define NATIVE_FLOAT(D, W) \
+template <> \
+class alignas(W * (D / 8)) wide_float<D,W> \
+{ \
+NATIVE_HEAD(wide_float, float_t, D, W, freg_t, f_blend) \
+	friend class wide_bool<D,W>; \
+	friend class wide_int<D,W>; \
+	friend class wide_uint<D,W>; \
+\
+public: \
+	wide_float(serial_t r) : v(simd::f_set(r)) {} \
+	explicit wide_float(const serial_t *r) : v(simd::f_loadu(r)) {} \
+	explicit wide_float(const wide_int<D,W> &r); \
+	explicit wide_float(const wide_uint<D,W> &r); \
+	explicit wide_float(const wide_bool<D,W> &r) : v(simd::f_cast(simd::i_and(r.v, simd::f_bits(simd::f_set(serial_t(1)))))) {} \
+	wide_float &operator=(serial_t r) { v = simd::f_set(r); return *this; } \
+\
+	struct values { serial_t vals[W]; }; \
+	wide_float(const values &vals) : wide_float(vals.vals) {} \
+	wide_float &operator=(const values &vals) { v = simd::f_loadu(vals.vals); return *this; } \
+\
+	NATIVE_ASSOP(wide_float, +=, f_set, f_add) \
+	NATIVE_ASSOP(wide_float, -=, f_set, f_sub) \
+	NATIVE_ASSOP(wide_float, *=, f_set, f_mul) \
+	NATIVE_ASSOP(wide_float, /=, f_set, f_div) \
+	NATIVE_INCOP(wide_float, ++, f_set, f_add) \
+	NATIVE_INCOP(wide_float, --, f_set, f_sub) \
+	wide_float operator-( void ) const { return wide_float(simd::f_neg(v)); } \
+	NATIVE_FCMPOPS(wide_float) \
+};
+
+#define NATIVE_CONVERSIONS(D, W, F) \
+	inline wide_bool<D,W>::wide_bool(const wide_int<D,W> &r)  : v(simd::i_not(simd::i_eq(r.v, simd::i_zero()))) {} \
+	inline wide_bool<D,W>::wide_bool(const wide_uint<D,W> &r) : v(simd::i_not(simd::i_eq(r.v, simd::i_zero()))) {} \
+	inline wide_int<D,W>::wide_int(const wide_uint<D,W> &r)   : v(r.v) {} \
+	inline wide_uint<D,W>::wide_uint(const wide_int<D,W> &r)  : v(r.v) {} \
+	F( \
+	inline wide_bool<D,W>::wide_bool(const wide_float<D,W> &r) : v(simd::f_ne(r.v, simd::f_set(0))) {} \
+	inline wide_int<D,W>::wide_int(const wide_float<D,W> &r)   : v(simd::i_from_f(r.v)) {} \
+	inline wide_uint<D,W>::wide_uint(const wide_float<D,W> &r) : v(simd::u_from_f(r.v)) {} \
+	inline wide_float<D,W>::wide_float(const wide_int<D,W> &r)  : v(simd::f_from_i(r.v)) {} \
+	inline wide_float<D,W>::wide_float(const wide_uint<D,W> &r) : v(simd::f_from_u(r.v)) {} \
+	)
+
+#define NATIVE_CMOV(type, D, W, blend) \
+	inline type<D,W> cmov(const wide_bool<D,W> &condition, const type<D,W> &a, const type<D,W> &b) { return type<D,W>(__wide_simd<D,W>::blend(condition.native(), a.native(), b.native())); }
+
+#define NATIVE_SHAPE(D, W, F) \
+	template <> class wide_int<D,W>; \
+	template <> class wide_uint<D,W>; \
+	F(template <> class wide_float<D,W>;) \
+	NATIVE_BOOL(D, W, F) \
+	NATIVE_INTEGER(wide_int,  int_t,  wide_uint, D, W, F, NATIVE_WITH,    i_sra, i_srav, i_gt) \
+	NATIVE_INTEGER(wide_uint, uint_t, wide_int,  D, W, F, NATIVE_WITHOUT, i_srl, i_srlv, i_ugt) \
+	F(NATIVE_FLOAT(D, W)) \
+	NATIVE_CONVERSIONS(D, W, F) \
+	NATIVE_CMOV(wide_bool, D, W, i_blend) \
+	NATIVE_CMOV(wide_int, D, W, i_blend) \
+	NATIVE_CMOV(wide_uint, D, W, i_blend) \
+	F(NATIVE_CMOV(wide_float, D, W, f_blend))
+
+#if defined(CC0_WIDE_NATIVE_SSE2)
+	NATIVE_SHAPE(8, 16, NATIVE_WITHOUT)
+	NATIVE_SHAPE(16, 8, NATIVE_WITHOUT)
+#endif
+#if defined(CC0_WIDE_NATIVE_SSE4_1)
+	NATIVE_SHAPE(32, 4, NATIVE_WITH)
+#endif
+#if defined(CC0_WIDE_NATIVE_AVX2)
+	NATIVE_SHAPE(32, 8, NATIVE_WITH)
+	NATIVE_SHAPE(64, 4, NATIVE_WITH)
+#endif
+
+#undef NATIVE_WITH
+#undef NATIVE_WITHOUT
+#undef NATIVE_HEAD
+#undef NATIVE_CMP
+#undef NATIVE_ICMPOPS
+#undef NATIVE_FCMPOPS
+#undef NATIVE_ASSOP
+#undef NATIVE_LANEOP
+#undef NATIVE_INCOP
+#undef NATIVE_BOOL
+#undef NATIVE_INTEGER
+#undef NATIVE_FLOAT
+#undef NATIVE_CONVERSIONS
+#undef NATIVE_CMOV
+#undef NATIVE_SHAPE
+
+
+/// @brief Reinterprets the bits of a wide value as another wide type of the same bit depth and width. Unlike pointer casts, this does not violate strict aliasing rules.
+///
+/// @param w the wide value to reinterpret.
+///
+/// @returns the wide value of the target type with the same bit pattern as the input.
+template < typename to_t, typename from_t >
+to_t bit_cast(const from_t &w)
+{
+	static_assert(to_t::depth == from_t::depth && to_t::width == from_t::width && sizeof(to_t) == sizeof(from_t), "bit_cast requires wide types of equal depth and width");
+	to_t o;
+	std::memcpy(static_cast<void*>(&o), static_cast<const void*>(&w), sizeof(to_t));
+	return o;
+}
+
+
+/// @brief Stores 'a' when condition is true, and 'b' when condition is false for each lane in the wide values. This function is used to merge the results of branching paths together into a single wide value.
+///
+/// @note Native backends implement this as a single blend instruction.
+///
+/// @param condition the condition for which to merge 'a' and 'b' into a single output.
+/// @param a a wide value.
+/// @param b a wide value.
+///
+/// @returns the merged results between 'a' and 'b'; lane 'a' when corresponding lane in 'condition' is true, and lane 'b' otherwise.
+///
+/// @sa wide_cset
+template < typename wide_t >
+wide_t cmov(const wide_bool<wide_t::depth, wide_t::width> &condition, const wide_t &a, const wide_t &b) {
+	typedef wide_uint<wide_t::depth, wide_t::width> bits_t;
+	const bits_t x = bit_cast<bits_t>(a);
+	const bits_t y = bit_cast<bits_t>(b);
+	return bit_cast<wide_t>(y ^ ((x ^ y) & bit_cast<bits_t>(condition)));
+}
+
+
+/// @brief Stores 'a' when condition is true, and 'b' when condition is false for each lane in the wide values. This function is used to merge the results of branching paths together into a single wide value.
+///
+/// @param condition the condition for which to merge 'a' and 'b' into a single output.
+/// @param a a serial value.
+/// @param b a wide value.
+///
+/// @returns the merged results between 'a' and 'b'; lane 'a' when corresponding lane in 'condition' is true, and lane 'b' otherwise.
+///
+/// @sa wide_cset
+template < typename wide_t > wide_t cmov(const wide_bool<wide_t::depth, wide_t::width> &condition, typename wide_t::serial_t a, const wide_t &b) { return cmov(condition, wide_t(a), b); }
+
+
+/// @brief Stores 'a' when condition is true, and 'b' when condition is false for each lane in the wide values. This function is used to merge the results of branching paths together into a single wide value.
+///
+/// @param condition the condition for which to merge 'a' and 'b' into a single output.
+/// @param a a wide value.
+/// @param b a serial value.
+///
+/// @returns the merged results between 'a' and 'b'; lane 'a' when corresponding lane in 'condition' is true, and lane 'b' otherwise.
+///
+/// @sa wide_cset
+template < typename wide_t > wide_t cmov(const wide_bool<wide_t::depth, wide_t::width> &condition, const wide_t &a, typename wide_t::serial_t b) { return cmov(condition, a, wide_t(b)); }
+
+
+/// @brief Directly converts pointer to a raw array of basic built-in types into a pointer to a wide type array with an optional memory alignment requirement which defaults to the byte size of the target wide type.
+///
+/// @note The input array must meet the byte alignment requirement, otherwise the conversion fails. Use load and store to access memory that is not aligned.
+///
+/// @note Some architectures may not be able to convert non-aligned input memory. Others may impose performance penalties for operating on non-aligned output memory.
+///
+/// @param stream pointer to the array of serial values to convert to wide values.
+/// @param byte_alignment the number of bytes the input memory must be aligned to. Defaults to the byte count of the wide type, as that is generally safe. Must be a power of two.
+///
+/// @returns pointer to the array of wide values, or null if the input memory is not aligned.
+///
+/// @sa load
+/// @sa store
+template < typename wide_t > wide_t *wide_cast(typename wide_t::serial_t *stream, size_t byte_alignment = sizeof(wide_t)) { return (reinterpret_cast<uintptr_t>(stream) & (byte_alignment - 1)) == 0 ? reinterpret_cast<wide_t*>(stream) : nullptr; }
+
+
+/// @brief Directly converts pointer to a raw array of basic built-in types into a pointer to a wide type array with an optional memory alignment requirement which defaults to the byte size of the target wide type.
+///
+/// @note The input array must meet the byte alignment requirement, otherwise the conversion fails. Use load and store to access memory that is not aligned.
+///
+/// @note Some architectures may not be able to convert non-aligned input memory. Others may impose performance penalties for operating on non-aligned output memory.
+///
+/// @param stream pointer to the array of serial values to convert to wide values.
+/// @param byte_alignment the number of bytes the input memory must be aligned to. Defaults to the byte count of the wide type, as that is generally safe. Must be a power of two.
+///
+/// @returns pointer to the array of wide values, or null if the input memory is not aligned.
+///
+/// @sa load
+/// @sa store
+template < typename wide_t > const wide_t *wide_cast(const typename wide_t::serial_t *stream, size_t byte_alignment = sizeof(wide_t)) { return (reinterpret_cast<uintptr_t>(stream) & (byte_alignment - 1)) == 0 ? reinterpret_cast<const wide_t*>(stream) : nullptr; }
+
+
+/// @brief Casts a wide type into its serial components in order to be able to directly access the internal types of the wide type. This is not generally recommended unless you are flushing data out to a serial array.
+///
+/// @param w the input wide type to access.
+///
+/// @returns pointer to the array of serial values that the input wide value is composed of.
+template < typename wide_t > typename wide_t::serial_t *serialize(wide_t &w) { return reinterpret_cast<typename wide_t::serial_t*>(&w); }
+
+
+/// @brief Casts a wide type into its serial components in order to be able to directly access the internal types of the wide type. This is not generally recommended unless you are flushing data out to a serial array.
+///
+/// @param w the input wide type to access.
+///
+/// @returns pointer to the array of serial values that the input wide value is composed of.
+template < typename wide_t > const typename wide_t::serial_t *serialize(const wide_t &w) { return reinterpret_cast<const typename wide_t::serial_t*>(&w); }
+
+/// @brief Loads a wide value from an array of serial values.
+///
+/// @param p pointer to the array of serial values. Does not need to be aligned.
+///
+/// @returns the wide value.
+///
+/// @sa load_aligned
+/// @sa load_masked
+/// @sa store
+template < typename wide_t >
+wide_t load(const typename wide_t::serial_t *p)
+{
+	wide_t o;
+	std::memcpy(static_cast<void*>(&o), p, sizeof(wide_t));
+	return o;
+}
+
+
+/// @brief Loads a wide value from an aligned array of serial values.
+///
+/// @param p pointer to the array of serial values. Must be aligned to the byte size of the wide type.
+///
+/// @returns the wide value.
+///
+/// @sa load
+/// @sa store_aligned
+template < typename wide_t >
+wide_t load_aligned(const typename wide_t::serial_t *p)
+{
+	return cc0::wide::load<wide_t>(p);
+}
+
+
+/// @brief Loads the lanes of a wide value from an array of serial values where the corresponding lane in the mask is true. Memory is not accessed for lanes where the mask is false, which makes it safe to load past the end of an array.
+///
+/// @note Maps to a native masked load with AVX2 for 32 and 64-bit types. Other types, including all types with SSE only, have no masked load instruction and load one lane at a time, so they gain nothing over a serial loop. A full load blended with the mask is not used, since it could read past the end of the array.
+///
+/// @param p pointer to the array of serial values. Does not need to be aligned.
+/// @param mask the lanes to load.
+///
+/// @returns the wide value, where lanes not loaded are zero.
+///
+/// @sa load
+/// @sa store_masked
+/// @sa tail_mask
+template < typename wide_t >
+wide_t load_masked(const typename wide_t::serial_t *p, const wide_bool<wide_t::depth,wide_t::width> &mask)
+{
+	typename wide_t::serial_t v[wide_t::width];
+	typename wide_bool<wide_t::depth,wide_t::width>::serial_t m[wide_t::width];
+	std::memcpy(m, static_cast<const void*>(&mask), sizeof(m));
+	for (uint32_t i = 0; i < wide_t::width; ++i) {
+		v[i] = m[i] ? p[i] : typename wide_t::serial_t(0);
+	}
+	return cc0::wide::load<wide_t>(v);
+}
+
+
+/// @brief Stores a wide value to an array of serial values.
+///
+/// @param p pointer to the array of serial values. Does not need to be aligned.
+/// @param w the wide value.
+///
+/// @sa store_aligned
+/// @sa store_masked
+/// @sa stream_store
+/// @sa load
+template < typename wide_t >
+void store(typename wide_t::serial_t *p, const wide_t &w)
+{
+	std::memcpy(p, static_cast<const void*>(&w), sizeof(wide_t));
+}
+
+
+/// @brief Stores a wide value to an aligned array of serial values.
+///
+/// @param p pointer to the array of serial values. Must be aligned to the byte size of the wide type.
+/// @param w the wide value.
+///
+/// @sa store
+/// @sa load_aligned
+template < typename wide_t >
+void store_aligned(typename wide_t::serial_t *p, const wide_t &w)
+{
+	cc0::wide::store(p, w);
+}
+
+
+/// @brief Stores the lanes of a wide value to an array of serial values where the corresponding lane in the mask is true. Memory is not accessed for lanes where the mask is false, which makes it safe to store past the end of an array.
+///
+/// @note Maps to a native masked store with AVX2 for 32 and 64-bit types. Other types, including all types with SSE only, store one lane at a time, so they gain nothing over a serial loop.
+///
+/// @param p pointer to the array of serial values. Does not need to be aligned.
+/// @param w the wide value.
+/// @param mask the lanes to store.
+///
+/// @sa store
+/// @sa load_masked
+/// @sa tail_mask
+template < typename wide_t >
+void store_masked(typename wide_t::serial_t *p, const wide_t &w, const wide_bool<wide_t::depth,wide_t::width> &mask)
+{
+	typename wide_t::serial_t v[wide_t::width];
+	typename wide_bool<wide_t::depth,wide_t::width>::serial_t m[wide_t::width];
+	std::memcpy(v, static_cast<const void*>(&w), sizeof(v));
+	std::memcpy(m, static_cast<const void*>(&mask), sizeof(m));
+	for (uint32_t i = 0; i < wide_t::width; ++i) {
+		if (m[i]) { p[i] = v[i]; }
+	}
+}
+
+
+/// @brief Stores a wide value to an aligned array of serial values using a non-temporal hint, bypassing the cache where supported. Use for large output buffers that are not read back soon.
+///
+/// @note Call stream_fence after a sequence of streaming stores before the memory is read by another thread.
+///
+/// @param p pointer to the array of serial values. Must be aligned to the byte size of the wide type.
+/// @param w the wide value.
+///
+/// @sa store_aligned
+/// @sa stream_fence
+template < typename wide_t >
+void stream_store(typename wide_t::serial_t *p, const wide_t &w)
+{
+	cc0::wide::store(p, w);
+}
+
+
+/// @brief Orders all preceding streaming stores before any subsequent stores.
+///
+/// @sa stream_store
+inline void stream_fence( void )
+{
+#if defined(CC0_WIDE_NATIVE_SSE2)
+	_mm_sfence();
+#endif
+}
+
+
+/// @brief Returns a mask where the first 'count' lanes are true, and the remaining lanes are false. Use to process the last elements of an array that do not fill an entire wide value.
+///
+/// @param count the number of lanes to set to true.
+///
+/// @returns the mask.
+///
+/// @sa load_masked
+/// @sa store_masked
+template < typename wide_t >
+wide_bool<wide_t::depth,wide_t::width> tail_mask(size_t count)
+{
+	typedef wide_int<wide_t::depth,wide_t::width> index_t;
+	typename index_t::serial_t i[wide_t::width];
+	for (uint32_t n = 0; n < wide_t::width; ++n) { i[n] = typename index_t::serial_t(n); }
+	return index_t(i) < typename index_t::serial_t(count < wide_t::width ? count : wide_t::width);
+}
+
+#define NATIVE_MEMORY(type, D, W, pre) \
+	template <> inline type<D,W> load_aligned< type<D,W> >(const type<D,W>::serial_t *p)   { return type<D,W>(__wide_simd<D,W>::pre##_load(p)); } \
+	template <> inline void store_aligned< type<D,W> >(type<D,W>::serial_t *p, const type<D,W> &w) { __wide_simd<D,W>::pre##_store(p, w.native()); } \
+	template <> inline void stream_store< type<D,W> >(type<D,W>::serial_t *p, const type<D,W> &w)  { __wide_simd<D,W>::pre##_stream(p, w.native()); }
+
+#define NATIVE_MASKED(type, D, W, pre) \
+	template <> inline type<D,W> load_masked< type<D,W> >(const type<D,W>::serial_t *p, const wide_bool<D,W> &mask)      { return type<D,W>(__wide_simd<D,W>::pre##_maskload(p, mask.native())); } \
+	template <> inline void store_masked< type<D,W> >(type<D,W>::serial_t *p, const type<D,W> &w, const wide_bool<D,W> &mask) { __wide_simd<D,W>::pre##_maskstore(p, mask.native(), w.native()); }
+
+#define NATIVE_WITH(...) __VA_ARGS__
+#define NATIVE_WITHOUT(...)
+
+#define NATIVE_LOAD_STORE(D, W, F, M) \
+	NATIVE_MEMORY(wide_bool, D, W, i) \
+	NATIVE_MEMORY(wide_int, D, W, i) \
+	NATIVE_MEMORY(wide_uint, D, W, i) \
+	F(NATIVE_MEMORY(wide_float, D, W, f)) \
+	M(NATIVE_MASKED(wide_bool, D, W, i)) \
+	M(NATIVE_MASKED(wide_int, D, W, i)) \
+	M(NATIVE_MASKED(wide_uint, D, W, i)) \
+	M(F(NATIVE_MASKED(wide_float, D, W, f)))
+
+#if defined(CC0_WIDE_NATIVE_SSE2)
+	NATIVE_LOAD_STORE(8, 16, NATIVE_WITHOUT, NATIVE_WITHOUT)
+	NATIVE_LOAD_STORE(16, 8, NATIVE_WITHOUT, NATIVE_WITHOUT)
+#endif
+#if defined(CC0_WIDE_NATIVE_AVX2)
+	NATIVE_LOAD_STORE(32, 4, NATIVE_WITH, NATIVE_WITH)
+	NATIVE_LOAD_STORE(32, 8, NATIVE_WITH, NATIVE_WITH)
+	NATIVE_LOAD_STORE(64, 4, NATIVE_WITH, NATIVE_WITH)
+#elif defined(CC0_WIDE_NATIVE_SSE4_1)
+	NATIVE_LOAD_STORE(32, 4, NATIVE_WITH, NATIVE_WITHOUT)
+#endif
+
+#undef NATIVE_WITH
+#undef NATIVE_WITHOUT
+#undef NATIVE_MEMORY
+#undef NATIVE_MASKED
+#undef NATIVE_LOAD_STORE
+
+
+/// @brief Loads the lanes of a wide value from arbitrary locations in an array of serial values, so that lane 'i' of the output is 'base[index[i]]'.
+///
+/// @param base pointer to the array of serial values.
+/// @param index the offset into the array for each lane.
+///
+/// @returns the wide value.
+///
+/// @sa scatter
+template < typename wide_t >
+wide_t gather(const typename wide_t::serial_t *base, const wide_int<wide_t::depth,wide_t::width> &index)
+{
+	typename wide_t::serial_t v[wide_t::width];
+	typename wide_int<wide_t::depth,wide_t::width>::serial_t i[wide_t::width];
+	std::memcpy(i, static_cast<const void*>(&index), sizeof(i));
+	for (uint32_t n = 0; n < wide_t::width; ++n) {
+		v[n] = base[i[n]];
+	}
+	return cc0::wide::load<wide_t>(v);
+}
+
+
+/// @brief Loads the lanes of a wide value from arbitrary locations in an array of serial values where the corresponding lane in the mask is true. Memory is not accessed for lanes where the mask is false.
+///
+/// @param base pointer to the array of serial values.
+/// @param index the offset into the array for each lane.
+/// @param mask the lanes to load.
+///
+/// @returns the wide value, where lanes not loaded are zero.
+///
+/// @sa scatter
+template < typename wide_t >
+wide_t gather(const typename wide_t::serial_t *base, const wide_int<wide_t::depth,wide_t::width> &index, const wide_bool<wide_t::depth,wide_t::width> &mask)
+{
+	typename wide_t::serial_t v[wide_t::width];
+	typename wide_int<wide_t::depth,wide_t::width>::serial_t i[wide_t::width];
+	typename wide_bool<wide_t::depth,wide_t::width>::serial_t m[wide_t::width];
+	std::memcpy(i, static_cast<const void*>(&index), sizeof(i));
+	std::memcpy(m, static_cast<const void*>(&mask), sizeof(m));
+	for (uint32_t n = 0; n < wide_t::width; ++n) {
+		v[n] = m[n] ? base[i[n]] : typename wide_t::serial_t(0);
+	}
+	return cc0::wide::load<wide_t>(v);
+}
+
+
+/// @brief Stores the lanes of a wide value to arbitrary locations in an array of serial values, so that 'base[index[i]]' is set to lane 'i' of the value.
+///
+/// @note Lanes are stored in ascending order, so if several lanes share the same index the value of the highest lane is the one that remains in memory.
+///
+/// @param base pointer to the array of serial values.
+/// @param index the offset into the array for each lane.
+/// @param value the wide value.
+///
+/// @sa gather
+template < typename wide_t >
+void scatter(typename wide_t::serial_t *base, const wide_int<wide_t::depth,wide_t::width> &index, const wide_t &value)
+{
+	typename wide_t::serial_t v[wide_t::width];
+	typename wide_int<wide_t::depth,wide_t::width>::serial_t i[wide_t::width];
+	std::memcpy(v, static_cast<const void*>(&value), sizeof(v));
+	std::memcpy(i, static_cast<const void*>(&index), sizeof(i));
+	for (uint32_t n = 0; n < wide_t::width; ++n) {
+		base[i[n]] = v[n];
+	}
+}
+
+
+/// @brief Stores the lanes of a wide value to arbitrary locations in an array of serial values where the corresponding lane in the mask is true. Memory is not accessed for lanes where the mask is false.
+///
+/// @note Lanes are stored in ascending order, so if several active lanes share the same index the value of the highest active lane is the one that remains in memory.
+///
+/// @param base pointer to the array of serial values.
+/// @param index the offset into the array for each lane.
+/// @param value the wide value.
+/// @param mask the lanes to store.
+///
+/// @sa gather
+template < typename wide_t >
+void scatter(typename wide_t::serial_t *base, const wide_int<wide_t::depth,wide_t::width> &index, const wide_t &value, const wide_bool<wide_t::depth,wide_t::width> &mask)
+{
+	typename wide_t::serial_t v[wide_t::width];
+	typename wide_int<wide_t::depth,wide_t::width>::serial_t i[wide_t::width];
+	typename wide_bool<wide_t::depth,wide_t::width>::serial_t m[wide_t::width];
+	std::memcpy(v, static_cast<const void*>(&value), sizeof(v));
+	std::memcpy(i, static_cast<const void*>(&index), sizeof(i));
+	std::memcpy(m, static_cast<const void*>(&mask), sizeof(m));
+	for (uint32_t n = 0; n < wide_t::width; ++n) {
+		if (m[n]) { base[i[n]] = v[n]; }
+	}
+}
+
+#define NATIVE_GATHER(type, D, W, pre) \
+	template <> inline type<D,W> gather< type<D,W> >(const type<D,W>::serial_t *base, const wide_int<D,W> &index)                           { return type<D,W>(__wide_simd<D,W>::pre##_gather(base, index.native())); } \
+	template <> inline type<D,W> gather< type<D,W> >(const type<D,W>::serial_t *base, const wide_int<D,W> &index, const wide_bool<D,W> &mask) { return type<D,W>(__wide_simd<D,W>::pre##_mgather(base, index.native(), mask.native())); }
+
+#define NATIVE_GATHERS(D, W) \
+	NATIVE_GATHER(wide_int, D, W, i) \
+	NATIVE_GATHER(wide_uint, D, W, i) \
+	NATIVE_GATHER(wide_float, D, W, f)
+
+#if defined(CC0_WIDE_NATIVE_AVX2)
+	NATIVE_GATHERS(32, 4)
+	NATIVE_GATHERS(32, 8)
+	NATIVE_GATHERS(64, 4)
+#endif
+
+#undef NATIVE_GATHER
+#undef NATIVE_GATHERS
+
+
+/// @brief Maps a serial type to the wide type with the same depth at the given width.
+template < typename serial_t, uint32_t Width >
+struct __wide_of
+{
+	typedef typename std::remove_const<serial_t>::type                                 base_t;
+	typedef typename std::conditional<
+		std::is_floating_point<base_t>::value,
+		wide_float<uint32_t(sizeof(base_t) * 8),Width>,
+		typename std::conditional<
+			std::is_signed<base_t>::value,
+			wide_int<uint32_t(sizeof(base_t) * 8),Width>,
+			wide_uint<uint32_t(sizeof(base_t) * 8),Width>
+		>::type
+	>::type type;
+};
+
+
+/// @brief Loads 'count' elements starting at 'p' into a wide value, where the remaining lanes repeat the last element so that inactive lanes never hold values the active lanes could not have held (e.g. zero divisors).
+template < uint32_t Width, typename serial_t >
+typename __wide_of<serial_t,Width>::type __wide_load_partial(const serial_t *p, size_t count)
+{
+	typename __wide_of<serial_t,Width>::base_t v[Width];
+	for (uint32_t i = 0; i < Width; ++i) { v[i] = p[i < count ? i : count - 1]; }
+	return cc0::wide::load<typename __wide_of<serial_t,Width>::type>(v);
+}
+
+
+/// @brief Returns the number of elements to process before 'p' is aligned to the byte size of the wide type, capped at 'count'.
+template < typename wide_t >
+size_t __wide_head(const typename wide_t::serial_t *p, size_t count)
+{
+	const size_t misalignment = size_t(reinterpret_cast<uintptr_t>(p) & (sizeof(wide_t) - 1));
+	const size_t head         = misalignment == 0 ? 0 : (sizeof(wide_t) - misalignment) / sizeof(typename wide_t::serial_t);
+	return head < count ? head : count;
+}
+
+
+/// @brief Applies a wide function to a number of serial input arrays and stores the result in a serial output array, one block of 'Width' elements at a time.
+///
+/// @note The function is called as 'func(mask, in...)', where 'mask' is a wide_bool with the same depth as the output, and every input is passed as the wide type matching its serial type (e.g. 'float' becomes 'wide_float<32,Width>'). The function must return a value convertible to the wide output type. Name the first parameter 'mask' to use CC0_WIDE_IF and the related macros inside the function.
+///
+/// @note Elements before the output array is aligned to the byte size of the wide type and elements after the last full block are processed in a single masked iteration each. In those iterations, lanes outside the array are false in 'mask', are filled with a copy of the last element in the array, and are never written. The main loop is unrolled and uses aligned stores.
+///
+/// @note The output array may be the same as one of the input arrays, but may not otherwise overlap any of the input arrays.
+///
+/// @param count the number of elements in each array.
+/// @param func the function to apply.
+/// @param out the output array.
+/// @param in the input arrays.
+///
+/// @sa for_each
+template < uint32_t Width, typename func_t, typename out_serial_t, typename... in_serial_t >
+void transform(size_t count, func_t func, out_serial_t *out, const in_serial_t*... in)
+{
+	typedef typename __wide_of<out_serial_t,Width>::type out_t;
+	typedef wide_bool<out_t::depth,Width>                mask_t;
+
+	const mask_t all = mask_t(true);
+	size_t       i   = __wide_head<out_t>(out, count);
+	if (i > 0) {
+		cc0::wide::store_masked(out, out_t(func(tail_mask<out_t>(i), __wide_load_partial<Width>(in, i)...)), tail_mask<out_t>(i));
+	}
+	for (; i + 4 * Width <= count; i += 4 * Width) {
+		cc0::wide::store_aligned(out + i,             out_t(func(all, cc0::wide::load<typename __wide_of<in_serial_t,Width>::type>(in + i)...)));
+		cc0::wide::store_aligned(out + i + Width,     out_t(func(all, cc0::wide::load<typename __wide_of<in_serial_t,Width>::type>(in + i + Width)...)));
+		cc0::wide::store_aligned(out + i + 2 * Width, out_t(func(all, cc0::wide::load<typename __wide_of<in_serial_t,Width>::type>(in + i + 2 * Width)...)));
+		cc0::wide::store_aligned(out + i + 3 * Width, out_t(func(all, cc0::wide::load<typename __wide_of<in_serial_t,Width>::type>(in + i + 3 * Width)...)));
+	}
+	for (; i + Width <= count; i += Width) {
+		cc0::wide::store_aligned(out + i, out_t(func(all, cc0::wide::load<typename __wide_of<in_serial_t,Width>::type>(in + i)...)));
+	}
+	if (i < count) {
+		const mask_t tail = tail_mask<out_t>(count - i);
+		cc0::wide::store_masked(out + i, out_t(func(tail, __wide_load_partial<Width>(in + i, count - i)...)), tail);
+	}
+}
+
+
+/// @brief Applies a wide function to a number of serial input arrays, one block of 'Width' elements at a time. Use to compute reductions by accumulating into wide variables captured by the function.
+///
+/// @note The function is called as 'func(mask, in...)', where 'mask' is a wide_bool with the same depth as the first input, and every input is passed as the wide type matching its serial type. Name the first parameter 'mask' to use CC0_WIDE_IF and CC0_WIDE_SET inside the function.
+///
+/// @note Elements after the last full block are processed in a single masked iteration. In that iteration, lanes outside the arrays are false in 'mask' and are filled with a copy of the last element in the array. The function must use 'mask' to exclude those lanes from its results.
+///
+/// @param count the number of elements in each array.
+/// @param func the function to apply.
+/// @param first the first input array.
+/// @param in the remaining input arrays.
+///
+/// @sa transform
+template < uint32_t Width, typename func_t, typename first_serial_t, typename... in_serial_t >
+void for_each(size_t count, func_t func, const first_serial_t *first, const in_serial_t*... in)
+{
+	typedef typename __wide_of<first_serial_t,Width>::type first_t;
+	typedef wide_bool<first_t::depth,Width>                mask_t;
+
+	const mask_t all = mask_t(true);
+	size_t       i   = 0;
+	for (; i + 4 * Width <= count; i += 4 * Width) {
+		func(all, cc0::wide::load<first_t>(first + i),             cc0::wide::load<typename __wide_of<in_serial_t,Width>::type>(in + i)...);
+		func(all, cc0::wide::load<first_t>(first + i + Width),     cc0::wide::load<typename __wide_of<in_serial_t,Width>::type>(in + i + Width)...);
+		func(all, cc0::wide::load<first_t>(first + i + 2 * Width), cc0::wide::load<typename __wide_of<in_serial_t,Width>::type>(in + i + 2 * Width)...);
+		func(all, cc0::wide::load<first_t>(first + i + 3 * Width), cc0::wide::load<typename __wide_of<in_serial_t,Width>::type>(in + i + 3 * Width)...);
+	}
+	for (; i + Width <= count; i += Width) {
+		func(all, cc0::wide::load<first_t>(first + i), cc0::wide::load<typename __wide_of<in_serial_t,Width>::type>(in + i)...);
+	}
+	if (i < count) {
+		func(tail_mask<first_t>(count - i), __wide_load_partial<Width>(first + i, count - i), __wide_load_partial<Width>(in + i, count - i)...);
+	}
+}
+
+
+/// @brief Moves lanes of a wide value so that lane 'i' of the output is lane 'index[i]' of the input.
+///
+/// @note Only the lowest bits of each index needed to address a lane are used, i.e. indices wrap around the width of the wide type.
+///
+/// @param a the wide value.
+/// @param index the input lane for each output lane.
+///
+/// @returns the permuted wide value.
+///
+/// @sa shuffle
+template < typename wide_t >
+wide_t permute(const wide_t &a, const wide_int<wide_t::depth,wide_t::width> &index)
+{
+	typename wide_t::serial_t v[wide_t::width];
+	typename wide_t::serial_t o[wide_t::width];
+	typename wide_int<wide_t::depth,wide_t::width>::serial_t i[wide_t::width];
+	std::memcpy(v, static_cast<const void*>(&a), sizeof(v));
+	std::memcpy(i, static_cast<const void*>(&index), sizeof(i));
+	for (uint32_t n = 0; n < wide_t::width; ++n) {
+		o[n] = v[uint32_t(i[n]) & (wide_t::width - 1)];
+	}
+	return cc0::wide::load<wide_t>(o);
+}
+
+
+/// @brief Interleaves the lanes in the lower halves of two wide values, i.e. [a0, b0, a1, b1, ...].
+///
+/// @param a the first wide value.
+/// @param b the second wide value.
+///
+/// @returns the interleaved wide value.
+///
+/// @sa interleave_hi
+template < typename wide_t >
+wide_t interleave_lo(const wide_t &a, const wide_t &b)
+{
+	typename wide_t::serial_t x[wide_t::width];
+	typename wide_t::serial_t y[wide_t::width];
+	typename wide_t::serial_t o[wide_t::width];
+	std::memcpy(x, static_cast<const void*>(&a), sizeof(x));
+	std::memcpy(y, static_cast<const void*>(&b), sizeof(y));
+	for (uint32_t n = 0; n < wide_t::width / 2; ++n) {
+		o[2 * n]     = x[n];
+		o[2 * n + 1] = y[n];
+	}
+	return cc0::wide::load<wide_t>(o);
+}
+
+
+/// @brief Interleaves the lanes in the upper halves of two wide values, i.e. [a(W/2), b(W/2), a(W/2+1), b(W/2+1), ...].
+///
+/// @param a the first wide value.
+/// @param b the second wide value.
+///
+/// @returns the interleaved wide value.
+///
+/// @sa interleave_lo
+template < typename wide_t >
+wide_t interleave_hi(const wide_t &a, const wide_t &b)
+{
+	typename wide_t::serial_t x[wide_t::width];
+	typename wide_t::serial_t y[wide_t::width];
+	typename wide_t::serial_t o[wide_t::width];
+	std::memcpy(x, static_cast<const void*>(&a), sizeof(x));
+	std::memcpy(y, static_cast<const void*>(&b), sizeof(y));
+	for (uint32_t n = 0; n < wide_t::width / 2; ++n) {
+		o[2 * n]     = x[wide_t::width / 2 + n];
+		o[2 * n + 1] = y[wide_t::width / 2 + n];
+	}
+	return cc0::wide::load<wide_t>(o);
+}
+
+#define NATIVE_LANES(type, D, W, M) \
+	inline type<D,W> interleave_lo(const type<D,W> &a, const type<D,W> &b) { return type<D,W>(__wide_simd<D,W>::i_interleave_lo(a.native(), b.native())); } \
+	inline type<D,W> interleave_hi(const type<D,W> &a, const type<D,W> &b) { return type<D,W>(__wide_simd<D,W>::i_interleave_hi(a.native(), b.native())); } \
+	M(inline type<D,W> permute(const type<D,W> &a, const wide_int<D,W> &index) { return type<D,W>(__wide_simd<D,W>::i_permute(a.native(), index.native())); })
+
+#define NATIVE_FLOAT_LANES(D, W) \
+	inline wide_float<D,W> interleave_lo(const wide_float<D,W> &a, const wide_float<D,W> &b) { typedef __wide_simd<D,W> simd; return wide_float<D,W>(simd::f_cast(simd::i_interleave_lo(simd::f_bits(a.native()), simd::f_bits(b.native())))); } \
+	inline wide_float<D,W> interleave_hi(const wide_float<D,W> &a, const wide_float<D,W> &b) { typedef __wide_simd<D,W> simd; return wide_float<D,W>(simd::f_cast(simd::i_interleave_hi(simd::f_bits(a.native()), simd::f_bits(b.native())))); } \
+	inline wide_float<D,W> permute(const wide_float<D,W> &a, const wide_int<D,W> &index)       { typedef __wide_simd<D,W> simd; return wide_float<D,W>(simd::f_cast(simd::i_permute(simd::f_bits(a.native()), index.native()))); }
+
+#define NATIVE_WITH(...) __VA_ARGS__
+#define NATIVE_WITHOUT(...)
+
+#define NATIVE_SHAPE_LANES(D, W, M) \
+	NATIVE_LANES(wide_int, D, W, M) \
+	NATIVE_LANES(wide_uint, D, W, M)
+
+#if defined(CC0_WIDE_NATIVE_SSE4_1)
+	NATIVE_SHAPE_LANES(8, 16, NATIVE_WITH)
+	NATIVE_SHAPE_LANES(16, 8, NATIVE_WITH)
+	NATIVE_SHAPE_LANES(32, 4, NATIVE_WITH)
+	NATIVE_FLOAT_LANES(32, 4)
+#elif defined(CC0_WIDE_NATIVE_SSE2)
+	NATIVE_SHAPE_LANES(8, 16, NATIVE_WITHOUT)
+	NATIVE_SHAPE_LANES(16, 8, NATIVE_WITHOUT)
+#endif
+#if defined(CC0_WIDE_NATIVE_AVX2)
+	NATIVE_SHAPE_LANES(32, 8, NATIVE_WITH)
+	NATIVE_SHAPE_LANES(64, 4, NATIVE_WITH)
+	NATIVE_FLOAT_LANES(32, 8)
+	NATIVE_FLOAT_LANES(64, 4)
+#endif
+
+#undef NATIVE_WITH
+#undef NATIVE_WITHOUT
+#undef NATIVE_LANES
+#undef NATIVE_FLOAT_LANES
+#undef NATIVE_SHAPE_LANES
+
+
+/// @brief Returns true if all values are less than a limit.
+constexpr bool __wide_all_less(uint32_t) { return true; }
+template < typename... rest_t >
+constexpr bool __wide_all_less(uint32_t limit, uint32_t first, rest_t... rest) { return first < limit && __wide_all_less(limit, rest...); }
+
+
+/// @brief Moves lanes of a wide value according to indices known at compile time, so that lane 'i' of the output is lane 'Indices[i]' of the input.
+///
+/// @note Example: shuffle<3,2,1,0>(a) reverses the lanes of a wide value with a width of 4.
+///
+/// @param Indices the input lane for each output lane. The number of indices must equal the width of the wide type.
+/// @param a the wide value.
+///
+/// @returns the shuffled wide value.
+///
+/// @sa permute
+template < uint32_t... Indices, typename wide_t >
+wide_t shuffle(const wide_t &a)
+{
+	static_assert(sizeof...(Indices) == wide_t::width, "The number of indices must equal the width of the wide type");
+	static_assert(__wide_all_less(wide_t::width, Indices...), "Lane index out of range");
+	typedef wide_int<wide_t::depth,wide_t::width> index_t;
+	const typename index_t::serial_t i[] = { typename index_t::serial_t(Indices)... };
+	return permute(a, cc0::wide::load<index_t>(i));
+}
+
+
+/// @brief Rotates the lanes of a wide value, so that lane 'i' of the output is lane '(i + N) mod width' of the input.
+///
+/// @param N the number of lanes to rotate by. May be negative.
+/// @param a the wide value.
+///
+/// @returns the rotated wide value.
+///
+/// @sa shift_lanes
+template < int32_t N, typename wide_t >
+wide_t rotate_lanes(const wide_t &a)
+{
+	typedef wide_int<wide_t::depth,wide_t::width> index_t;
+	typename index_t::serial_t i[wide_t::width];
+	for (uint32_t n = 0; n < wide_t::width; ++n) {
+		i[n] = typename index_t::serial_t(uint32_t(int32_t(n) + N) & (wide_t::width - 1));
+	}
+	return permute(a, cc0::wide::load<index_t>(i));
+}
+
+
+/// @brief Shifts the lanes of a wide value, so that lane 'i' of the output is lane 'i + N' of the input, or zero if 'i + N' is outside of the wide value.
+///
+/// @param N the number of lanes to shift by. May be negative.
+/// @param a the wide value.
+///
+/// @returns the shifted wide value.
+///
+/// @sa rotate_lanes
+template < int32_t N, typename wide_t >
+wide_t shift_lanes(const wide_t &a)
+{
+	typedef wide_int<wide_t::depth,wide_t::width> index_t;
+	typename index_t::serial_t i[wide_t::width];
+	typename wide_t::serial_t  z[wide_t::width];
+	for (uint32_t n = 0; n < wide_t::width; ++n) {
+		i[n] = typename index_t::serial_t(int32_t(n) + N);
+		z[n] = typename wide_t::serial_t(0);
+	}
+	const index_t from = cc0::wide::load<index_t>(i);
+	return cmov((from >= typename index_t::serial_t(0)) & (from < typename index_t::serial_t(wide_t::width)), permute(a, from), cc0::wide::load<wide_t>(z));
+}
+
+
+/// @brief Transposes a square matrix of wide values in place, so that lane 'j' of row 'i' swaps places with lane 'i' of row 'j'. Implemented as a sequence of interleaves, so the native backends transpose 4x4 and 8x8 blocks without leaving registers.
+///
+/// @param m the rows of the matrix. The number of rows must equal the width of the wide type.
+template < typename wide_t, size_t N >
+void transpose(wide_t (&m)[N])
+{
+	static_assert(N == wide_t::width, "The number of rows must equal the width of the wide type");
+	wide_t t[N];
+	for (uint32_t step = 1; step < N; step *= 2) {
+		for (uint32_t n = 0; n < N / 2; ++n) {
+			t[2 * n]     = interleave_lo(m[n], m[n + N / 2]);
+			t[2 * n + 1] = interleave_hi(m[n], m[n + N / 2]);
+		}
+		for (uint32_t n = 0; n < N; ++n) {
+			m[n] = t[n];
+		}
+	}
+}
+
+
+/// @brief Builds the gather/scatter offsets of the first field in each of 'width' records with N fields each.
+template < typename wide_t, size_t N >
+wide_int<wide_t::depth,wide_t::width> __wide_aos_index( void )
+{
+	typedef wide_int<wide_t::depth,wide_t::width> index_t;
+	typename index_t::serial_t i[wide_t::width];
+	for (uint32_t n = 0; n < wide_t::width; ++n) {
+		i[n] = typename index_t::serial_t(n * N);
+	}
+	return cc0::wide::load<index_t>(i);
+}
+
+template < typename wide_t, size_t N >
+void __wide_load_aos(const typename wide_t::serial_t *records, wide_t (&fields)[N], std::true_type)
+{
+	for (uint32_t f = 0; f < N; ++f) {
+		fields[f] = cc0::wide::load<wide_t>(records + f * N);
+	}
+	transpose(fields);
+}
+
+template < typename wide_t, size_t N >
+void __wide_load_aos(const typename wide_t::serial_t *records, wide_t (&fields)[N], std::false_type)
+{
+	const wide_int<wide_t::depth,wide_t::width> index = __wide_aos_index<wide_t,N>();
+	for (uint32_t f = 0; f < N; ++f) {
+		fields[f] = gather<wide_t>(records + f, index);
+	}
+}
+
+template < typename wide_t, size_t N >
+void __wide_store_aos(typename wide_t::serial_t *records, const wide_t (&fields)[N], std::true_type)
+{
+	wide_t rows[N];
+	for (uint32_t f = 0; f < N; ++f) {
+		rows[f] = fields[f];
+	}
+	transpose(rows);
+	for (uint32_t r = 0; r < N; ++r) {
+		cc0::wide::store(records + r * N, rows[r]);
+	}
+}
+
+template < typename wide_t, size_t N >
+void __wide_store_aos(typename wide_t::serial_t *records, const wide_t (&fields)[N], std::false_type)
+{
+	const wide_int<wide_t::depth,wide_t::width> index = __wide_aos_index<wide_t,N>();
+	for (uint32_t f = 0; f < N; ++f) {
+		scatter(records + f, index, fields[f]);
+	}
+}
+
+
+/// @brief Loads an array of records with N fields each (array of structures) into N wide values with one field each (structure of arrays), so that lane 'i' of 'fields[f]' is field 'f' of record 'i'.
+///
+/// @note When the number of fields equals the width of the wide type the records are loaded as rows and transposed. Otherwise the fields are gathered.
+///
+/// @param records pointer to the first field of the first record. Must hold 'width' records.
+/// @param fields the wide values to load the fields into.
+///
+/// @sa store_aos
+/// @sa transpose
+template < typename wide_t, size_t N >
+void load_aos(const typename wide_t::serial_t *records, wide_t (&fields)[N])
+{
+	__wide_load_aos(records, fields, std::integral_constant<bool, N == wide_t::width>());
+}
+
+
+/// @brief Stores N wide values with one field each (structure of arrays) to an array of records with N fields each (array of structures), so that field 'f' of record 'i' is lane 'i' of 'fields[f]'.
+///
+/// @note When the number of fields equals the width of the wide type the fields are transposed and stored as rows. Otherwise the fields are scattered.
+///
+/// @param records pointer to the first field of the first record. Must hold 'width' records.
+/// @param fields the wide values to store the fields from.
+///
+/// @sa load_aos
+/// @sa transpose
+template < typename wide_t, size_t N >
+void store_aos(typename wide_t::serial_t *records, const wide_t (&fields)[N])
+{
+	__wide_store_aos(records, fields, std::integral_constant<bool, N == wide_t::width>());
+}
+
+
+/// @brief Computes 'a * b + c'. Rounds only once on native backends with FMA support, and computes a separate multiply and add elsewhere.
+///
+/// @param a the first factor.
+/// @param b the second factor.
+/// @param c the term.
+///
+/// @returns the result.
+///
+/// @sa fms
+/// @sa fnma
+template < uint32_t Depth, uint32_t Width >
+wide_float<Depth,Width> fma(const wide_float<Depth,Width> &a, const wide_float<Depth,Width> &b, const wide_float<Depth,Width> &c)
+{
+	return a * b + c;
+}
+
+
+/// @brief Computes 'a * b - c'. Rounds only once on native backends with FMA support, and computes a separate multiply and subtract elsewhere.
+///
+/// @param a the first factor.
+/// @param b the second factor.
+/// @param c the term.
+///
+/// @returns the result.
+///
+/// @sa fma
+/// @sa fnma
+template < uint32_t Depth, uint32_t Width >
+wide_float<Depth,Width> fms(const wide_float<Depth,Width> &a, const wide_float<Depth,Width> &b, const wide_float<Depth,Width> &c)
+{
+	return a * b - c;
+}
+
+
+/// @brief Computes 'c - a * b'. Rounds only once on native backends with FMA support, and computes a separate multiply and subtract elsewhere.
+///
+/// @param a the first factor.
+/// @param b the second factor.
+/// @param c the term.
+///
+/// @returns the result.
+///
+/// @sa fma
+/// @sa fms
+template < uint32_t Depth, uint32_t Width >
+wide_float<Depth,Width> fnma(const wide_float<Depth,Width> &a, const wide_float<Depth,Width> &b, const wide_float<Depth,Width> &c)
+{
+	return c - a * b;
+}
+
+
+/// @brief Returns an approximation of '1 / x'.
+///
+/// @note The relative error is at most 1.5 * 2^-12 for 32-bit native types. Other types compute the exact reciprocal.
+///
+/// @param x the value.
+///
+/// @returns the approximate reciprocal.
+///
+/// @sa rcp
+template < uint32_t Depth, uint32_t Width >
+wide_float<Depth,Width> rcp_approx(const wide_float<Depth,Width> &x)
+{
+	return wide_float<Depth,Width>(typename wide_float<Depth,Width>::serial_t(1)) / x;
+}
+
+
+/// @brief Returns an approximation of '1 / sqrt(x)'. Negative values return NaN.
+///
+/// @note The relative error is at most 1.5 * 2^-12 for 32-bit native types. Other types compute the exact reciprocal square root.
+///
+/// @param x the value.
+///
+/// @returns the approximate reciprocal square root.
+///
+/// @sa rsqrt
+template < uint32_t Depth, uint32_t Width >
+wide_float<Depth,Width> rsqrt_approx(const wide_float<Depth,Width> &x)
+{
+	typename wide_float<Depth,Width>::serial_t v[Width];
+	std::memcpy(v, static_cast<const void*>(&x), sizeof(v));
+	for (uint32_t i = 0; i < Width; ++i) {
+		v[i] = typename wide_float<Depth,Width>::serial_t(1) / std::sqrt(v[i]);
+	}
+	return cc0::wide::load< wide_float<Depth,Width> >(v);
+}
+
+
+/// @brief Returns '1 / x'.
+///
+/// @note 32-bit native types refine rcp_approx with one Newton-Raphson step, giving a relative error of at most 2^-22, i.e. within two units in the last place. Other types compute the exact reciprocal.
+///
+/// @param x the value.
+///
+/// @returns the reciprocal.
+///
+/// @sa rcp_approx
+template < uint32_t Depth, uint32_t Width >
+wide_float<Depth,Width> rcp(const wide_float<Depth,Width> &x)
+{
+	return cc0::wide::rcp_approx(x);
+}
+
+
+/// @brief Returns '1 / sqrt(x)'. Negative values return NaN.
+///
+/// @note 32-bit native types refine rsqrt_approx with one Newton-Raphson step, giving a relative error of at most 2^-22, i.e. within two units in the last place. Other types compute the exact reciprocal square root.
+///
+/// @param x the value.
+///
+/// @returns the reciprocal square root.
+///
+/// @sa rsqrt_approx
+template < uint32_t Depth, uint32_t Width >
+wide_float<Depth,Width> rsqrt(const wide_float<Depth,Width> &x)
+{
+	return cc0::wide::rsqrt_approx(x);
+}
+
+
+/// @brief Returns the square root of the input. Negative values return NaN.
+///
+/// @note Native types use the hardware square root instruction, and other types compute the square root of each lane, so the latency is fixed and the result is correctly rounded.
+///
+/// @param x the value.
+///
+/// @returns the square root.
+///
+/// @sa rsqrt
+template < uint32_t Depth, uint32_t Width >
+wide_float<Depth,Width> sqrt(const wide_float<Depth,Width> &x)
+{
+	typename wide_float<Depth,Width>::serial_t v[Width];
+	std::memcpy(v, static_cast<const void*>(&x), sizeof(v));
+	for (uint32_t i = 0; i < Width; ++i) {
+		v[i] = std::sqrt(v[i]);
+	}
+	return cc0::wide::load< wide_float<Depth,Width> >(v);
+}
+
+#define NATIVE_FUSED(D, W) \
+	inline wide_float<D,W> fma(const wide_float<D,W> &a, const wide_float<D,W> &b, const wide_float<D,W> &c)  { return wide_float<D,W>(__wide_simd<D,W>::f_fmadd(a.native(), b.native(), c.native())); } \
+	inline wide_float<D,W> fms(const wide_float<D,W> &a, const wide_float<D,W> &b, const wide_float<D,W> &c)  { return wide_float<D,W>(__wide_simd<D,W>::f_fmsub(a.native(), b.native(), c.native())); } \
+	inline wide_float<D,W> fnma(const wide_float<D,W> &a, const wide_float<D,W> &b, const wide_float<D,W> &c) { return wide_float<D,W>(__wide_simd<D,W>::f_fnmadd(a.native(), b.native(), c.native())); }
+
+// Zero, infinite, and NaN approximations are already exact, but would turn into NaN when refined.
+#define NATIVE_APPROX(D, W) \
+	inline wide_float<D,W> rcp_approx(const wide_float<D,W> &x)   { return wide_float<D,W>(__wide_simd<D,W>::f_rcp(x.native())); } \
+	inline wide_float<D,W> rsqrt_approx(const wide_float<D,W> &x) { return wide_float<D,W>(__wide_simd<D,W>::f_rsqrt(x.native())); } \
+	inline wide_float<D,W> rcp(const wide_float<D,W> &x) \
+	{ \
+		const wide_float<D,W> r = rcp_approx(x); \
+		const wide_float<D,W> n = fma(r, fnma(x, r, wide_float<D,W>(1.0f)), r); \
+		return cmov((r == 0.0f) | (r - r != 0.0f), r, n); \
+	} \
+	inline wide_float<D,W> rsqrt(const wide_float<D,W> &x) \
+	{ \
+		const wide_float<D,W> r = rsqrt_approx(x); \
+		const wide_float<D,W> h = x * r * 0.5f; \
+		const wide_float<D,W> n = fma(r, fnma(h, r, wide_float<D,W>(0.5f)), r); \
+		return cmov((r == 0.0f) | (r - r != 0.0f), r, n); \
+	}
+
+#define NATIVE_SQRT(D, W) \
+	inline wide_float<D,W> sqrt(const wide_float<D,W> &x) { return wide_float<D,W>(__wide_simd<D,W>::f_sqrt(x.native())); }
+
+#if defined(CC0_WIDE_NATIVE_SSE4_1)
+	NATIVE_FUSED(32, 4)
+	NATIVE_APPROX(32, 4)
+	NATIVE_SQRT(32, 4)
+#endif
+#if defined(CC0_WIDE_NATIVE_AVX2)
+	NATIVE_FUSED(32, 8)
+	NATIVE_FUSED(64, 4)
+	NATIVE_APPROX(32, 8)
+	NATIVE_SQRT(32, 8)
+	NATIVE_SQRT(64, 4)
+#endif
+
+#undef NATIVE_FUSED
+#undef NATIVE_APPROX
+#undef NATIVE_SQRT
+
+
+/// @brief Returns the upper half of the full product of each lane, i.e. '(a * b) >> Depth' computed without overflow.
+///
+/// @param a the first factor.
+/// @param b the second factor.
+///
+/// @returns the upper half of the products.
+template < uint32_t Depth, uint32_t Width >
+wide_int<Depth,Width> mulhi(const wide_int<Depth,Width> &a, const wide_int<Depth,Width> &b)
+{
+	typename wide_int<Depth,Width>::serial_t x[Width], y[Width];
+	std::memcpy(x, static_cast<const void*>(&a), sizeof(x));
+	std::memcpy(y, static_cast<const void*>(&b), sizeof(y));
+	for (uint32_t i = 0; i < Width; ++i) {
+		x[i] = __wide_mulhi(x[i], y[i]);
+	}
+	return cc0::wide::load< wide_int<Depth,Width> >(x);
+}
+
+
+/// @brief Returns the upper half of the full product of each lane, i.e. '(a * b) >> Depth' computed without overflow.
+///
+/// @param a the first factor.
+/// @param b the second factor.
+///
+/// @returns the upper half of the products.
+template < uint32_t Depth, uint32_t Width >
+wide_uint<Depth,Width> mulhi(const wide_uint<Depth,Width> &a, const wide_uint<Depth,Width> &b)
+{
+	typename wide_uint<Depth,Width>::serial_t x[Width], y[Width];
+	std::memcpy(x, static_cast<const void*>(&a), sizeof(x));
+	std::memcpy(y, static_cast<const void*>(&b), sizeof(y));
+	for (uint32_t i = 0; i < Width; ++i) {
+		x[i] = __wide_mulhi(x[i], y[i]);
+	}
+	return cc0::wide::load< wide_uint<Depth,Width> >(x);
+}
+
+#define NATIVE_MULHI(D, W) \
+	inline wide_int<D,W>  mulhi(const wide_int<D,W> &a, const wide_int<D,W> &b)   { return wide_int<D,W>(__wide_simd<D,W>::i_mulhi(a.native(), b.native())); } \
+	inline wide_uint<D,W> mulhi(const wide_uint<D,W> &a, const wide_uint<D,W> &b) { return wide_uint<D,W>(__wide_simd<D,W>::u_mulhi(a.native(), b.native())); }
+
+#if defined(CC0_WIDE_NATIVE_SSE2)
+	NATIVE_MULHI(8, 16)
+	NATIVE_MULHI(16, 8)
+#endif
+#if defined(CC0_WIDE_NATIVE_SSE4_1)
+	NATIVE_MULHI(32, 4)
+#endif
+#if defined(CC0_WIDE_NATIVE_AVX2)
+	NATIVE_MULHI(32, 8)
+	NATIVE_MULHI(64, 4)
+#endif
+
+#undef NATIVE_MULHI
+
+
+/// @brief Returns the index of the highest set bit of a non-zero integer.
+inline uint32_t __wide_floor_log2(uint64_t x)
+{
+	uint32_t l = 0;
+	while (x >>= 1) { ++l; }
+	return l;
+}
+
+
+/// @brief Returns 'floor((hi * 2^bits + lo) / d)' truncated to 'bits' bits, where 'hi' is less than 'd', and stores the remainder.
+inline uint64_t __wide_udiv_long(uint64_t hi, uint64_t lo, uint64_t d, uint32_t bits, uint64_t &rem)
+{
+	uint64_t q = 0;
+	for (uint32_t i = bits; i-- > 0; ) {
+		// 'hi' may carry out of 64 bits, in which case it is known to be greater than 'd'.
+		const bool carry = (hi >> 63) != 0;
+		hi = (hi << 1) | ((lo >> i) & 1);
+		q <<= 1;
+		if (carry || hi >= d) {
+			hi -= d;
+			q |= 1;
+		}
+	}
+	rem = hi;
+	return q;
+}
+
+
+/// @brief Divides wide integers by a divisor that stays fixed at run time, replacing the per-lane division with a multiplication and shifts.
+///
+/// @note Precomputes a magic multiplier and shift for the divisor (see Granlund and Montgomery, "Division by Invariant Integers using Multiplication"), so it is worthwhile when many values are divided by the same divisor. Powers of two only use shifts and masks. Results round towards zero, like the built-in division. The divisor must not be zero.
+///
+/// @sa operator/
+/// @sa operator%
+template < typename wide_t >
+class divider;
+
+
+/// @brief Divides unsigned wide integers by a fixed divisor.
+template < uint32_t Depth, uint32_t Width >
+class divider< wide_uint<Depth,Width> >
+{
+public:
+	typedef wide_uint<Depth,Width>    wide_t;
+	typedef typename wide_t::serial_t serial_t;
+
+private:
+	serial_t d;
+	serial_t magic;
+	serial_t shift;
+	bool     add;  // The magic number needs one bit more than 'Depth', which is added back by an extra addition.
+	bool     pow2;
+
+public:
+	explicit divider(serial_t divisor) : d(divisor), magic(0), shift(serial_t(__wide_floor_log2(divisor))), add(false), pow2((divisor & (divisor - 1)) == 0)
+	{
+		if (pow2) {
+			return;
+		}
+		uint64_t rem;
+		uint64_t m = __wide_udiv_long(uint64_t(1) << shift, 0, d, Depth, rem);
+		if (d - rem >= (uint64_t(1) << shift)) {
+			m += m;
+			const uint64_t twice_rem = rem + rem;
+			if (twice_rem >= d || twice_rem < rem) {
+				m += 1;
+			}
+			add = true;
+		}
+		magic = serial_t(m + 1);
+	}
+
+	wide_t divide(const wide_t &x) const
+	{
+		if (pow2) {
+			return x >> shift;
+		}
+		const wide_t q = cc0::wide::mulhi(x, wide_t(magic));
+		return add ? (((x - q) >> serial_t(1)) + q) >> shift : q >> shift;
+	}
+
+	wide_t remainder(const wide_t &x) const
+	{
+		return pow2 ? x & serial_t(d - 1) : x - divide(x) * d;
+	}
+
+	serial_t divisor( void ) const { return d; }
+};
+
+
+/// @brief Divides signed wide integers by a fixed divisor.
+template < uint32_t Depth, uint32_t Width >
+class divider< wide_int<Depth,Width> >
+{
+public:
+	typedef wide_int<Depth,Width>     wide_t;
+	typedef typename wide_t::serial_t serial_t;
+
+private:
+	typedef typename wide_uint<Depth,Width>::serial_t userial_t;
+
+	serial_t d;
+	serial_t magic;
+	serial_t shift;
+	bool     add;  // The magic number needs one bit more than 'Depth', which is added back by an extra addition.
+	bool     pow2;
+	bool     negative;
+
+public:
+	explicit divider(serial_t divisor) : d(divisor), magic(0), shift(0), add(false), pow2(false), negative(divisor < 0)
+	{
+		const userial_t ad = negative ? userial_t(userial_t(0) - userial_t(divisor)) : userial_t(divisor);
+		const uint32_t  l  = __wide_floor_log2(ad);
+		pow2 = (ad & (ad - 1)) == 0;
+		if (pow2) {
+			shift = serial_t(l);
+			return;
+		}
+		uint64_t rem;
+		uint64_t m = __wide_udiv_long(uint64_t(1) << (l - 1), 0, ad, Depth, rem);
+		if (ad - rem < (uint64_t(1) << l)) {
+			shift = serial_t(l - 1);
+		} else {
+			m += m;
+			const uint64_t twice_rem = rem + rem;
+			if (twice_rem >= ad || twice_rem < rem) {
+				m += 1;
+			}
+			shift = serial_t(l);
+			add   = true;
+		}
+		const userial_t um = userial_t(m + 1);
+		magic = serial_t(negative ? userial_t(userial_t(0) - um) : um);
+	}
+
+	wide_t divide(const wide_t &x) const
+	{
+		if (pow2) {
+			// Bias negative values by 'd - 1' so that the shift rounds towards zero.
+			const wide_t q = (x + ((x >> serial_t(Depth - 1)) & serial_t((userial_t(1) << shift) - 1))) >> shift;
+			return negative ? -q : q;
+		}
+		wide_t q = cc0::wide::mulhi(x, wide_t(magic));
+		if (add) {
+			q = negative ? q - x : q + x;
+		}
+		q >>= shift;
+		return q - (q >> serial_t(Depth - 1));
+	}
+
+	wide_t remainder(const wide_t &x) const
+	{
+		return x - divide(x) * d;
+	}
+
+	serial_t divisor( void ) const { return d; }
+};
+
+
+/// @brief Divides each lane by the divisor of a divider.
+///
+/// @param l the dividend.
+/// @param r the divider.
+///
+/// @returns the quotients, rounded towards zero.
+template < uint32_t Depth, uint32_t Width > wide_int<Depth,Width>  operator /(const wide_int<Depth,Width> &l,  const divider< wide_int<Depth,Width> > &r)  { return r.divide(l); }
+template < uint32_t Depth, uint32_t Width > wide_uint<Depth,Width> operator /(const wide_uint<Depth,Width> &l, const divider< wide_uint<Depth,Width> > &r) { return r.divide(l); }
+
+
+/// @brief Returns the remainder of dividing each lane by the divisor of a divider.
+///
+/// @param l the dividend.
+/// @param r the divider.
+///
+/// @returns the remainders, with the sign of the dividend.
+template < uint32_t Depth, uint32_t Width > wide_int<Depth,Width>  operator %(const wide_int<Depth,Width> &l,  const divider< wide_int<Depth,Width> > &r)  { return r.remainder(l); }
+template < uint32_t Depth, uint32_t Width > wide_uint<Depth,Width> operator %(const wide_uint<Depth,Width> &l, const divider< wide_uint<Depth,Width> > &r) { return r.remainder(l); }
+
+
+/// @brief Reverses the order of the bytes in a serial integer.
+template < typename serial_t >
+inline serial_t __wide_byteswap(serial_t x)
+{
+	serial_t o = 0;
+	for (uint32_t i = 0; i < sizeof(serial_t); ++i) {
+		o = serial_t((o << 8) | ((x >> (i * 8)) & 0xff));
+	}
+	return o;
+}
+
+
+/// @brief Reverses the order of the bits in a serial unsigned integer.
+template < typename serial_t >
+inline serial_t __wide_bit_reverse(serial_t x)
+{
+	x = __wide_byteswap(x);
+	x = serial_t(((x >> 1) & serial_t(0x5555555555555555ull)) | ((x & serial_t(0x5555555555555555ull)) << 1));
+	x = serial_t(((x >> 2) & serial_t(0x3333333333333333ull)) | ((x & serial_t(0x3333333333333333ull)) << 2));
+	x = serial_t(((x >> 4) & serial_t(0x0f0f0f0f0f0f0f0full)) | ((x & serial_t(0x0f0f0f0f0f0f0f0full)) << 4));
+	return x;
+}
+
+
+/// @brief Applies a serial function to each lane of an unsigned wide integer.
+template < uint32_t Depth, uint32_t Width, typename serial_fn >
+inline wide_uint<Depth,Width> __wide_map_lanes(const wide_uint<Depth,Width> &x, serial_fn fn)
+{
+	typename wide_uint<Depth,Width>::serial_t v[Width];
+	std::memcpy(v, static_cast<const void*>(&x), sizeof(v));
+	for (uint32_t i = 0; i < Width; ++i) {
+		v[i] = typename wide_uint<Depth,Width>::serial_t(fn(v[i]));
+	}
+	return cc0::wide::load< wide_uint<Depth,Width> >(v);
+}
+
+
+/// @brief Counts the number of set bits in each lane.
+///
+/// @note Native types count bits via 4-bit lookup tables.
+///
+/// @param x the integer.
+///
+/// @returns the number of set bits per lane.
+///
+/// @sa countl_zero
+/// @sa countr_zero
+template < uint32_t Depth, uint32_t Width >
+wide_uint<Depth,Width> popcount(const wide_uint<Depth,Width> &x)
+{
+	return cc0::wide::__wide_map_lanes(x, [](uint64_t v) { return __wide_popcount(v); });
+}
+
+
+/// @brief Reverses the order of the bytes in each lane.
+///
+/// @param x the integer.
+///
+/// @returns the byte-swapped integer.
+///
+/// @sa bit_reverse
+template < uint32_t Depth, uint32_t Width >
+wide_uint<Depth,Width> byteswap(const wide_uint<Depth,Width> &x)
+{
+	return cc0::wide::__wide_map_lanes(x, [](typename wide_uint<Depth,Width>::serial_t v) { return __wide_byteswap(v); });
+}
+
+
+/// @brief Reverses the order of the bits in each lane.
+///
+/// @param x the integer.
+///
+/// @returns the bit-reversed integer.
+///
+/// @sa byteswap
+template < uint32_t Depth, uint32_t Width >
+wide_uint<Depth,Width> bit_reverse(const wide_uint<Depth,Width> &x)
+{
+	return cc0::wide::__wide_map_lanes(x, [](typename wide_uint<Depth,Width>::serial_t v) { return __wide_bit_reverse(v); });
+}
+
+#define NATIVE_BITS(D, W) \
+	inline wide_uint<D,W> popcount(const wide_uint<D,W> &x)    { return wide_uint<D,W>(__wide_simd<D,W>::i_popcnt(x.native())); } \
+	inline wide_uint<D,W> byteswap(const wide_uint<D,W> &x)    { return wide_uint<D,W>(__wide_simd<D,W>::i_bswap(x.native())); } \
+	inline wide_uint<D,W> bit_reverse(const wide_uint<D,W> &x) { return wide_uint<D,W>(__wide_simd<D,W>::i_bitrev(x.native())); }
+
+#if defined(CC0_WIDE_NATIVE_SSE2)
+	NATIVE_BITS(8, 16)
+	NATIVE_BITS(16, 8)
+#endif
+#if defined(CC0_WIDE_NATIVE_SSE4_1)
+	NATIVE_BITS(32, 4)
+#endif
+#if defined(CC0_WIDE_NATIVE_AVX2)
+	NATIVE_BITS(32, 8)
+	NATIVE_BITS(64, 4)
+#endif
+
+#undef NATIVE_BITS
+
+
+/// @brief Counts the number of consecutive zero bits in each lane, starting from the most significant bit.
+///
+/// @note Propagates the highest set bit into all lower bits and counts the bits that remain zero, so the cost is the same for all inputs.
+///
+/// @param x the integer.
+///
+/// @returns the number of leading zero bits per lane; 'Depth' for zero.
+///
+/// @sa countr_zero
+/// @sa bit_width
+template < uint32_t Depth, uint32_t Width >
+wide_uint<Depth,Width> countl_zero(wide_uint<Depth,Width> x)
+{
+	for (uint32_t shift = 1; shift < Depth; shift <<= 1) {
+		x |= x >> typename wide_uint<Depth,Width>::serial_t(shift);
+	}
+	return cc0::wide::popcount(~x);
+}
+
+
+/// @brief Counts the number of consecutive zero bits in each lane, starting from the least significant bit.
+///
+/// @param x the integer.
+///
+/// @returns the number of trailing zero bits per lane; 'Depth' for zero.
+///
+/// @sa countl_zero
+template < uint32_t Depth, uint32_t Width >
+wide_uint<Depth,Width> countr_zero(const wide_uint<Depth,Width> &x)
+{
+	return cc0::wide::popcount(~x & (x - typename wide_uint<Depth,Width>::serial_t(1)));
+}
+
+
+/// @brief Returns the number of bits needed to represent each lane, i.e. one more than the index of the highest set bit.
+///
+/// @param x the integer.
+///
+/// @returns the bit width per lane; 0 for zero.
+///
+/// @sa countl_zero
+template < uint32_t Depth, uint32_t Width >
+wide_uint<Depth,Width> bit_width(const wide_uint<Depth,Width> &x)
+{
+	return wide_uint<Depth,Width>(typename wide_uint<Depth,Width>::serial_t(Depth)) - cc0::wide::countl_zero(x);
+}
+
+
+/// @brief Rotates the bits of each lane towards the most significant bit.
+///
+/// @param x the integer.
+/// @param n the number of bits to rotate by. Negative values rotate the other way.
+///
+/// @returns the rotated integer.
+///
+/// @sa rotr
+template < uint32_t Depth, uint32_t Width >
+wide_uint<Depth,Width> rotl(const wide_uint<Depth,Width> &x, int n)
+{
+	typedef typename wide_uint<Depth,Width>::serial_t serial_t;
+	const uint32_t s = uint32_t(n) & (Depth - 1);
+	return (x << serial_t(s)) | (x >> serial_t((Depth - s) & (Depth - 1)));
+}
+
+
+/// @brief Rotates the bits of each lane towards the most significant bit by a per-lane amount.
+///
+/// @param x the integer.
+/// @param n the number of bits to rotate each lane by, modulo 'Depth'.
+///
+/// @returns the rotated integer.
+///
+/// @sa rotr
+template < uint32_t Depth, uint32_t Width >
+wide_uint<Depth,Width> rotl(const wide_uint<Depth,Width> &x, const wide_uint<Depth,Width> &n)
+{
+	typedef typename wide_uint<Depth,Width>::serial_t serial_t;
+	const wide_uint<Depth,Width> s = n & serial_t(Depth - 1);
+	return (x << s) | (x >> ((serial_t(Depth) - s) & serial_t(Depth - 1)));
+}
+
+
+/// @brief Rotates the bits of each lane towards the least significant bit.
+///
+/// @param x the integer.
+/// @param n the number of bits to rotate by. Negative values rotate the other way.
+///
+/// @returns the rotated integer.
+///
+/// @sa rotl
+template < uint32_t Depth, uint32_t Width >
+wide_uint<Depth,Width> rotr(const wide_uint<Depth,Width> &x, int n)
+{
+	return cc0::wide::rotl(x, -n);
+}
+
+
+/// @brief Rotates the bits of each lane towards the least significant bit by a per-lane amount.
+///
+/// @param x the integer.
+/// @param n the number of bits to rotate each lane by, modulo 'Depth'.
+///
+/// @returns the rotated integer.
+///
+/// @sa rotl
+template < uint32_t Depth, uint32_t Width >
+wide_uint<Depth,Width> rotr(const wide_uint<Depth,Width> &x, const wide_uint<Depth,Width> &n)
+{
+	return cc0::wide::rotl(x, wide_uint<Depth,Width>(typename wide_uint<Depth,Width>::serial_t(0)) - n);
+}
+
+// Signed integers are treated as their two's complement bit patterns.
+template < uint32_t Depth, uint32_t Width > wide_int<Depth,Width> popcount(const wide_int<Depth,Width> &x)    { return wide_int<Depth,Width>(cc0::wide::popcount(wide_uint<Depth,Width>(x))); }
+template < uint32_t Depth, uint32_t Width > wide_int<Depth,Width> byteswap(const wide_int<Depth,Width> &x)    { return wide_int<Depth,Width>(cc0::wide::byteswap(wide_uint<Depth,Width>(x))); }
+template < uint32_t Depth, uint32_t Width > wide_int<Depth,Width> bit_reverse(const wide_int<Depth,Width> &x) { return wide_int<Depth,Width>(cc0::wide::bit_reverse(wide_uint<Depth,Width>(x))); }
+template < uint32_t Depth, uint32_t Width > wide_int<Depth,Width> countl_zero(const wide_int<Depth,Width> &x) { return wide_int<Depth,Width>(cc0::wide::countl_zero(wide_uint<Depth,Width>(x))); }
+template < uint32_t Depth, uint32_t Width > wide_int<Depth,Width> countr_zero(const wide_int<Depth,Width> &x) { return wide_int<Depth,Width>(cc0::wide::countr_zero(wide_uint<Depth,Width>(x))); }
+template < uint32_t Depth, uint32_t Width > wide_int<Depth,Width> bit_width(const wide_int<Depth,Width> &x)   { return wide_int<Depth,Width>(cc0::wide::bit_width(wide_uint<Depth,Width>(x))); }
+template < uint32_t Depth, uint32_t Width > wide_int<Depth,Width> rotl(const wide_int<Depth,Width> &x, int n) { return wide_int<Depth,Width>(cc0::wide::rotl(wide_uint<Depth,Width>(x), n)); }
+template < uint32_t Depth, uint32_t Width > wide_int<Depth,Width> rotr(const wide_int<Depth,Width> &x, int n) { return wide_int<Depth,Width>(cc0::wide::rotr(wide_uint<Depth,Width>(x), n)); }
+template < uint32_t Depth, uint32_t Width > wide_int<Depth,Width> rotl(const wide_int<Depth,Width> &x, const wide_int<Depth,Width> &n) { return wide_int<Depth,Width>(cc0::wide::rotl(wide_uint<Depth,Width>(x), wide_uint<Depth,Width>(n))); }
+template < uint32_t Depth, uint32_t Width > wide_int<Depth,Width> rotr(const wide_int<Depth,Width> &x, const wide_int<Depth,Width> &n) { return wide_int<Depth,Width>(cc0::wide::rotr(wide_uint<Depth,Width>(x), wide_uint<Depth,Width>(n))); }
+
+
+/// @brief Adds two integers, clamping the result to the range of the type instead of wrapping around.
+///
+/// @note Native 8 and 16-bit types map to a single saturating instruction.
+///
+/// @param a the first term.
+/// @param b the second term.
+///
+/// @returns the saturated sum.
+///
+/// @sa subs
+template < uint32_t Depth, uint32_t Width >
+wide_uint<Depth,Width> adds(const wide_uint<Depth,Width> &a, const wide_uint<Depth,Width> &b)
+{
+	const wide_uint<Depth,Width> r = a + b;
+	return cc0::wide::cmov(r < a, wide_uint<Depth,Width>(std::numeric_limits<typename wide_uint<Depth,Width>::serial_t>::max()), r);
+}
+
+
+/// @brief Adds two integers, clamping the result to the range of the type instead of wrapping around.
+///
+/// @note Native 8 and 16-bit types map to a single saturating instruction.
+///
+/// @param a the first term.
+/// @param b the second term.
+///
+/// @returns the saturated sum.
+///
+/// @sa subs
+template < uint32_t Depth, uint32_t Width >
+wide_int<Depth,Width> adds(const wide_int<Depth,Width> &a, const wide_int<Depth,Width> &b)
+{
+	typedef typename wide_int<Depth,Width>::serial_t serial_t;
+	// Wraps around via unsigned arithmetic, which is well-defined, and detects overflow as the sign of the result differing from the signs of both terms.
+	const wide_int<Depth,Width> r = wide_int<Depth,Width>(wide_uint<Depth,Width>(a) + wide_uint<Depth,Width>(b));
+	const wide_int<Depth,Width> saturated = (a >> serial_t(Depth - 1)) ^ std::numeric_limits<serial_t>::max();
+	return cc0::wide::cmov(((a ^ r) & (b ^ r)) < serial_t(0), saturated, r);
+}
+
+
+/// @brief Subtracts two integers, clamping the result to the range of the type instead of wrapping around.
+///
+/// @note Native 8 and 16-bit types map to a single saturating instruction.
+///
+/// @param a the minuend.
+/// @param b the subtrahend.
+///
+/// @returns the saturated difference.
+///
+/// @sa adds
+template < uint32_t Depth, uint32_t Width >
+wide_uint<Depth,Width> subs(const wide_uint<Depth,Width> &a, const wide_uint<Depth,Width> &b)
+{
+	return cc0::wide::cmov(b > a, wide_uint<Depth,Width>(typename wide_uint<Depth,Width>::serial_t(0)), a - b);
+}
+
+
+/// @brief Subtracts two integers, clamping the result to the range of the type instead of wrapping around.
+///
+/// @note Native 8 and 16-bit types map to a single saturating instruction.
+///
+/// @param a the minuend.
+/// @param b the subtrahend.
+///
+/// @returns the saturated difference.
+///
+/// @sa adds
+template < uint32_t Depth, uint32_t Width >
+wide_int<Depth,Width> subs(const wide_int<Depth,Width> &a, const wide_int<Depth,Width> &b)
+{
+	typedef typename wide_int<Depth,Width>::serial_t serial_t;
+	const wide_int<Depth,Width> r = wide_int<Depth,Width>(wide_uint<Depth,Width>(a) - wide_uint<Depth,Width>(b));
+	const wide_int<Depth,Width> saturated = (a >> serial_t(Depth - 1)) ^ std::numeric_limits<serial_t>::max();
+	return cc0::wide::cmov(((a ^ b) & (a ^ r)) < serial_t(0), saturated, r);
+}
+
+
+/// @brief Returns the average of two integers, rounded up. Unlike '(a + b) / 2', the intermediate sum can not overflow.
+///
+/// @note Native 8 and 16-bit types map to a single instruction.
+///
+/// @param a the first value.
+/// @param b the second value.
+///
+/// @returns the average, rounded towards positive infinity.
+template < uint32_t Depth, uint32_t Width >
+wide_uint<Depth,Width> avg(const wide_uint<Depth,Width> &a, const wide_uint<Depth,Width> &b)
+{
+	return (a | b) - ((a ^ b) >> typename wide_uint<Depth,Width>::serial_t(1));
+}
+
+
+/// @brief Returns the average of two integers, rounded up. Unlike '(a + b) / 2', the intermediate sum can not overflow.
+///
+/// @note Native 8 and 16-bit types map to a single instruction.
+///
+/// @param a the first value.
+/// @param b the second value.
+///
+/// @returns the average, rounded towards positive infinity.
+template < uint32_t Depth, uint32_t Width >
+wide_int<Depth,Width> avg(const wide_int<Depth,Width> &a, const wide_int<Depth,Width> &b)
+{
+	return (a | b) - ((a ^ b) >> typename wide_int<Depth,Width>::serial_t(1));
+}
+
+#define NATIVE_SATURATE(D, W) \
+	inline wide_int<D,W>  adds(const wide_int<D,W> &a, const wide_int<D,W> &b)   { return wide_int<D,W>(__wide_simd<D,W>::i_adds(a.native(), b.native())); } \
+	inline wide_uint<D,W> adds(const wide_uint<D,W> &a, const wide_uint<D,W> &b) { return wide_uint<D,W>(__wide_simd<D,W>::u_adds(a.native(), b.native())); } \
+	inline wide_int<D,W>  subs(const wide_int<D,W> &a, const wide_int<D,W> &b)   { return wide_int<D,W>(__wide_simd<D,W>::i_subs(a.native(), b.native())); } \
+	inline wide_uint<D,W> subs(const wide_uint<D,W> &a, const wide_uint<D,W> &b) { return wide_uint<D,W>(__wide_simd<D,W>::u_subs(a.native(), b.native())); } \
+	inline wide_int<D,W>  avg(const wide_int<D,W> &a, const wide_int<D,W> &b)    { return wide_int<D,W>(__wide_simd<D,W>::i_avg(a.native(), b.native())); } \
+	inline wide_uint<D,W> avg(const wide_uint<D,W> &a, const wide_uint<D,W> &b)  { return wide_uint<D,W>(__wide_simd<D,W>::u_avg(a.native(), b.native())); }
+
+#if defined(CC0_WIDE_NATIVE_SSE2)
+	NATIVE_SATURATE(8, 16)
+	NATIVE_SATURATE(16, 8)
+#endif
+
+#undef NATIVE_SATURATE
+
+
+/// @brief Converts the lanes of a wide integer to the serial type of another wide integer. Lanes that do not fit the output type are clamped.
+template < typename to_t, typename from_t >
+inline void __wide_convert_lanes(const from_t &x, typename to_t::serial_t *out)
+{
+	typedef typename from_t::serial_t from_serial_t;
+	typedef typename to_t::serial_t   to_serial_t;
+	from_serial_t v[from_t::width];
+	std::memcpy(v, static_cast<const void*>(&x), sizeof(v));
+	const bool narrowing = sizeof(to_serial_t) < sizeof(from_serial_t);
+	for (uint32_t i = 0; i < from_t::width; ++i) {
+		if (narrowing && std::is_signed<from_serial_t>::value && v[i] < from_serial_t(std::numeric_limits<to_serial_t>::min())) {
+			out[i] = std::numeric_limits<to_serial_t>::min();
+		} else if (narrowing && v[i] > from_serial_t(std::numeric_limits<to_serial_t>::max())) {
+			out[i] = std::numeric_limits<to_serial_t>::max();
+		} else {
+			out[i] = to_serial_t(v[i]);
+		}
+	}
+}
+
+
+/// @brief Extends the lower half of the lanes to twice the bit depth.
+///
+/// @note Native types map to unpack or extend instructions.
+///
+/// @param x the integer.
+///
+/// @returns the lower half of the lanes at twice the bit depth.
+///
+/// @sa widen_hi
+/// @sa narrow_saturate
+template < uint32_t Depth, uint32_t Width >
+wide_uint<Depth*2,Width/2> widen_lo(const wide_uint<Depth,Width> &x)
+{
+	static_assert(Depth < 64 && Width % 2 == 0, "widen_lo requires a bit depth below 64 and an even number of lanes");
+	typename wide_uint<Depth*2,Width>::serial_t o[Width];
+	cc0::wide::__wide_convert_lanes< wide_uint<Depth*2,Width> >(x, o);
+	return cc0::wide::load< wide_uint<Depth*2,Width/2> >(o);
+}
+
+
+/// @brief Extends the lower half of the lanes to twice the bit depth.
+///
+/// @note Native types map to unpack or extend instructions.
+///
+/// @param x the integer.
+///
+/// @returns the lower half of the lanes at twice the bit depth.
+///
+/// @sa widen_hi
+/// @sa narrow_saturate
+template < uint32_t Depth, uint32_t Width >
+wide_int<Depth*2,Width/2> widen_lo(const wide_int<Depth,Width> &x)
+{
+	static_assert(Depth < 64 && Width % 2 == 0, "widen_lo requires a bit depth below 64 and an even number of lanes");
+	typename wide_int<Depth*2,Width>::serial_t o[Width];
+	cc0::wide::__wide_convert_lanes< wide_int<Depth*2,Width> >(x, o);
+	return cc0::wide::load< wide_int<Depth*2,Width/2> >(o);
+}
+
+
+/// @brief Extends the upper half of the lanes to twice the bit depth.
+///
+/// @note Native types map to unpack or extend instructions.
+///
+/// @param x the integer.
+///
+/// @returns the upper half of the lanes at twice the bit depth.
+///
+/// @sa widen_lo
+/// @sa narrow_saturate
+template < uint32_t Depth, uint32_t Width >
+wide_uint<Depth*2,Width/2> widen_hi(const wide_uint<Depth,Width> &x)
+{
+	static_assert(Depth < 64 && Width % 2 == 0, "widen_hi requires a bit depth below 64 and an even number of lanes");
+	typename wide_uint<Depth*2,Width>::serial_t o[Width];
+	cc0::wide::__wide_convert_lanes< wide_uint<Depth*2,Width> >(x, o);
+	return cc0::wide::load< wide_uint<Depth*2,Width/2> >(o + Width / 2);
+}
+
+
+/// @brief Extends the upper half of the lanes to twice the bit depth.
+///
+/// @note Native types map to unpack or extend instructions.
+///
+/// @param x the integer.
+///
+/// @returns the upper half of the lanes at twice the bit depth.
+///
+/// @sa widen_lo
+/// @sa narrow_saturate
+template < uint32_t Depth, uint32_t Width >
+wide_int<Depth*2,Width/2> widen_hi(const wide_int<Depth,Width> &x)
+{
+	static_assert(Depth < 64 && Width % 2 == 0, "widen_hi requires a bit depth below 64 and an even number of lanes");
+	typename wide_int<Depth*2,Width>::serial_t o[Width];
+	cc0::wide::__wide_convert_lanes< wide_int<Depth*2,Width> >(x, o);
+	return cc0::wide::load< wide_int<Depth*2,Width/2> >(o + Width / 2);
+}
+
+
+/// @brief Extends all lanes to twice the bit depth.
+///
+/// @note Native types map to extend instructions when both the input and the output type are native.
+///
+/// @param x the integer.
+///
+/// @returns the lanes at twice the bit depth.
+///
+/// @sa narrow_saturate
+template < uint32_t Depth, uint32_t Width >
+wide_uint<Depth*2,Width> widen(const wide_uint<Depth,Width> &x)
+{
+	static_assert(Depth < 64, "widen requires a bit depth below 64");
+	typename wide_uint<Depth*2,Width>::serial_t o[Width];
+	cc0::wide::__wide_convert_lanes< wide_uint<Depth*2,Width> >(x, o);
+	return cc0::wide::load< wide_uint<Depth*2,Width> >(o);
+}
+
+
+/// @brief Extends all lanes to twice the bit depth.
+///
+/// @note Native types map to extend instructions when both the input and the output type are native.
+///
+/// @param x the integer.
+///
+/// @returns the lanes at twice the bit depth.
+///
+/// @sa narrow_saturate
+template < uint32_t Depth, uint32_t Width >
+wide_int<Depth*2,Width> widen(const wide_int<Depth,Width> &x)
+{
+	static_assert(Depth < 64, "widen requires a bit depth below 64");
+	typename wide_int<Depth*2,Width>::serial_t o[Width];
+	cc0::wide::__wide_convert_lanes< wide_int<Depth*2,Width> >(x, o);
+	return cc0::wide::load< wide_int<Depth*2,Width> >(o);
+}
+
+
+/// @brief Packs the lanes of two integers into a single integer of half the bit depth, clamping lanes that do not fit.
+///
+/// @note Native types map to pack instructions.
+///
+/// @param lo the integer to place in the lower half of the lanes.
+/// @param hi the integer to place in the upper half of the lanes.
+///
+/// @returns the lanes of both inputs at half the bit depth.
+///
+/// @sa widen_lo
+/// @sa widen_hi
+template < uint32_t Depth, uint32_t Width >
+wide_uint<Depth/2,Width*2> narrow_saturate(const wide_uint<Depth,Width> &lo, const wide_uint<Depth,Width> &hi)
+{
+	static_assert(Depth > 8, "narrow_saturate requires a bit depth above 8");
+	typename wide_uint<Depth/2,Width>::serial_t o[Width * 2];
+	cc0::wide::__wide_convert_lanes< wide_uint<Depth/2,Width> >(lo, o);
+	cc0::wide::__wide_convert_lanes< wide_uint<Depth/2,Width> >(hi, o + Width);
+	return cc0::wide::load< wide_uint<Depth/2,Width*2> >(o);
+}
+
+
+/// @brief Packs the lanes of two integers into a single integer of half the bit depth, clamping lanes that do not fit.
+///
+/// @note Native types map to pack instructions.
+///
+/// @param lo the integer to place in the lower half of the lanes.
+/// @param hi the integer to place in the upper half of the lanes.
+///
+/// @returns the lanes of both inputs at half the bit depth.
+///
+/// @sa widen_lo
+/// @sa widen_hi
+template < uint32_t Depth, uint32_t Width >
+wide_int<Depth/2,Width*2> narrow_saturate(const wide_int<Depth,Width> &lo, const wide_int<Depth,Width> &hi)
+{
+	static_assert(Depth > 8, "narrow_saturate requires a bit depth above 8");
+	typename wide_int<Depth/2,Width>::serial_t o[Width * 2];
+	cc0::wide::__wide_convert_lanes< wide_int<Depth/2,Width> >(lo, o);
+	cc0::wide::__wide_convert_lanes< wide_int<Depth/2,Width> >(hi, o + Width);
+	return cc0::wide::load< wide_int<Depth/2,Width*2> >(o);
+}
+
+
+/// @brief Converts all lanes to half the bit depth, clamping lanes that do not fit.
+///
+/// @note Native types map to pack instructions when both the input and the output type are native.
+///
+/// @param x the integer.
+///
+/// @returns the lanes at half the bit depth.
+///
+/// @sa widen
+template < uint32_t Depth, uint32_t Width >
+wide_uint<Depth/2,Width> narrow_saturate(const wide_uint<Depth,Width> &x)
+{
+	static_assert(Depth > 8, "narrow_saturate requires a bit depth above 8");
+	typename wide_uint<Depth/2,Width>::serial_t o[Width];
+	cc0::wide::__wide_convert_lanes< wide_uint<Depth/2,Width> >(x, o);
+	return cc0::wide::load< wide_uint<Depth/2,Width> >(o);
+}
+
+
+/// @brief Converts all lanes to half the bit depth, clamping lanes that do not fit.
+///
+/// @note Native types map to pack instructions when both the input and the output type are native.
+///
+/// @param x the integer.
+///
+/// @returns the lanes at half the bit depth.
+///
+/// @sa widen
+template < uint32_t Depth, uint32_t Width >
+wide_int<Depth/2,Width> narrow_saturate(const wide_int<Depth,Width> &x)
+{
+	static_assert(Depth > 8, "narrow_saturate requires a bit depth above 8");
+	typename wide_int<Depth/2,Width>::serial_t o[Width];
+	cc0::wide::__wide_convert_lanes< wide_int<Depth/2,Width> >(x, o);
+	return cc0::wide::load< wide_int<Depth/2,Width> >(o);
+}
+
+#define NATIVE_WIDEN_HALVES(type, pre, D, W) \
+	inline type<D*2,W/2> widen_lo(const type<D,W> &x)                                    { return type<D*2,W/2>(__wide_simd<D,W>::pre##_widen_lo(x.native())); } \
+	inline type<D*2,W/2> widen_hi(const type<D,W> &x)                                    { return type<D*2,W/2>(__wide_simd<D,W>::pre##_widen_hi(x.native())); } \
+	inline type<D,W>     narrow_saturate(const type<D*2,W/2> &lo, const type<D*2,W/2> &hi) { return type<D,W>(__wide_simd<D,W>::pre##_narrow(lo.native(), hi.native())); }
+
+#define NATIVE_WIDEN(type, pre, D, W) \
+	inline type<D*2,W> widen(const type<D,W> &x)           { return type<D*2,W>(__wide_simd<D,W>::pre##_widen(x.native())); } \
+	inline type<D,W>   narrow_saturate(const type<D*2,W> &x) { return type<D,W>(__wide_simd<D,W>::pre##_narrow(x.native())); }
+
+#if defined(CC0_WIDE_NATIVE_SSE2)
+	NATIVE_WIDEN_HALVES(wide_int,  i, 8, 16)
+	NATIVE_WIDEN_HALVES(wide_uint, u, 8, 16)
+#endif
+#if defined(CC0_WIDE_NATIVE_SSE4_1)
+	NATIVE_WIDEN_HALVES(wide_int,  i, 16, 8)
+	NATIVE_WIDEN_HALVES(wide_uint, u, 16, 8)
+#endif
+#if defined(CC0_WIDE_NATIVE_AVX2)
+	NATIVE_WIDEN_HALVES(wide_int,  i, 32, 8)
+	NATIVE_WIDEN_HALVES(wide_uint, u, 32, 8)
+	NATIVE_WIDEN(wide_int,  i, 16, 8)
+	NATIVE_WIDEN(wide_uint, u, 16, 8)
+	NATIVE_WIDEN(wide_int,  i, 32, 4)
+	NATIVE_WIDEN(wide_uint, u, 32, 4)
+#endif
+
+#undef NATIVE_WIDEN_HALVES
+#undef NATIVE_WIDEN
+
+
+/// @brief Converts half-precision floating-point values to single precision.
+///
+/// @note Maps to a single conversion instruction when F16C is enabled (-mf16c).
+///
+/// @param x the half-precision values.
+///
+/// @returns the single-precision values. The conversion is exact.
+///
+/// @sa narrow
+/// @sa load_widen
+template < uint32_t Width >
+wide_float<32,Width> widen(const wide_float<16,Width> &x)
+{
+	typedef wide_uint<32,Width> bits_t;
+	const bits_t h = cc0::wide::widen(cc0::wide::bit_cast< wide_uint<16,Width> >(x));
+	// Shifts exponent and mantissa into place and rebiases the exponent. Infinity and NaN need a larger exponent, while subnormal values are normalized via a floating-point subtraction.
+	bits_t o = (h & 0x7fffu) << 13u;
+	const bits_t exponent = o & 0x0f800000u;
+	o += 112u << 23;
+	o = cc0::wide::cmov(exponent == 0x0f800000u, o + (112u << 23), o);
+	o = cc0::wide::cmov(exponent == 0u, cc0::wide::bit_cast<bits_t>(cc0::wide::bit_cast< wide_float<32,Width> >(o + (1u << 23)) - 6.103515625e-05f), o);
+	return cc0::wide::bit_cast< wide_float<32,Width> >(o | ((h & 0x8000u) << 16u));
+}
+
+
+/// @brief Converts single-precision floating-point values to half precision, rounding to nearest even.
+///
+/// @note Maps to a single conversion instruction when F16C is enabled (-mf16c).
+/// @note Values too large for half precision become infinity.
+///
+/// @param x the single-precision values.
+///
+/// @returns the half-precision values.
+///
+/// @sa widen
+/// @sa store_narrow
+template < uint32_t Width >
+wide_float<16,Width> narrow(const wide_float<32,Width> &x)
+{
+	typedef wide_uint<32,Width> bits_t;
+	bits_t u = cc0::wide::bit_cast<bits_t>(x);
+	const bits_t sign = u & 0x80000000u;
+	u ^= sign;
+	// Too large for half precision. NaN is kept quiet along with as much of its payload as fits.
+	const bits_t large = cc0::wide::cmov(u > 0x7f800000u, ((u >> 13u) & 0x3ffu) | 0x7e00u, bits_t(0x7c00u));
+	// Subnormal in half precision. Adding 0.5 aligns the value so that the floating-point adder rounds the mantissa into the lowest bits.
+	const bits_t small = cc0::wide::bit_cast<bits_t>(cc0::wide::bit_cast< wide_float<32,Width> >(u) + 0.5f) - 0x3f000000u;
+	const bits_t normal = (u + 0xc8000fffu + ((u >> 13u) & 1u)) >> 13u;
+	const bits_t o = cc0::wide::cmov(u >= 0x47800000u, large, cc0::wide::cmov(u < 0x38800000u, small, normal)) | (sign >> 16u);
+	return cc0::wide::bit_cast< wide_float<16,Width> >(cc0::wide::narrow_saturate(o));
+}
+
+#define NATIVE_HALF(W) \
+	inline wide_float<32,W> widen(const wide_float<16,W> &x)  { return wide_float<32,W>(__wide_simd<32,W>::f_load_half(&x)); } \
+	inline wide_float<16,W> narrow(const wide_float<32,W> &x) { wide_float<16,W> o; __wide_simd<32,W>::f_store_half(&o, x.native()); return o; }
+
+#if defined(CC0_WIDE_NATIVE_F16C)
+	NATIVE_HALF(4)
+	#if defined(CC0_WIDE_NATIVE_AVX2)
+		NATIVE_HALF(8)
+	#endif
+#endif
+
+#undef NATIVE_HALF
+
+
+/// @brief Loads half-precision floating-point values from memory and converts them to single precision.
+///
+/// @param p pointer to the array of half-precision values. Does not need to be aligned.
+///
+/// @returns the single-precision values.
+///
+/// @sa store_narrow
+template < typename wide_t >
+wide_t load_widen(const float16 *p)
+{
+	return cc0::wide::widen(cc0::wide::load< wide_float<16,wide_t::width> >(p));
+}
+
+
+/// @brief Loads bfloat16 values from memory and converts them to single precision.
+///
+/// @param p pointer to the array of bfloat16 values. Does not need to be aligned.
+///
+/// @returns the single-precision values.
+///
+/// @sa store_narrow
+template < typename wide_t >
+wide_t load_widen(const bfloat16 *p)
+{
+	typedef wide_uint<16,wide_t::width> bits_t;
+	bits_t h;
+	std::memcpy(static_cast<void*>(&h), p, sizeof(bits_t));
+	return cc0::wide::bit_cast<wide_t>(cc0::wide::widen(h) << 16u);
+}
+
+
+/// @brief Converts single-precision floating-point values to half precision, rounding to nearest even, and stores them in memory.
+///
+/// @param p pointer to the array of half-precision values. Does not need to be aligned.
+/// @param x the single-precision values.
+///
+/// @sa load_widen
+template < uint32_t Width >
+void store_narrow(float16 *p, const wide_float<32,Width> &x)
+{
+	cc0::wide::store(p, cc0::wide::narrow(x));
+}
+
+
+/// @brief Converts single-precision floating-point values to bfloat16, rounding to nearest even, and stores them in memory.
+///
+/// @param p pointer to the array of bfloat16 values. Does not need to be aligned.
+/// @param x the single-precision values.
+///
+/// @sa load_widen
+template < uint32_t Width >
+void store_narrow(bfloat16 *p, const wide_float<32,Width> &x)
+{
+	typedef wide_uint<32,Width> bits_t;
+	const bits_t u = cc0::wide::bit_cast<bits_t>(x);
+	// Rounds to nearest even by adding just under half of the dropped bits, plus one if the remaining bits are odd. NaN is kept quiet instead, since rounding could turn it into infinity.
+	const bits_t o = cc0::wide::cmov(x != x, (u >> 16u) | 0x40u, (u + 0x7fffu + ((u >> 16u) & 1u)) >> 16u);
+	const wide_uint<16,Width> h = cc0::wide::narrow_saturate(o);
+	std::memcpy(p, static_cast<const void*>(&h), sizeof(h));
+}
+
+
+/// @brief Combines all lanes of a wide value into a single serial value by repeatedly applying an operation to the lower and upper half of the remaining lanes.
+///
+/// @param x the wide value.
+/// @param op the binary operation to apply to pairs of lanes.
+///
+/// @returns the combined serial value.
+template < typename wide_t, typename op_t >
+typename wide_t::serial_t __wide_reduce(const wide_t &x, op_t op)
+{
+	typename wide_t::serial_t t[wide_t::width];
+	std::memcpy(t, static_cast<const void*>(&x), sizeof(t));
+	for (uint32_t n = wide_t::width / 2; n > 0; n /= 2) {
+		for (uint32_t i = 0; i < n; ++i) { t[i] = op(t[i], t[i + n]); }
+	}
+	return t[0];
+}
+
+
+/// @brief Returns the sum of all lanes in the wide value.
+///
+/// @param x the wide value.
+///
+/// @returns the sum.
+///
+/// @note The lanes are summed pairwise, which may yield a slightly different floating-point result than summing the lanes in order.
+template < typename wide_t > typename wide_t::serial_t reduce_add(const wide_t &x) { typedef typename wide_t::serial_t s; return __wide_reduce(x, [](s a, s b) { return s(a + b); }); }
+
+
+/// @brief Returns the smallest lane in the wide value.
+///
+/// @param x the wide value.
+///
+/// @returns the smallest lane.
+template < typename wide_t > typename wide_t::serial_t reduce_min(const wide_t &x) { typedef typename wide_t::serial_t s; return __wide_reduce(x, [](s a, s b) { return a < b ? a : b; }); }
+
+
+/// @brief Returns the largest lane in the wide value.
+///
+/// @param x the wide value.
+///
+/// @returns the largest lane.
+template < typename wide_t > typename wide_t::serial_t reduce_max(const wide_t &x) { typedef typename wide_t::serial_t s; return __wide_reduce(x, [](s a, s b) { return b < a ? a : b; }); }
+
+
+/// @brief Returns the bitwise AND of all lanes in the wide integer value.
+///
+/// @param x the wide value.
+///
+/// @returns the bitwise AND of all lanes.
+template < typename wide_t > typename wide_t::serial_t reduce_and(const wide_t &x) { typedef typename wide_t::serial_t s; return __wide_reduce(x, [](s a, s b) { return s(a & b); }); }
+
+
+/// @brief Returns the bitwise OR of all lanes in the wide integer value.
+///
+/// @param x the wide value.
+///
+/// @returns the bitwise OR of all lanes.
+template < typename wide_t > typename wide_t::serial_t reduce_or(const wide_t &x) { typedef typename wide_t::serial_t s; return __wide_reduce(x, [](s a, s b) { return s(a | b); }); }
+
+
+/// @brief Returns the bitwise XOR of all lanes in the wide integer value.
+///
+/// @param x the wide value.
+///
+/// @returns the bitwise XOR of all lanes.
+template < typename wide_t > typename wide_t::serial_t reduce_xor(const wide_t &x) { typedef typename wide_t::serial_t s; return __wide_reduce(x, [](s a, s b) { return s(a ^ b); }); }
+
+
+/// @brief Packs the lanes of a wide boolean into an integer where bit 'i' is set if lane 'i' is true.
+///
+/// @param x the wide boolean.
+///
+/// @returns the lane bit mask.
+template < uint32_t Depth, uint32_t Width >
+uint64_t movemask(const wide_bool<Depth,Width> &x)
+{
+	static_assert(Width <= 64, "movemask requires a width of at most 64 lanes");
+	const typename wide_bool<Depth,Width>::serial_t *v = serialize(x);
+	uint64_t o = 0;
+	for (uint32_t i = 0; i < Width; ++i) { o |= uint64_t(v[i] ? 1 : 0) << i; }
+	return o;
+}
+
+
+/// @brief Returns true if any lane in the wide boolean is true.
+///
+/// @param x the wide boolean.
+///
+/// @returns true if any lane is true.
+///
+/// @sa all
+/// @sa none
+template < uint32_t Depth, uint32_t Width > bool any(const wide_bool<Depth,Width> &x) { return reduce_or(bit_cast< wide_uint<Depth,Width> >(x)) != 0; }
+
+
+/// @brief Returns true if all lanes in the wide boolean are true.
+///
+/// @param x the wide boolean.
+///
+/// @returns true if all lanes are true.
+///
+/// @sa any
+/// @sa none
+template < uint32_t Depth, uint32_t Width > bool all(const wide_bool<Depth,Width> &x) { return reduce_and(bit_cast< wide_uint<Depth,Width> >(x)) != 0; }
+
+
+/// @brief Returns true if no lane in the wide boolean is true.
+///
+/// @param x the wide boolean.
+///
+/// @returns true if all lanes are false.
+///
+/// @sa any
+/// @sa all
+template < uint32_t Depth, uint32_t Width > bool none(const wide_bool<Depth,Width> &x) { return !cc0::wide::any(x); }
+
+
+/// @brief Returns the number of true lanes in the wide boolean.
+///
+/// @param x the wide boolean.
+///
+/// @returns the number of true lanes.
+template < uint32_t Depth, uint32_t Width >
+uint32_t popcount(const wide_bool<Depth,Width> &x)
+{
+	// Counts in 32 bits, since the number of lanes may not fit the serial type, e.g. 256 lanes of 8 bits.
+	const typename wide_bool<Depth,Width>::serial_t *v = serialize(x);
+	uint32_t o = 0;
+	for (uint32_t i = 0; i < Width; ++i) { o += uint32_t(v[i] != 0); }
+	return o;
+}
+
+
+/// @brief How many lanes of a mask are true. Lets the conditional macros skip blocks no lane enters, and assign directly in blocks all lanes enter.
+enum class __wide_lanes : uint32_t
+{
+	none,
+	some,
+	all
+};
+
+
+/// @brief Determines if none, some, or all lanes of a wide boolean are true in a single pass over the lanes.
+template < uint32_t Depth, uint32_t Width >
+inline __wide_lanes __wide_count_lanes(const wide_bool<Depth,Width> &x)
+{
+	typedef typename wide_bool<Depth,Width>::serial_t serial_t;
+	const serial_t *v = serialize(x);
+	serial_t o = 0;
+	serial_t a = serial_t(~serial_t(0));
+	for (uint32_t i = 0; i < Width; ++i) {
+		o |= v[i];
+		a &= v[i];
+	}
+	return a != 0 ? __wide_lanes::all : (o != 0 ? __wide_lanes::some : __wide_lanes::none);
+}
+
+#define NATIVE_REDUCE(name, type, D, W, fold, expr) \
+	inline type<D,W>::serial_t name(const type<D,W> &x) \
+	{ \
+		typedef __wide_simd<D,W> simd; \
+		type<D,W>::native_t a = x.native(); \
+		if (sizeof(a) > 16)  { const uint32_t bytes = 16; const type<D,W>::native_t b = fold; a = expr; } \
+		if (D / 8 <= 8)      { const uint32_t bytes = 8;  const type<D,W>::native_t b = fold; a = expr; } \
+		if (D / 8 <= 4)      { const uint32_t bytes = 4;  const type<D,W>::native_t b = fold; a = expr; } \
+		if (D / 8 <= 2)      { const uint32_t bytes = 2;  const type<D,W>::native_t b = fold; a = expr; } \
+		if (D / 8 <= 1)      { const uint32_t bytes = 1;  const type<D,W>::native_t b = fold; a = expr; } \
+		type<D,W>::serial_t o; \
+		std::memcpy(&o, &a, sizeof(o)); \
+		return o; \
+	}
+
+#define NATIVE_REDUCE_INTEGER(type, D, W, gt) \
+	NATIVE_REDUCE(reduce_add, type, D, W, simd::i_fold(a, bytes), simd::i_add(a, b)) \
+	NATIVE_REDUCE(reduce_min, type, D, W, simd::i_fold(a, bytes), simd::i_blend(simd::gt(b, a), a, b)) \
+	NATIVE_REDUCE(reduce_max, type, D, W, simd::i_fold(a, bytes), simd::i_blend(simd::gt(a, b), a, b)) \
+	NATIVE_REDUCE(reduce_and, type, D, W, simd::i_fold(a, bytes), simd::i_and(a, b)) \
+	NATIVE_REDUCE(reduce_or,  type, D, W, simd::i_fold(a, bytes), simd::i_or(a, b)) \
+	NATIVE_REDUCE(reduce_xor, type, D, W, simd::i_fold(a, bytes), simd::i_xor(a, b))
+
+#define NATIVE_REDUCE_FLOAT(D, W) \
+	NATIVE_REDUCE(reduce_add, wide_float, D, W, simd::f_cast(simd::i_fold(simd::f_bits(a), bytes)), simd::f_add(a, b)) \
+	NATIVE_REDUCE(reduce_min, wide_float, D, W, simd::f_cast(simd::i_fold(simd::f_bits(a), bytes)), simd::f_blend(simd::f_lt(a, b), a, b)) \
+	NATIVE_REDUCE(reduce_max, wide_float, D, W, simd::f_cast(simd::i_fold(simd::f_bits(a), bytes)), simd::f_blend(simd::f_lt(b, a), a, b))
+
+#define NATIVE_MASK(D, W) \
+	inline uint64_t movemask(const wide_bool<D,W> &x) { return __wide_simd<D,W>::i_movemask(x.native()); } \
+	inline bool     any(const wide_bool<D,W> &x)      { return __wide_simd<D,W>::i_any(x.native()); } \
+	inline bool     all(const wide_bool<D,W> &x)      { return __wide_simd<D,W>::i_movemask(x.native()) == (uint32_t(-1) >> (32 - W)); } \
+	inline uint32_t popcount(const wide_bool<D,W> &x) { return __wide_popcount(__wide_simd<D,W>::i_movemask(x.native())); } \
+	inline __wide_lanes __wide_count_lanes(const wide_bool<D,W> &x) \
+	{ \
+		const uint32_t m = __wide_simd<D,W>::i_movemask(x.native()); \
+		return m == (uint32_t(-1) >> (32 - W)) ? __wide_lanes::all : (m != 0 ? __wide_lanes::some : __wide_lanes::none); \
+	}
+
+#define NATIVE_HORIZONTAL(D, W, F) \
+	NATIVE_REDUCE_INTEGER(wide_int,  D, W, i_gt) \
+	NATIVE_REDUCE_INTEGER(wide_uint, D, W, i_ugt) \
+	F(NATIVE_REDUCE_FLOAT(D, W)) \
+	NATIVE_MASK(D, W)
+
+#define NATIVE_WITH(...) __VA_ARGS__
+#define NATIVE_WITHOUT(...)
+
+#if defined(CC0_WIDE_NATIVE_SSE2)
+	NATIVE_HORIZONTAL(8, 16, NATIVE_WITHOUT)
+	NATIVE_HORIZONTAL(16, 8, NATIVE_WITHOUT)
+#endif
+#if defined(CC0_WIDE_NATIVE_SSE4_1)
+	NATIVE_HORIZONTAL(32, 4, NATIVE_WITH)
+#endif
+#if defined(CC0_WIDE_NATIVE_AVX2)
+	NATIVE_HORIZONTAL(32, 8, NATIVE_WITH)
+	NATIVE_HORIZONTAL(64, 4, NATIVE_WITH)
+#endif
+
+#undef NATIVE_WITH
+#undef NATIVE_WITHOUT
+#undef NATIVE_REDUCE
+#undef NATIVE_REDUCE_INTEGER
+#undef NATIVE_REDUCE_FLOAT
+#undef NATIVE_MASK
+#undef NATIVE_HORIZONTAL
+
+
+/// @brief Moves the lanes of a wide value where the corresponding lane in the mask is true to the lowest lanes, preserving their order. Use to filter values by a condition.
+///
+/// @param value the wide value.
+/// @param mask the lanes to keep.
+///
+/// @returns the wide value with the kept lanes first, where the remaining lanes are zero.
+///
+/// @sa expand
+/// @sa compress_store
+template < typename wide_t >
+wide_t compress(const wide_t &value, const wide_bool<wide_t::depth,wide_t::width> &mask)
+{
+	typename wide_t::serial_t v[wide_t::width];
+	typename wide_t::serial_t o[wide_t::width];
+	typename wide_bool<wide_t::depth,wide_t::width>::serial_t m[wide_t::width];
+	std::memcpy(v, static_cast<const void*>(&value), sizeof(v));
+	std::memcpy(m, static_cast<const void*>(&mask), sizeof(m));
+	uint32_t n = 0;
+	for (uint32_t i = 0; i < wide_t::width; ++i) {
+		o[n] = v[i];
+		n += m[i] != 0 ? 1 : 0;
+	}
+	for (uint32_t i = n; i < wide_t::width; ++i) {
+		o[i] = typename wide_t::serial_t(0);
+	}
+	return cc0::wide::load<wide_t>(o);
+}
+
+
+/// @brief Moves the lowest lanes of a wide value to the lanes where the corresponding lane in the mask is true, preserving their order. The inverse of compress.
+///
+/// @param value the wide value.
+/// @param mask the lanes to fill.
+///
+/// @returns the wide value with the lowest lanes spread over the true lanes of the mask, where the remaining lanes are zero.
+///
+/// @sa compress
+/// @sa expand_load
+template < typename wide_t >
+wide_t expand(const wide_t &value, const wide_bool<wide_t::depth,wide_t::width> &mask)
+{
+	typename wide_t::serial_t v[wide_t::width];
+	typename wide_t::serial_t o[wide_t::width];
+	typename wide_bool<wide_t::depth,wide_t::width>::serial_t m[wide_t::width];
+	std::memcpy(v, static_cast<const void*>(&value), sizeof(v));
+	std::memcpy(m, static_cast<const void*>(&mask), sizeof(m));
+	uint32_t n = 0;
+	for (uint32_t i = 0; i < wide_t::width; ++i) {
+		o[i] = m[i] != 0 ? v[n] : typename wide_t::serial_t(0);
+		n += m[i] != 0 ? 1 : 0;
+	}
+	return cc0::wide::load<wide_t>(o);
+}
+
+#define NATIVE_COMPRESS(type, D, W) \
+	inline type<D,W> compress(const type<D,W> &value, const wide_bool<D,W> &mask) \
+	{ \
+		const uint32_t m = __wide_simd<D,W>::i_movemask(mask.native()); \
+		return cc0::wide::cmov(tail_mask< type<D,W> >(__wide_popcount(m)), cc0::wide::permute(value, wide_int<D,W>(__wide_simd<D,W>::i_compress_index(m))), type<D,W>::serial_t(0)); \
+	} \
+	inline type<D,W> expand(const type<D,W> &value, const wide_bool<D,W> &mask) \
+	{ \
+		const uint32_t m = __wide_simd<D,W>::i_movemask(mask.native()); \
+		return cc0::wide::cmov(mask, cc0::wide::permute(value, wide_int<D,W>(__wide_simd<D,W>::i_expand_index(m))), type<D,W>::serial_t(0)); \
+	}
+
+#define NATIVE_WITH(...) __VA_ARGS__
+#define NATIVE_WITHOUT(...)
+
+#define NATIVE_SHAPE_COMPRESS(D, W, F) \
+	NATIVE_COMPRESS(wide_int, D, W) \
+	NATIVE_COMPRESS(wide_uint, D, W) \
+	F(NATIVE_COMPRESS(wide_float, D, W))
+
+#if defined(CC0_WIDE_NATIVE_SSE4_1)
+	NATIVE_SHAPE_COMPRESS(8, 16, NATIVE_WITHOUT)
+	NATIVE_SHAPE_COMPRESS(16, 8, NATIVE_WITHOUT)
+	NATIVE_SHAPE_COMPRESS(32, 4, NATIVE_WITH)
+#endif
+#if defined(CC0_WIDE_NATIVE_AVX2)
+	NATIVE_SHAPE_COMPRESS(32, 8, NATIVE_WITH)
+	NATIVE_SHAPE_COMPRESS(64, 4, NATIVE_WITH)
+#endif
+
+#undef NATIVE_WITH
+#undef NATIVE_WITHOUT
+#undef NATIVE_COMPRESS
+#undef NATIVE_SHAPE_COMPRESS
+
+
+/// @brief Stores the lanes of a wide value where the corresponding lane in the mask is true contiguously to an array of serial values, preserving their order. Use to filter an array by a condition, advancing the output pointer by the returned count.
+///
+/// @note Only as many elements as there are true lanes are written, which makes it safe to store near the end of an array.
+///
+/// @param p pointer to the array of serial values. Does not need to be aligned.
+/// @param value the wide value.
+/// @param mask the lanes to store.
+///
+/// @returns the number of elements written, i.e. the number of true lanes in the mask.
+///
+/// @sa compress
+/// @sa expand_load
+template < typename wide_t >
+uint32_t compress_store(typename wide_t::serial_t *p, const wide_t &value, const wide_bool<wide_t::depth,wide_t::width> &mask)
+{
+	const wide_t   c = cc0::wide::compress(value, mask);
+	const uint32_t n = cc0::wide::popcount(mask);
+	std::memcpy(p, static_cast<const void*>(&c), n * sizeof(typename wide_t::serial_t));
+	return n;
+}
+
+
+/// @brief Loads consecutive elements from an array of serial values into the lanes where the corresponding lane in the mask is true, preserving their order. The inverse of compress_store.
+///
+/// @note Only as many elements as there are true lanes are read, which makes it safe to load near the end of an array.
+///
+/// @param p pointer to the array of serial values. Does not need to be aligned.
+/// @param mask the lanes to load.
+///
+/// @returns the wide value, where lanes not loaded are zero.
+///
+/// @sa expand
+/// @sa compress_store
+template < typename wide_t >
+wide_t expand_load(const typename wide_t::serial_t *p, const wide_bool<wide_t::depth,wide_t::width> &mask)
+{
+	typename wide_t::serial_t v[wide_t::width] = {};
+	std::memcpy(v, p, cc0::wide::popcount(mask) * sizeof(typename wide_t::serial_t));
+	return cc0::wide::expand(cc0::wide::load<wide_t>(v), mask);
+}
+
+#define NATIVE_COMPRESS_MEMORY(type, D, W) \
+	template <> inline uint32_t compress_store< type<D,W> >(type<D,W>::serial_t *p, const type<D,W> &value, const wide_bool<D,W> &mask) \
+	{ \
+		const uint32_t n = cc0::wide::popcount(mask); \
+		cc0::wide::store_masked(p, cc0::wide::compress(value, mask), tail_mask< type<D,W> >(n)); \
+		return n; \
+	} \
+	template <> inline type<D,W> expand_load< type<D,W> >(const type<D,W>::serial_t *p, const wide_bool<D,W> &mask) \
+	{ \
+		return cc0::wide::expand(cc0::wide::load_masked< type<D,W> >(p, tail_mask< type<D,W> >(cc0::wide::popcount(mask))), mask); \
+	}
+
+#define NATIVE_SHAPE_COMPRESS_MEMORY(D, W) \
+	NATIVE_COMPRESS_MEMORY(wide_int, D, W) \
+	NATIVE_COMPRESS_MEMORY(wide_uint, D, W) \
+	NATIVE_COMPRESS_MEMORY(wide_float, D, W)
+
+// Only the shapes with native masked loads and stores write the elements in one instruction. Elsewhere, copying the elements is faster than a masked store that inspects each lane.
+#if defined(CC0_WIDE_NATIVE_AVX2)
+	NATIVE_SHAPE_COMPRESS_MEMORY(32, 4)
+	NATIVE_SHAPE_COMPRESS_MEMORY(32, 8)
+	NATIVE_SHAPE_COMPRESS_MEMORY(64, 4)
+#endif
+
+#undef NATIVE_COMPRESS_MEMORY
+#undef NATIVE_SHAPE_COMPRESS_MEMORY
+
+
+/// @brief The mask set up by the conditional macros. Records how many of its lanes are true, so that the macros only need to inspect the lanes once per block.
+///
+/// @param Uniform hints that all lanes usually agree, see CC0_WIDE_IF_UNIFORM.
+template < uint32_t Depth, uint32_t Width, bool Uniform >
+class __wide_mask : public wide_bool<Depth,Width>
+{
+public:
+	__wide_lanes lanes;
+
+public:
+	__wide_mask(const wide_bool<Depth,Width> &m, __wide_lanes l) : wide_bool<Depth,Width>(m), lanes(l) {}
+
+	/// @brief Returns true if any lane is true.
+	bool active( void ) const { return lanes != __wide_lanes::none; }
+
+	/// @brief Returns true if all lanes are true.
+	bool uniform( void ) const { return Uniform ? EXPECT(lanes == __wide_lanes::all, true) : lanes == __wide_lanes::all; }
+};
+
+
+/// @brief Returns how many lanes of a mask are true, reusing the count of masks set up by the conditional macros.
+template < uint32_t Depth, uint32_t Width >
+inline __wide_lanes __wide_lanes_of(const wide_bool<Depth,Width> &m) { return __wide_count_lanes(m); }
+
+template < uint32_t Depth, uint32_t Width, bool Uniform >
+inline __wide_lanes __wide_lanes_of(const __wide_mask<Depth,Width,Uniform> &m) { return m.lanes; }
+
+
+/// @brief Returns true if all lanes of a mask are known to be true. Always false for masks not set up by the conditional macros, which are not inspected.
+template < uint32_t Depth, uint32_t Width >
+inline bool __wide_uniform(const wide_bool<Depth,Width>&) { return false; }
+
+template < uint32_t Depth, uint32_t Width, bool Uniform >
+inline bool __wide_uniform(const __wide_mask<Depth,Width,Uniform> &m) { return m.uniform(); }
+
+
+/// @brief Sets up the mask of a conditional block.
+template < bool Uniform, uint32_t Depth, uint32_t Width >
+inline __wide_mask<Depth,Width,Uniform> __wide_branch(const wide_bool<Depth,Width> &m)
+{
+	return __wide_mask<Depth,Width,Uniform>(m, cc0::wide::__wide_lanes_of(m));
+}
+
+
+/// @brief Sets up the mask of the 'else' block of a conditional, i.e. the lanes of the parent mask that did not enter the 'if' block. Lanes need not be inspected again when the 'if' block was entered by all or none of the lanes.
+template < uint32_t Depth, uint32_t Width, bool Uniform, typename parent_t >
+inline __wide_mask<Depth,Width,Uniform> __wide_branch_else(const __wide_mask<Depth,Width,Uniform> &m, const parent_t &parent)
+{
+	switch (m.lanes) {
+	case __wide_lanes::all:  return __wide_mask<Depth,Width,Uniform>(wide_bool<Depth,Width>(false), __wide_lanes::none);
+	case __wide_lanes::none: return __wide_mask<Depth,Width,Uniform>(parent, cc0::wide::__wide_lanes_of(parent));
+	default:                 break;
+	}
+	const wide_bool<Depth,Width> e = (!m) & parent;
+	return __wide_mask<Depth,Width,Uniform>(e, cc0::wide::__wide_count_lanes(e));
+}
+
+#if defined(CC0_WIDE_PROFILE)
+
+/// @brief Records a block of a site in the profiler if any of the lanes of its mask are true.
+template < uint32_t Depth, uint32_t Width, bool Uniform >
+inline void __wide_profile_iteration(const __wide_profile_site &site, const __wide_mask<Depth,Width,Uniform> &m)
+{
+	if (m.active()) {
+		cc0::wide::__wide_profile_block(site, m.lanes == __wide_lanes::all ? Width : cc0::wide::popcount(static_cast<const wide_bool<Depth,Width>&>(m)), Width);
+	}
+}
+
+#endif
+
+// Useful typedefs. Provide WIDE_DEPTH and WIDE_WIDTH defines through the build stage.
+#if defined(CC0_WIDE_DEPTH) && defined(CC0_WIDE_WIDTH)
+	#define CC0_WIDE_DEFAULTS
+	typedef wide_bool<CC0_WIDE_DEPTH,CC0_WIDE_WIDTH>  bool_t;
+	typedef wide_int<CC0_WIDE_DEPTH,CC0_WIDE_WIDTH>   int_t;
+	typedef wide_uint<CC0_WIDE_DEPTH,CC0_WIDE_WIDTH>  uint_t;
+	typedef wide_float<CC0_WIDE_DEPTH,CC0_WIDE_WIDTH> float_t;
+#endif
+
+
+/// @brief The number of lanes of the widest native register for a given bit depth, given the instruction sets enabled at compile time. Code that is compiled for several instruction sets can use this to pick a width for each of them.
+///
+/// @note When no native register is available for the bit depth, the number of lanes of a 128-bit register is used.
+template < uint32_t Depth >
+class native_width
+{
+public:
+#if defined(CC0_WIDE_NATIVE_AVX2)
+	static constexpr uint32_t value = (Depth >= 32 ? 256 : 128) / Depth;
+#else
+	static constexpr uint32_t value = 128 / Depth;
+#endif
+};
+
+}
 }
 }
 
 #undef FOR
+#undef EXPECT
 #undef CMP
 #undef CMP1
 #undef ASSVAL
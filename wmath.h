@@ -28,6 +28,8 @@ namespace cc0
 {
 namespace wide
 {
+inline namespace CC0_WIDE_ISA_NAMESPACE
+{
 
 /// @brief Returns the highest value.
 ///
@@ -194,7 +196,7 @@ inline wf wrap(const wf &x)
 template < uint32_t Depth, uint32_t Width >
 inline wf wrap(const wf &x, const wf &max)
 {
-	wf ratio = x / max;
+	wf ratio = x * cc0::wide::rcp(max);
 	return max * cc0::wide::wrap(ratio);
 }
 
@@ -226,45 +228,327 @@ wf pi( void )
 	return pi;
 }*/
 
-#define CC0_WIDE_E        2.7182818 // Euler's number or exp(1)
-#define CC0_WIDE_LN2      0.6931472 // Natural logarithm of 2 or log(2)
-#define CC0_WIDE_LN10     2.3025851 // Natural logarithm of 10 or log(10)
+#define CC0_WIDE_E        2.71828182845904523536 // Euler's number or exp(1)
+#define CC0_WIDE_LN2      0.69314718055994530942 // Natural logarithm of 2 or log(2)
+#define CC0_WIDE_LN10     2.30258509299404568402 // Natural logarithm of 10 or log(10)
+
+#define CC0_WIDE_LOG10E   0.43429448190325182765 // Log of E (Euler's number) at base 10
+#define CC0_WIDE_LOG2E    1.44269504088896340736 // Log of E (Euler's number) at base 2
+
+#define CC0_WIDE_SQRT2    1.41421356237309504880 // Square root of 2 or sqrt(2)
+#define CC0_WIDE_SQRT1_2  0.70710678118654752440 // Square root of 1/2 or sqrt(1/2) or 1/sqrt(2)
 
-#define CC0_WIDE_LOG10E   0.4342945 // Log of E (Euler's number) at base 10
-#define CC0_WIDE_LOG2E    1.4426950 // Log of E (Euler's number) at base 2
+#define CC0_WIDE_PI       3.14159265358979323846 // PI number
+#define CC0_WIDE_PI_2     1.57079632679489661923 // PI/2
+#define CC0_WIDE_PI_4     0.78539816339744830962 // PI/4
+#define CC0_WIDE_1_PI     0.31830988618379067154 // 1/PI
+#define CC0_WIDE_2_PI     0.63661977236758134308 // 2/PI
+#define CC0_WIDE_2_SQRTPI 1.12837916709551257390 // 2/sqrt(PI)
 
-#define CC0_WIDE_SQRT2    1.4142136 // Square root of 2 or sqrt(2)
-#define CC0_WIDE_SQRT1_2  0.7071068 // Square root of 1/2 or sqrt(1/2) or 1/sqrt(2)
 
-#define CC0_WIDE_PI       3.1415927 // PI number
-#define CC0_WIDE_PI_2     1.5707963 // PI/2
-#define CC0_WIDE_PI_4     0.7853982 // PI/4
-#define CC0_WIDE_1_PI     0.3183099 // 1/PI
-#define CC0_WIDE_2_PI     0.6366197 // 2/PI
-#define CC0_WIDE_2_SQRTPI 1.1283792 // 2/sqrt(PI)
+/// @brief Selects the trade-off between speed and precision of the math functions that take it as their first template parameter, e.g. 'sin<precision::fast>(x)'.
+///
+/// @note 'fast' gives an error of around 1e-3 to 1e-4 regardless of the bit depth, which is usually enough for graphics and audio. The error is absolute for sine, cosine, and tangent, and relative for the other functions. 'balanced' gives about two thirds of the significant bits of the type, i.e. a relative error of around 1e-5 for 32-bit and 1e-11 for 64-bit floating-point values. 'accurate', the default, is within a few units in the last place.
+/// @note The 'wide_ulp' tool in the 'bench' directory measures the error of each function and precision, so that the fastest precision meeting a required bound can be chosen.
+enum class precision
+{
+	fast,
+	balanced,
+	accurate
+};
 
 
 /// @brief Returns an approximation of sine of the input floating-point radians.
 ///
+/// @note Uses a parabola with a correction term, with an absolute error of around 1e-3. The same as 'sin<precision::fast>'.
+///
 /// @param rad input floating-point radians.
 ///
 /// @returns the sine.
 ///
-/// @sa cos
-/// @sa tan
-/// @sa asin
+/// @sa sin
+/// @sa cos_approx
 template < uint32_t Depth, uint32_t Width >
-wf sin(wf rad)
+wf sin_approx(wf rad)
 {
 	const wf PI = sf(CC0_WIDE_PI);
 	rad = cc0::wide::wrap(-PI, rad, PI);
 	const wf B = wf(sf(4)) / PI; // Magic value 1
 	const wf C = B / PI;         // Magic value 2
-	const wf sin1 = B * rad - C * rad * cc0::wide::abs(rad);
-	const wf sin  = wf(sf(0.225)) * (sin1 * cc0::wide::abs(sin1) - sin1) + sin1;
+	const wf sin1 = cc0::wide::fnma(C * rad, cc0::wide::abs(rad), B * rad);
+	const wf sin  = cc0::wide::fma(wf(sf(0.225)), cc0::wide::fms(sin1, cc0::wide::abs(sin1), sin1), sin1);
 	return sin;
 }
 
+
+/// @brief Returns an approximation of cosine of the input floating-point radians.
+///
+/// @note See 'sin_approx' for precision. The same as 'cos<precision::fast>'.
+///
+/// @param rad input floating-point radians.
+///
+/// @returns the cosine.
+///
+/// @sa sin_approx
+template < uint32_t Depth, uint32_t Width >
+wf cos_approx(const wf &rad)
+{
+	return cc0::wide::sin_approx(wf(sf(CC0_WIDE_PI_2)) - rad);
+}
+
+
+/// @brief Returns an approximation of tangent of the input floating-point radians.
+///
+/// @note See 'sin_approx' for precision. The same as 'tan<precision::fast>'.
+///
+/// @param rad input floating-point radians.
+///
+/// @returns the tangent.
+///
+/// @sa sin_approx
+template < uint32_t Depth, uint32_t Width >
+wf tan_approx(const wf &rad)
+{
+	return cc0::wide::sin_approx(rad) * cc0::wide::rcp(cc0::wide::cos_approx(rad));
+}
+
+
+/// @brief Evaluates the polynomial 'c0 + c1 * x + c2 * x^2 + ...' via Horner's method.
+template < uint32_t Depth, uint32_t Width >
+inline wf __wide_horner(const wf &, sf c)
+{
+	return wf(c);
+}
+
+template < uint32_t Depth, uint32_t Width, typename... coef_t >
+inline wf __wide_horner(const wf &x, sf c, coef_t... rest)
+{
+	return cc0::wide::fma(x, cc0::wide::__wide_horner(x, rest...), wf(c));
+}
+
+
+/// @brief Precision-dependent constants and polynomials used by the trigonometric functions. The polynomials are fitted at Chebyshev nodes for the reduced range [-PI/4, PI/4].
+///
+/// @note 'limit' is the largest magnitude of the input radians that the reduction handles within the error of the precision. Products of the quadrant and the high part of PI/2 must be exact even without FMA, which bounds the quadrant to 2^16 for 32-bit and 2^20 for 64-bit floating-point values. The fast precision does not use range reduction, see 'sin_approx'.
+template < uint32_t Depth, precision Precision >
+struct __wide_trig {};
+
+template <>
+struct __wide_trig<32,precision::balanced>
+{
+	static constexpr double limit = 1.0e5;
+
+	template < uint32_t Width >
+	static wide_float<32,Width> divide(const wide_float<32,Width> &a, const wide_float<32,Width> &b) { return a * rcp(b); }
+
+	// PI/2 split in two parts, where the high part has few enough bits to multiply by a quadrant exactly.
+	template < uint32_t Width >
+	static wide_float<32,Width> reduce(const wide_float<32,Width> &x, const wide_float<32,Width> &q) { return fnma(q, wide_float<32,Width>(4.83826794896619231321e-4f), fnma(q, wide_float<32,Width>(1.5703125f), x)); }
+
+	/// @brief (sin(x) - x) / x^3 as a function of z = x^2.
+	template < uint32_t Width >
+	static wide_float<32,Width> sin(const wide_float<32,Width> &z) { return __wide_horner(z, -0.16665731001278386, 0.0082118555073082185); }
+
+	/// @brief (cos(x) - 1 + x^2 / 2) / x^4 as a function of z = x^2.
+	template < uint32_t Width >
+	static wide_float<32,Width> cos(const wide_float<32,Width> &z) { return __wide_horner(z, 0.041665495080110332, -0.0013736814061734361); }
+};
+
+template <>
+struct __wide_trig<32,precision::accurate>
+{
+	static constexpr double limit = 1.0e4;
+
+	template < uint32_t Width >
+	static wide_float<32,Width> divide(const wide_float<32,Width> &a, const wide_float<32,Width> &b) { return a / b; }
+
+	// PI/2 split in three parts.
+	template < uint32_t Width >
+	static wide_float<32,Width> reduce(const wide_float<32,Width> &x, const wide_float<32,Width> &q) { return fnma(q, wide_float<32,Width>(7.54978995489188216e-8f), fnma(q, wide_float<32,Width>(4.837512969970703125e-4f), fnma(q, wide_float<32,Width>(1.5703125f), x))); }
+
+	template < uint32_t Width >
+	static wide_float<32,Width> sin(const wide_float<32,Width> &z) { return __wide_horner(z, -0.16666664662314379, 0.0083327482706297487, -0.00019587890880412386); }
+
+	template < uint32_t Width >
+	static wide_float<32,Width> cos(const wide_float<32,Width> &z) { return __wide_horner(z, 0.041666664659502209, -0.0013888303035894866, 2.4547942085071572e-05); }
+};
+
+template <>
+struct __wide_trig<64,precision::balanced>
+{
+	static constexpr double limit = 1.0e6;
+
+	template < uint32_t Width >
+	static wide_float<64,Width> divide(const wide_float<64,Width> &a, const wide_float<64,Width> &b) { return a * rcp(b); }
+
+	template < uint32_t Width >
+	static wide_float<64,Width> reduce(const wide_float<64,Width> &x, const wide_float<64,Width> &q) { return fnma(q, wide_float<64,Width>(6.07710050650619224932e-11), fnma(q, wide_float<64,Width>(1.57079632673412561417e+00), x)); }
+
+	template < uint32_t Width >
+	static wide_float<64,Width> sin(const wide_float<64,Width> &z) { return __wide_horner(z, -0.1666666666385529, 0.0083333318747102082, -0.00019840086735384846, 2.7249925803059792e-06); }
+
+	template < uint32_t Width >
+	static wide_float<64,Width> cos(const wide_float<64,Width> &z) { return __wide_horner(z, 0.0416666666643212, -0.0013888887672016789, 2.4800600377156728e-05, -2.7300959203901469e-07); }
+};
+
+template <>
+struct __wide_trig<64,precision::accurate>
+{
+	static constexpr double limit = 1.0e6;
+
+	template < uint32_t Width >
+	static wide_float<64,Width> divide(const wide_float<64,Width> &a, const wide_float<64,Width> &b) { return a / b; }
+
+	template < uint32_t Width >
+	static wide_float<64,Width> reduce(const wide_float<64,Width> &x, const wide_float<64,Width> &q) { return fnma(q, wide_float<64,Width>(2.02226624879595063154e-21), fnma(q, wide_float<64,Width>(6.07710050630396597660e-11), fnma(q, wide_float<64,Width>(1.57079632673412561417e+00), x))); }
+
+	template < uint32_t Width >
+	static wide_float<64,Width> sin(const wide_float<64,Width> &z) { return __wide_horner(z, -0.16666666666666666, 0.008333333333330948, -0.00019841269836758574, 2.7557316102552439e-06, -2.5051131845003624e-08, 1.5918129294866608e-10); }
+
+	template < uint32_t Width >
+	static wide_float<64,Width> cos(const wide_float<64,Width> &z) { return __wide_horner(z, 0.041666666666666664, -0.0013888888888887398, 2.4801587298765689e-05, -2.7557317271729793e-07, 2.0876146268403199e-09, -1.1382632425521717e-11); }
+};
+
+/// @brief Reduces the input radians to 'r' in [-PI/4, PI/4] via Cody-Waite reduction, and returns the quadrant 'q' such that 'rad = q * PI/2 + r' along with the sine and cosine of 'r'.
+template < precision Precision, uint32_t Depth, uint32_t Width >
+inline wi __wide_sincos_reduce(const wf &rad, wf &s, wf &c)
+{
+	const wf q = cc0::wide::round(rad * sf(CC0_WIDE_2_PI));
+	const wf r = __wide_trig<Depth,Precision>::reduce(rad, q);
+	const wf z = r * r;
+	s = cc0::wide::fma(r * z, __wide_trig<Depth,Precision>::sin(z), r);
+	c = cc0::wide::fma(z * z, __wide_trig<Depth,Precision>::cos(z), cc0::wide::fnma(z, wf(sf(0.5)), wf(sf(1))));
+	return wi(q);
+}
+
+
+/// @brief Maps the sine and cosine of the reduced radians to the sine of the input in the given quadrant.
+template < uint32_t Depth, uint32_t Width >
+inline wf __wide_sin_quadrant(const wi &q, const wf &s, const wf &c)
+{
+	const wf o = cc0::wide::cmov((q & si(1)) != si(0), c, s);
+	return cc0::wide::cmov((q & si(2)) != si(0), -o, o);
+}
+
+
+/// @brief Maps the sine and cosine of the reduced radians to the cosine of the input in the given quadrant.
+template < uint32_t Depth, uint32_t Width >
+inline wf __wide_cos_quadrant(const wi &q, const wf &s, const wf &c)
+{
+	const wf o = cc0::wide::cmov((q & si(1)) != si(0), s, c);
+	return cc0::wide::cmov(((q + si(1)) & si(2)) != si(0), -o, o);
+}
+
+
+/// @brief Replaces the lanes of 'o' where the mask is true with the serial function applied to the same lanes of 'x'. Handles the rare inputs outside the range of a vectorized implementation one lane at a time.
+template < typename function_t, uint32_t Depth, uint32_t Width >
+inline wf __wide_serial_lanes(const wf &o, const wf &x, const wb &mask, function_t function)
+{
+	const uint64_t m = cc0::wide::movemask(mask);
+	if (m == 0) {
+		return o;
+	}
+	sf xs[Width];
+	sf os[Width];
+	cc0::wide::store(xs, x);
+	cc0::wide::store(os, o);
+	for (uint32_t i = 0; i < Width; ++i) {
+		if ((m >> i) & 1) {
+			os[i] = function(xs[i]);
+		}
+	}
+	return cc0::wide::load<wf>(os);
+}
+
+
+/// @brief Implements the trigonometric functions of a precision via range reduction. Lanes with a magnitude beyond the limit of the reduction are computed with the serial functions instead.
+template < precision Precision >
+struct __wide_sincos
+{
+	template < uint32_t Depth, uint32_t Width >
+	static wb beyond(const wf &rad) { return cc0::wide::abs(rad) > sf(__wide_trig<Depth,Precision>::limit); }
+
+	template < uint32_t Depth, uint32_t Width >
+	static wf sin(const wf &rad)
+	{
+		const wb large = __wide_sincos::beyond(rad);
+		wf s, c;
+		const wi q = cc0::wide::__wide_sincos_reduce<Precision>(cc0::wide::cmov(large, wf(sf(0)), rad), s, c);
+		return cc0::wide::__wide_serial_lanes(cc0::wide::__wide_sin_quadrant(q, s, c), rad, large, [](sf x) { return std::sin(x); });
+	}
+
+	template < uint32_t Depth, uint32_t Width >
+	static wf cos(const wf &rad)
+	{
+		const wb large = __wide_sincos::beyond(rad);
+		wf s, c;
+		const wi q = cc0::wide::__wide_sincos_reduce<Precision>(cc0::wide::cmov(large, wf(sf(0)), rad), s, c);
+		return cc0::wide::__wide_serial_lanes(cc0::wide::__wide_cos_quadrant(q, s, c), rad, large, [](sf x) { return std::cos(x); });
+	}
+
+	template < uint32_t Depth, uint32_t Width >
+	static void sincos(const wf &rad, wf &s, wf &c)
+	{
+		const wb large = __wide_sincos::beyond(rad);
+		wf rs, rc;
+		const wi q = cc0::wide::__wide_sincos_reduce<Precision>(cc0::wide::cmov(large, wf(sf(0)), rad), rs, rc);
+		s = cc0::wide::__wide_serial_lanes(cc0::wide::__wide_sin_quadrant(q, rs, rc), rad, large, [](sf x) { return std::sin(x); });
+		c = cc0::wide::__wide_serial_lanes(cc0::wide::__wide_cos_quadrant(q, rs, rc), rad, large, [](sf x) { return std::cos(x); });
+	}
+
+	template < uint32_t Depth, uint32_t Width >
+	static wf tan(const wf &rad)
+	{
+		const wb large = __wide_sincos::beyond(rad);
+		wf s, c;
+		const wi q   = cc0::wide::__wide_sincos_reduce<Precision>(cc0::wide::cmov(large, wf(sf(0)), rad), s, c);
+		const wb odd = (q & si(1)) != si(0);
+		return cc0::wide::__wide_serial_lanes(__wide_trig<Depth,Precision>::divide(cc0::wide::cmov(odd, -c, s), cc0::wide::cmov(odd, s, c)), rad, large, [](sf x) { return std::tan(x); });
+	}
+};
+
+template <>
+struct __wide_sincos<precision::fast>
+{
+	template < uint32_t Depth, uint32_t Width >
+	static wf sin(const wf &rad) { return cc0::wide::sin_approx(rad); }
+
+	template < uint32_t Depth, uint32_t Width >
+	static wf cos(const wf &rad) { return cc0::wide::cos_approx(rad); }
+
+	template < uint32_t Depth, uint32_t Width >
+	static void sincos(const wf &rad, wf &s, wf &c)
+	{
+		s = cc0::wide::sin_approx(rad);
+		c = cc0::wide::cos_approx(rad);
+	}
+
+	template < uint32_t Depth, uint32_t Width >
+	static wf tan(const wf &rad) { return cc0::wide::tan_approx(rad); }
+};
+
+
+/// @brief Returns the sine of the input floating-point radians.
+///
+/// @note Reduces the input to the range [-PI/4, PI/4] and evaluates a polynomial, so the cost is the same for all inputs. The accurate error is within a few units in the last place, and the balanced precision uses a coarser reduction and shorter polynomials. Since the reduction uses a finite-precision PI, it is only used up to a magnitude of 1e4 (accurate) or 1e5 (balanced) for 32-bit floating-point values, and 1e6 for 64-bit floating-point values. Lanes beyond that, including infinities, are computed one at a time with 'std::sin', which is slow but correct. The fast precision uses 'sin_approx', which does not reduce the input and loses precision with the magnitude of the input.
+///
+/// @param rad input floating-point radians.
+///
+/// @returns the sine.
+///
+/// @sa precision
+/// @sa sin_approx
+/// @sa sincos
+/// @sa cos
+/// @sa tan
+/// @sa asin
+template < precision Precision, uint32_t Depth, uint32_t Width >
+wf sin(const wf &rad)
+{
+	return cc0::wide::__wide_sincos<Precision>::sin(rad);
+}
+
+
 #define F0(x) (A * ((B * x - C * x * x) * cc0::wide::abs(B * x - C * x * x) - (B * x - C * x * x)) + (B * x - C * x * x) - S)
 #define F1(x) ((B - D * C * x) * (A * cc0::wide::abs(B - D * C * x) - A - D * C * x))
 
@@ -326,35 +610,258 @@ wf asin_bs(wf S)
 
 /// @brief Returns the cosine of the input floating-point radians.
 ///
+/// @note See 'sin' for precision.
+///
 /// @param rad input floating-point radians.
 ///
 /// @returns the cosine.
 ///
+/// @sa precision
+/// @sa cos_approx
+/// @sa sincos
 /// @sa sin
 /// @sa tan
 /// @sa acos
-template < uint32_t Depth, uint32_t Width >
+template < precision Precision, uint32_t Depth, uint32_t Width >
 wf cos(const wf &rad)
 {
-	return cc0::wide::sin(wf(CC0_WIDE_PI_2) - rad);
+	return cc0::wide::__wide_sincos<Precision>::cos(rad);
+}
+
+
+/// @brief Returns both the sine and cosine of the input floating-point radians.
+///
+/// @note Shares the range reduction and polynomial evaluation between both results, so it costs about the same as a single call to 'sin'. See 'sin' for precision and range.
+///
+/// @param rad input floating-point radians.
+/// @param s the output sine.
+/// @param c the output cosine.
+///
+/// @sa precision
+/// @sa sin
+/// @sa cos
+template < precision Precision, uint32_t Depth, uint32_t Width >
+void sincos(const wf &rad, wf &s, wf &c)
+{
+	cc0::wide::__wide_sincos<Precision>::sincos(rad, s, c);
 }
 
 
 /// @brief Returns the tangent of the input floating-point radians.
 ///
+/// @note See 'sin' for precision and range. The balanced precision uses a reciprocal rather than a division.
+///
 /// @param rad input floating-point radians.
 ///
 /// @returns the tangent.
 ///
+/// @sa precision
+/// @sa tan_approx
 /// @sa sin
 /// @sa cos
 /// @sa atan
-template < uint32_t Depth, uint32_t Width >
+template < precision Precision, uint32_t Depth, uint32_t Width >
 wf tan(const wf &rad)
 {
-	return cc0::wide::sin(rad) / cc0::wide::cos(rad);
+	return cc0::wide::__wide_sincos<Precision>::tan(rad);
 }
 
+
+/// @brief Precision-dependent constants and polynomials used by the inverse trigonometric functions. The polynomials are fitted at Chebyshev nodes. The constants are shared between all precisions.
+template < uint32_t Depth, precision Precision >
+struct __wide_atrig {};
+
+template <>
+struct __wide_atrig<32,precision::accurate>
+{
+	// PI/4 split into the nearest representable value and the remainder. Multiples of PI/4 are built from these exactly.
+	static constexpr double PIO4_HI = 0.78539818525314331;
+	static constexpr double PIO4_LO = -2.1855695000931213e-08;
+
+	/// @brief (asin(x) - x) / x^3 as a function of z = x^2 for x in [0, 1/2].
+	template < uint32_t Width >
+	static wide_float<32,Width> asin(const wide_float<32,Width> &z) { return __wide_horner(z, 0.16666672414795305, 0.074988550726008213, 0.045001380069910168, 0.026554542206161328, 0.038085023561092654); }
+
+	/// @brief (atan(x) - x) / x^3 as a function of z = x^2 for x in [0, sqrt(2) - 1].
+	template < uint32_t Width >
+	static wide_float<32,Width> atan(const wide_float<32,Width> &z) { return __wide_horner(z, -0.33333331761168522, 0.19999540483648964, -0.1426395559798464, 0.10743731490791084, -0.064519282081217488); }
+};
+
+template <>
+struct __wide_atrig<32,precision::balanced> : __wide_atrig<32,precision::accurate>
+{
+	template < uint32_t Width >
+	static wide_float<32,Width> asin(const wide_float<32,Width> &z) { return __wide_horner(z, 0.16668672109548313, 0.073571092325322843, 0.058975638902380403); }
+
+	template < uint32_t Width >
+	static wide_float<32,Width> atan(const wide_float<32,Width> &z) { return __wide_horner(z, -0.33331896557788776, 0.19848097811084561, -0.11819444409574102); }
+};
+
+template <>
+struct __wide_atrig<64,precision::accurate>
+{
+	static constexpr double PIO4_HI = 0.78539816339744828;
+	static constexpr double PIO4_LO = 3.061616997868383e-17;
+
+	template < uint32_t Width >
+	static wide_float<64,Width> asin(const wide_float<64,Width> &z) { return __wide_horner(z, 0.16666666666666649, 0.075000000000207637, 0.044642857103423646, 0.03038194736709848, 0.02237204763174451, 0.017355259955786323, 0.013929652902326633, 0.011875494382636922, 0.0078029494773533175, 0.016035514349148822, -0.010749050339697808, 0.028169218060881414); }
+
+	template < uint32_t Width >
+	static wide_float<64,Width> atan(const wide_float<64,Width> &z) { return __wide_horner(z, -0.33333333333333331, 0.19999999999995521, -0.14285714284666542, 0.11111111015256361, -0.090909045781239026, 0.076921831908260865, -0.066645114473819475, 0.0585814891280221, -0.050854497379402598, 0.039231658295587189, -0.01917688711906226); }
+};
+
+template <>
+struct __wide_atrig<64,precision::balanced> : __wide_atrig<64,precision::accurate>
+{
+	template < uint32_t Width >
+	static wide_float<64,Width> asin(const wide_float<64,Width> &z) { return __wide_horner(z, 0.16666666665495086, 0.075000005988290486, 0.044642358484883196, 0.030397634130580702, 0.022132443623426794, 0.019306260869368045, 0.0054431851027481075, 0.02930523970533579); }
+
+	template < uint32_t Width >
+	static wide_float<64,Width> atan(const wide_float<64,Width> &z) { return __wide_horner(z, -0.33333333331440729, 0.19999998917288581, -0.14285612511387016, 0.11107495135714474, -0.090289835003504626, 0.071353251223306782, -0.040432248258871609); }
+};
+
+template < uint32_t Depth >
+struct __wide_atrig<Depth,precision::fast> : __wide_atrig<Depth,precision::accurate>
+{
+	template < uint32_t Width >
+	static wide_float<Depth,Width> asin(const wide_float<Depth,Width> &z) { return __wide_horner(z, 0.16624707563367838, 0.088136890318505676); }
+
+	template < uint32_t Width >
+	static wide_float<Depth,Width> atan(const wide_float<Depth,Width> &z) { return __wide_horner(z, -0.33287015110902896, 0.17804508440924025); }
+};
+
+
+/// @brief Returns the magnitude of 'x' with the sign of 's'.
+template < uint32_t Depth, uint32_t Width >
+inline wf __wide_copysign(const wf &x, const wf &s)
+{
+	const wi sign = std::numeric_limits<si>::min();
+	return cc0::wide::bit_cast<wf>((cc0::wide::bit_cast<wi>(x) & ~sign) | (cc0::wide::bit_cast<wi>(s) & sign));
+}
+
+
+/// @brief Returns 'asin(w)' where 'w = a' for 'a' in [0, 1/2], and 'w = sqrt((1 - a) / 2)' otherwise, in which case 'big' is set.
+template < precision Precision, uint32_t Depth, uint32_t Width >
+inline wf __wide_asin_reduce(const wf &a, wb &big)
+{
+	big = a > sf(0.5);
+	const wf h = cc0::wide::fnma(a, wf(sf(0.5)), wf(sf(0.5)));
+	const wf w = cc0::wide::cmov(big, cc0::wide::sqrt(h), a);
+	const wf z = cc0::wide::cmov(big, h, a * a);
+	return cc0::wide::fma(w * z, __wide_atrig<Depth,Precision>::asin(z), w);
+}
+
+
+/// @brief Returns 'atan(n / d)' for non-negative 'n' and 'd'. The ratio is reduced to [-(sqrt(2) - 1), sqrt(2) - 1] by subtracting 0, PI/4, or PI/2, using a single division.
+template < precision Precision, uint32_t Depth, uint32_t Width >
+inline wf __wide_atan_reduce(const wf &n, const wf &d)
+{
+	const wb q2 = n > d * sf(2.41421356237309504880);  // tan(3*PI/8)
+	const wb q1 = n > d * sf(0.41421356237309504880);  // tan(PI/8)
+	const wf num = cc0::wide::cmov(q2, -d, cc0::wide::cmov(q1, n - d, n));
+	const wf den = cc0::wide::cmov(q2, n, cc0::wide::cmov(q1, n + d, d));
+	const wf q = cc0::wide::cmov(q2, wf(sf(2)), cc0::wide::cmov(q1, wf(sf(1)), wf(sf(0))));
+	const wf t = num / den;
+	const wf z = t * t;
+	const wf p = cc0::wide::fma(t * z, __wide_atrig<Depth,Precision>::atan(z), cc0::wide::fma(q, wf(sf(__wide_atrig<Depth,Precision>::PIO4_LO)), t));
+	return cc0::wide::fma(q, wf(sf(__wide_atrig<Depth,Precision>::PIO4_HI)), p);
+}
+
+
+/// @brief Returns the arc sine of the input.
+///
+/// @note Evaluates a polynomial, using the identity 'asin(x) = PI/2 - 2 * asin(sqrt((1 - x) / 2))' for inputs above 1/2, so the cost is the same for all inputs. The accurate error is within a few units in the last place, while the other precisions use shorter polynomials. Inputs outside [-1, 1] return NaN.
+///
+/// @param x the sine of an angle.
+///
+/// @returns the angle in radians in the range [-PI/2, PI/2].
+///
+/// @sa precision
+/// @sa acos
+/// @sa sin
+template < precision Precision, uint32_t Depth, uint32_t Width >
+wf asin(const wf &x)
+{
+	const wf PIO2_HI = sf(2 * __wide_atrig<Depth,Precision>::PIO4_HI);
+	const wf PIO2_LO = sf(2 * __wide_atrig<Depth,Precision>::PIO4_LO);
+	wb big;
+	const wf p = cc0::wide::__wide_asin_reduce<Precision>(cc0::wide::abs(x), big);
+	return cc0::wide::__wide_copysign(cc0::wide::cmov(big, PIO2_HI - (p + p - PIO2_LO), p), x);
+}
+
+
+/// @brief Returns the arc cosine of the input.
+///
+/// @note See 'asin' for precision. Inputs outside [-1, 1] return NaN.
+///
+/// @param x the cosine of an angle.
+///
+/// @returns the angle in radians in the range [0, PI].
+///
+/// @sa precision
+/// @sa asin
+/// @sa cos
+template < precision Precision, uint32_t Depth, uint32_t Width >
+wf acos(const wf &x)
+{
+	const wf PIO2_HI = sf(2 * __wide_atrig<Depth,Precision>::PIO4_HI);
+	const wf PIO2_LO = sf(2 * __wide_atrig<Depth,Precision>::PIO4_LO);
+	const wf PI_HI   = sf(4 * __wide_atrig<Depth,Precision>::PIO4_HI);
+	const wf PI_LO   = sf(4 * __wide_atrig<Depth,Precision>::PIO4_LO);
+	wb big;
+	const wf p  = cc0::wide::__wide_asin_reduce<Precision>(cc0::wide::abs(x), big);
+	const wb neg = x < sf(0);
+	const wf p2 = p + p;
+	return cc0::wide::cmov(big, cc0::wide::cmov(neg, PI_HI - (p2 - PI_LO), p2), PIO2_HI - (cc0::wide::cmov(neg, -p, p) - PIO2_LO));
+}
+
+
+/// @brief Returns the arc tangent of the input.
+///
+/// @note Reduces the input to [-(sqrt(2) - 1), sqrt(2) - 1] and evaluates a polynomial, so the cost is the same for all inputs. The accurate error is within a few units in the last place, while the other precisions use shorter polynomials.
+///
+/// @param x the tangent of an angle.
+///
+/// @returns the angle in radians in the range [-PI/2, PI/2].
+///
+/// @sa precision
+/// @sa atan2
+/// @sa tan
+template < precision Precision, uint32_t Depth, uint32_t Width >
+wf atan(const wf &x)
+{
+	return cc0::wide::__wide_copysign(cc0::wide::__wide_atan_reduce<Precision>(cc0::wide::abs(x), wf(sf(1))), x);
+}
+
+
+/// @brief Returns the arc tangent of 'y / x', using the signs of both inputs to determine the quadrant.
+///
+/// @note See 'atan' for precision. Follows the C standard for signed zeros and infinities, i.e. 'atan2(0, -0)' is PI and 'atan2(inf, inf)' is PI/4.
+///
+/// @param y the y coordinate.
+/// @param x the x coordinate.
+///
+/// @returns the angle in radians in the range [-PI, PI].
+///
+/// @sa precision
+/// @sa atan
+template < precision Precision, uint32_t Depth, uint32_t Width >
+wf atan2(const wf &y, const wf &x)
+{
+	const wf PI_HI = sf(4 * __wide_atrig<Depth,Precision>::PIO4_HI);
+	const wf PI_LO = sf(4 * __wide_atrig<Depth,Precision>::PIO4_LO);
+	const wf inf   = std::numeric_limits<sf>::infinity();
+	const wf ay    = cc0::wide::abs(y);
+	const wf ax    = cc0::wide::abs(x);
+
+	wf r = cc0::wide::__wide_atan_reduce<Precision>(ay, ax);
+	r = cc0::wide::cmov((ay == inf) & (ax == inf), wf(sf(CC0_WIDE_PI_4)), r);
+	r = cc0::wide::cmov((ay == sf(0)) & (ax == sf(0)), wf(sf(0)), r);
+	r = cc0::wide::cmov(cc0::wide::bit_cast<wi>(x) < si(0), (PI_HI - r) + PI_LO, r);
+	return cc0::wide::__wide_copysign(r, y);
+}
+
+
 /*template < uint32_t Depth, uint32_t Width >
 wf sqrt_nr(const wf &x)
 {
@@ -425,26 +932,27 @@ wf sqrt_bs(const wf &x)
 
 /// @brief Returns the square root of the input floating-point number via Newton-Raphson method.
 ///
+/// @note Iterates until all lanes converge, so the slowest lane dictates the runtime. Prefer 'sqrt', which has a fixed latency.
+///
 /// @param x input floating-point value.
 ///
 /// @returns the square root.
 ///
+/// @sa sqrt
 /// @sa sqrt_bs
 template < uint32_t Depth, uint32_t Width >
 wf sqrt_nr(const wf &x)
 {
 	const wb not_nan = (x >= sf(0.0));
+	const wf diff = eps;
+	const wf half = sf(0.5);
 	wf guess = 1;
-	if (not_nan) {
-		const wf diff = eps;
-		const wf half = sf(0.5);
-		wf last_guess;
-		wb m = not_nan;
-		do {
-			last_guess = guess;
-			guess = cc0::wide::cmov(m, (x / guess + guess) * half, guess);
-		} while (m &= (last_guess != guess && cc0::wide::abs(guess * guess - x) >= diff));
-	}
+	wf last_guess;
+	wb mask = not_nan;
+	CC0_WIDE_DOWHILE
+		last_guess = guess;
+		guess = CC0_WIDE_SET((x / guess + guess) * half);
+	CC0_WIDE_END_DOWHILE(last_guess != guess && cc0::wide::abs(guess * guess - x) >= diff)
 	guess = cc0::wide::cmov(not_nan, guess, nan);
 	return guess;
 }
@@ -452,10 +960,13 @@ wf sqrt_nr(const wf &x)
 
 /// @brief Returns the square root of the input floating-point number via a binary partitioning method.
 ///
+/// @note Iterates until all lanes converge, so the slowest lane dictates the runtime. Prefer 'sqrt', which has a fixed latency.
+///
 /// @param x input floating-point value.
 ///
 /// @returns the square root.
 ///
+/// @sa sqrt
 /// @sa sqrt_nr
 template < uint32_t Depth, uint32_t Width >
 wf sqrt_bs(const wf &x)
@@ -485,7 +996,7 @@ wf sqrt_bs(const wf &x)
 	}
 
 	m0 = not_nan;
-	for (int i = 0 ; i < Depth; ++i){
+	for (uint32_t i = 0 ; i < Depth; ++i){
 		mid = cc0::wide::cmov(m0, (lo + hi) * half, mid);
 
 		m0 &= !(mid * mid == x);
@@ -513,7 +1024,7 @@ wf sqrt_bs(const wf &x)
 template < uint32_t Depth, uint32_t Width >
 wb even(const wi &x)
 {
-	return (x % wi(si(2))) == wi(si(0));
+	return (x & si(1)) == si(0);
 }
 
 
@@ -527,7 +1038,7 @@ wb even(const wi &x)
 template < uint32_t Depth, uint32_t Width >
 wb odd(const wi &x)
 {
-	return (x % wi(si(2))) == wi(si(1));
+	return (x & si(1)) != si(0);
 }
 
 /*template < uint32_t Depth, uint32_t Width >
@@ -569,44 +1080,400 @@ wf pow(wf x, wi n)
 ///
 /// @param n input integer value.
 ///
-/// @returns the base-2 logarithm of the integer.
+/// @returns the base-2 logarithm of the integer, rounded down. Returns -1 for zero and negative values.
+///
+/// @note Runs in constant time regardless of the input values.
 ///
 /// @sa log10
+/// @sa bit_width
 template < uint32_t Depth, uint32_t Width >
 wi log2(wi n)
 {
-	wb m0 = true;
-	wi logValue = si(-1);
-	while ((m0 &= (n != 0))) {
-		logValue = cc0::wide::cmov(m0, logValue + wi(1), logValue);
-		n = cc0::wide::cmov(m0, n >> 1, n);
-	}
-	return logValue;
+	return cc0::wide::cmov(n > si(0), cc0::wide::bit_width(n) - si(1), wi(si(-1)));
 }
 
 
 /// @brief Returns the base-10 logarithm of the input integer.
 ///
-/// @param b input integer value.
+/// @param n input integer value.
+///
+/// @returns the base-10 logarithm of the integer, rounded down. Returns -1 for zero and negative values.
 ///
-/// @returns the base-10 logarithm of the integer.
+/// @note Compares the input against each power of ten that fits the type, which the compiler unrolls into constants, so it runs in constant time regardless of the input values.
 ///
 /// @sa log2
 template < uint32_t Depth, uint32_t Width >
 wi log10(const wi &n)
 {
-	return cc0::wide::log2(n) / cc0::wide::log2<Depth,Width>(10);
+	wi o = cc0::wide::cmov(n > si(0), wi(si(0)), wi(si(-1)));
+	for (uint64_t p = 10; p <= uint64_t(std::numeric_limits<si>::max()); p *= 10) {
+		o = o + cc0::wide::cmov(n >= wi(si(p)), wi(si(1)), wi(si(0)));
+	}
+	return o;
+}
+
+
+/// @brief Precision-dependent constants and polynomials used by the exponential and logarithmic functions. The polynomials are fitted at Chebyshev nodes, which closely approximates a minimax fit. The constants are shared between all precisions.
+template < uint32_t Depth, precision Precision >
+struct __wide_explog {};
+
+template <>
+struct __wide_explog<32,precision::accurate>
+{
+	// Cody-Waite split of ln(2), where the high part has few enough bits to multiply by an exponent exactly.
+	static constexpr double LN2_HI = 0.693359375;
+	static constexpr double LN2_LO = -2.12194440054690583e-4;
+
+	// log2(e) split in two parts, where the high part has the significant bits kept by __wide_split_high.
+	static constexpr double LOG2E_HI = 1.4423828125;
+	static constexpr double LOG2E_LO = 3.1222839606925845e-4;
+
+	/// @brief (exp(r) - 1 - r) / r^2 for r in [-ln(2)/2, ln(2)/2].
+	template < uint32_t Width >
+	static wide_float<32,Width> exp(const wide_float<32,Width> &r) { return __wide_horner(r, 0.5, 0.16666577025597989, 0.041666554662050534, 0.008363173074513711, 0.0013926176119935579); }
+
+	/// @brief (2^f - 1) / f for f in [-1/2, 1/2].
+	template < uint32_t Width >
+	static wide_float<32,Width> exp2(const wide_float<32,Width> &f) { return __wide_horner(f, 0.69314718802622877, 0.24022650760568126, 0.055503571142190782, 0.0096180825572778524, 0.0013390863364671234, 0.00015453162945120691); }
+
+	/// @brief (log((1 + s) / (1 - s)) - 2s) / s^3 as a function of z = s^2 for m = (1 + s) / (1 - s) in [sqrt(1/2), sqrt(2)].
+	template < uint32_t Width >
+	static wide_float<32,Width> log(const wide_float<32,Width> &z) { return __wide_horner(z, 0.66666666554497089, 0.40000121839806124, 0.28550820815960665, 0.23330467216303835); }
+};
+
+template <>
+struct __wide_explog<32,precision::balanced> : __wide_explog<32,precision::accurate>
+{
+	template < uint32_t Width >
+	static wide_float<32,Width> exp(const wide_float<32,Width> &r) { return __wide_horner(r, 0.49999748990027465, 0.16666630825186785, 0.041833804078406464, 0.0083572001484456676); }
+
+	template < uint32_t Width >
+	static wide_float<32,Width> exp2(const wide_float<32,Width> &f) { return __wide_horner(f, 0.69313673388362151, 0.24022530097412242, 0.055838282946219855, 0.0096567102885443557); }
+
+	template < uint32_t Width >
+	static wide_float<32,Width> log(const wide_float<32,Width> &z) { return __wide_horner(z, 0.66663499454944741, 0.4085826936143872); }
+};
+
+template <>
+struct __wide_explog<64,precision::accurate>
+{
+	static constexpr double LN2_HI = 6.93147180369123816490e-01;
+	static constexpr double LN2_LO = 1.90821492927058770002e-10;
+
+	static constexpr double LOG2E_HI = 1.4426950216293335;
+	static constexpr double LOG2E_LO = 1.9259629911266175e-08;
+
+	template < uint32_t Width >
+	static wide_float<64,Width> exp(const wide_float<64,Width> &r) { return __wide_horner(r, 0.5, 0.16666666666666671, 0.041666666666666671, 0.0083333333333261411, 0.0013888888888883752, 0.00019841269874800493, 2.4801587325533363e-05, 2.7557255425746435e-06, 2.7557273661348637e-07, 2.5105206373957011e-08, 2.0914679376583935e-09); }
+
+	template < uint32_t Width >
+	static wide_float<64,Width> exp2(const wide_float<64,Width> &f) { return __wide_horner(f, 0.69314718055994529, 0.24022650695910072, 0.055504108664821625, 0.0096181291076284803, 0.0013333558146406471, 0.00015403530393370734, 1.5252733841556773e-05, 1.3215486808705563e-06, 1.0178057087733941e-07, 7.0548973041554995e-09, 4.4558179083360645e-10, 2.5729324177362305e-11); }
+
+	template < uint32_t Width >
+	static wide_float<64,Width> log(const wide_float<64,Width> &z) { return __wide_horner(z, 0.66666666666666663, 0.40000000000000879, 0.28571428570803614, 0.22222222391713917, 0.18181795640132906, 0.15386239702814658, 0.13268773138656886, 0.13086626147840102); }
+};
+
+template <>
+struct __wide_explog<64,precision::balanced> : __wide_explog<64,precision::accurate>
+{
+	template < uint32_t Width >
+	static wide_float<64,Width> exp(const wide_float<64,Width> &r) { return __wide_horner(r, 0.5, 0.16666666718997508, 0.041666666718980845, 0.0083332984837548862, 0.001388885404961482, 0.00019899273958649361, 2.4859578222625295e-05); }
+
+	template < uint32_t Width >
+	static wide_float<64,Width> exp2(const wide_float<64,Width> &f) { return __wide_horner(f, 0.69314718055683244, 0.24022650695888503, 0.055504109063258665, 0.0096181291352361396, 0.0013333478473685416, 0.00015403475186530786, 1.5303700711365693e-05, 1.325080551750225e-06); }
+
+	template < uint32_t Width >
+	static wide_float<64,Width> log(const wide_float<64,Width> &z) { return __wide_horner(z, 0.66666666554497089, 0.40000121839806124, 0.28550820815960665, 0.23330467216303835); }
+};
+
+template < uint32_t Depth >
+struct __wide_explog<Depth,precision::fast> : __wide_explog<Depth,precision::accurate>
+{
+	template < uint32_t Width >
+	static wide_float<Depth,Width> exp(const wide_float<Depth,Width> &r) { return __wide_horner(r, 0.5, 0.16741898669505059, 0.041791986112873949); }
+
+	template < uint32_t Width >
+	static wide_float<Depth,Width> exp2(const wide_float<Depth,Width> &f) { return __wide_horner(f, 0.69314718055994529, 0.24203533019054099, 0.055754649780458437); }
+
+	template < uint32_t Width >
+	static wide_float<Depth,Width> log(const wide_float<Depth,Width> &z) { return __wide_horner(z, 0.6726167307481199); }
+};
+
+
+/// @brief Returns 'x * 2^n' for 'n' in the range where both 2^(n/2) and 2^(n-n/2) are normal floating-point numbers, which covers all results from subnormal to overflow.
+template < uint32_t Depth, uint32_t Width >
+inline wf __wide_scale2(const wf &x, const wi &n)
+{
+	const int M = std::numeric_limits<sf>::digits - 1;
+	const wi  B = si(std::numeric_limits<sf>::max_exponent - 1);
+	const wi  n1 = n >> 1;
+	const wi  n2 = n - n1;
+	return x * cc0::wide::bit_cast<wf>((n1 + B) << M) * cc0::wide::bit_cast<wf>((n2 + B) << M);
+}
+
+
+/// @brief Returns 'm' and 'e' for 'x = m * 2^e' where 'm' is in the range [sqrt(1/2), sqrt(2)). Only valid for positive, finite 'x'.
+template < uint32_t Depth, uint32_t Width >
+inline wf __wide_log_mantissa(const wf &x, wf &e)
+{
+	const int M = std::numeric_limits<sf>::digits - 1;
+	const si  B = si(std::numeric_limits<sf>::max_exponent - 1);
+
+	// Scale subnormal values into the normal range.
+	const wb sub = x < std::numeric_limits<sf>::min();
+	const wf xs  = cc0::wide::cmov(sub, x * sf(si(1) << (M + 1)), x);
+
+	const wi bits = cc0::wide::bit_cast<wi>(xs);
+	wi       ei   = ((bits >> M) & wi(si(2 * B + 1))) - wi(B);
+	wf       m    = cc0::wide::bit_cast<wf>((bits & wi(si((si(1) << M) - 1))) | wi(si(B << M)));
+
+	const wb big = m > sf(CC0_WIDE_SQRT2);
+	m  = cc0::wide::cmov(big, m * sf(0.5), m);
+	ei = cc0::wide::cmov(big, ei + si(1), ei);
+	e  = wf(ei) - cc0::wide::cmov(sub, wf(sf(M + 1)), wf(sf(0)));
+	return m;
+}
+
+
+/// @brief Returns 'e' and 'log(m)' for 'x = m * 2^e' where 'm' is in the range [sqrt(1/2), sqrt(2)). Only valid for positive, finite 'x'.
+template < precision Precision, uint32_t Depth, uint32_t Width >
+inline wf __wide_log_reduce(const wf &x, wf &e)
+{
+	const wf m = cc0::wide::__wide_log_mantissa(x, e);
+	const wf s = (m - sf(1)) / (m + sf(1));
+	const wf z = s * s;
+	return cc0::wide::fma(s * z, __wide_explog<Depth,Precision>::log(z), s + s);
+}
+
+
+/// @brief Clears the lower half of the significand bits, so that the product of two such values is exact.
+template < uint32_t Depth, uint32_t Width >
+inline wf __wide_split_high(const wf &x)
+{
+	const int K = (std::numeric_limits<sf>::digits + 1) / 2;
+	return cc0::wide::bit_cast<wf>(cc0::wide::bit_cast<wu>(x) & wu(su(~((su(1) << K) - 1))));
+}
+
+
+/// @brief Returns the base-2 logarithm of the input as the sum of 'hi' and 'lo', where 'hi' has the significant bits kept by __wide_split_high, and 'lo' holds the bits beyond the precision of the type. Only valid for positive, finite 'x'.
+///
+/// @note log(1 + f) is computed as 'f - f^2/2 + s * (f^2/2 + R)', where the leading terms are split into high and low parts as in the FreeBSD and musl implementations of log2.
+template < precision Precision, uint32_t Depth, uint32_t Width >
+inline wf __wide_log2_split(const wf &x, wf &lo)
+{
+	wf e;
+	const wf f    = cc0::wide::__wide_log_mantissa(x, e) - sf(1);
+	const wf hfsq = sf(0.5) * f * f;
+	const wf s    = f / (f + sf(2));
+	const wf z    = s * s;
+	const wf r    = z * __wide_explog<Depth,Precision>::log(z);
+	const wf h    = cc0::wide::__wide_split_high(f - hfsq);
+	const wf l    = ((f - h) - hfsq) + s * (hfsq + r);
+
+	// Multiplies 'h + l' by log2(e), where the product of the high parts is exact, and adds the exponent.
+	const wf vh = h * sf(__wide_explog<Depth,Precision>::LOG2E_HI);
+	const wf vl = (l + h) * sf(__wide_explog<Depth,Precision>::LOG2E_LO) + l * sf(__wide_explog<Depth,Precision>::LOG2E_HI);
+	const wf w  = e + vh;
+	const wf wl = ((e - w) + vh) + vl;
+
+	const wf hi = cc0::wide::__wide_split_high(w + wl);
+	lo = (w - hi) + wl;
+	return hi;
+}
+
+
+/// @brief Applies the special cases of the logarithmic functions; NaN for negative inputs and NaN, negative infinity for zero, and infinity for infinity.
+template < uint32_t Depth, uint32_t Width >
+inline wf __wide_log_special(const wf &x, const wf &y)
+{
+	const wf inf = std::numeric_limits<sf>::infinity();
+	wf o = y;
+	o = cc0::wide::cmov(x == inf, inf, o);
+	o = cc0::wide::cmov(x == sf(0), -inf, o);
+	o = cc0::wide::cmov((x < sf(0)) | (x != x), nan, o);
+	return o;
+}
+
+
+/// @brief Returns 'e' (Euler's number) raised to the input.
+///
+/// @note Reduces the input to the range [-ln(2)/2, ln(2)/2] via Cody-Waite reduction and evaluates a polynomial, so the cost is the same for all inputs. The accurate relative error is within a few units in the last place, while the other precisions use shorter polynomials.
+///
+/// @param x the exponent.
+///
+/// @returns the exponential.
+///
+/// @sa precision
+/// @sa exp2
+/// @sa log
+template < precision Precision, uint32_t Depth, uint32_t Width >
+wf exp(const wf &x)
+{
+	const wf hi = sf((std::numeric_limits<sf>::max_exponent + 1) * CC0_WIDE_LN2);
+	const wf lo = sf((std::numeric_limits<sf>::min_exponent - std::numeric_limits<sf>::digits - 2) * CC0_WIDE_LN2);
+	const wf xc = cc0::wide::clamp(lo, x, hi);
+	const wf n  = cc0::wide::round(xc * sf(CC0_WIDE_LOG2E));
+	const wf r  = cc0::wide::fnma(n, wf(sf(__wide_explog<Depth,Precision>::LN2_LO)), cc0::wide::fnma(n, wf(sf(__wide_explog<Depth,Precision>::LN2_HI)), xc));
+	const wf p  = cc0::wide::fma(r * r, __wide_explog<Depth,Precision>::exp(r), r) + sf(1);
+	return cc0::wide::cmov(x != x, x, cc0::wide::__wide_scale2(p, wi(n)));
+}
+
+
+/// @brief Returns 2 raised to the input.
+///
+/// @note Splits the input into an integer part, applied directly to the floating-point exponent, and a fraction in [-1/2, 1/2] evaluated via a polynomial, so the cost is the same for all inputs. The accurate relative error is within a few units in the last place, while the other precisions use shorter polynomials.
+///
+/// @param x the exponent.
+///
+/// @returns the result.
+///
+/// @sa precision
+/// @sa exp
+/// @sa log2
+template < precision Precision, uint32_t Depth, uint32_t Width >
+wf exp2(const wf &x)
+{
+	const wf hi = sf(std::numeric_limits<sf>::max_exponent + 1);
+	const wf lo = sf(std::numeric_limits<sf>::min_exponent - std::numeric_limits<sf>::digits - 1);
+	const wf xc = cc0::wide::clamp(lo, x, hi);
+	const wf n  = cc0::wide::round(xc);
+	const wf f  = xc - n;
+	const wf p  = cc0::wide::fma(f, __wide_explog<Depth,Precision>::exp2(f), wf(sf(1)));
+	return cc0::wide::cmov(x != x, x, cc0::wide::__wide_scale2(p, wi(n)));
+}
+
+
+/// @brief Returns 2 raised to the sum of 'hi' and 'lo', where 'lo' is small compared to 'hi' and holds the bits beyond the precision of the type. Only valid for finite inputs.
+template < precision Precision, uint32_t Depth, uint32_t Width >
+inline wf __wide_exp2_split(const wf &hi, const wf &lo)
+{
+	const wf max = sf(std::numeric_limits<sf>::max_exponent + 1);
+	const wf min = sf(std::numeric_limits<sf>::min_exponent - std::numeric_limits<sf>::digits - 1);
+	const wf n   = cc0::wide::round(cc0::wide::clamp(min, hi + lo, max));
+	// 'hi - n' is exact, since 'n' is the nearest integer to 'hi' in range. Out of range, the fraction is clamped so that scaling by 'n' overflows or underflows.
+	const wf f   = cc0::wide::clamp(wf(sf(-1)), (hi - n) + lo, wf(sf(1)));
+	const wf p   = cc0::wide::fma(f, __wide_explog<Depth,Precision>::exp2(f), wf(sf(1)));
+	return cc0::wide::__wide_scale2(p, wi(n));
+}
+
+
+/// @brief Returns the natural logarithm of the input.
+///
+/// @note Splits the input into exponent and mantissa via bit manipulation and evaluates a polynomial for the mantissa, so the cost is the same for all inputs. The accurate relative error is within a few units in the last place, while the other precisions use shorter polynomials. Negative inputs return NaN, and zero returns negative infinity.
+///
+/// @param x the value.
+///
+/// @returns the natural logarithm.
+///
+/// @sa precision
+/// @sa exp
+/// @sa log2
+/// @sa log10
+template < precision Precision, uint32_t Depth, uint32_t Width >
+wf log(const wf &x)
+{
+	wf e;
+	const wf m = cc0::wide::__wide_log_reduce<Precision>(x, e);
+	const wf y = cc0::wide::fma(e, wf(sf(__wide_explog<Depth,Precision>::LN2_HI)), cc0::wide::fma(e, wf(sf(__wide_explog<Depth,Precision>::LN2_LO)), m));
+	return cc0::wide::__wide_log_special(x, y);
 }
 
 
+/// @brief Returns the base-2 logarithm of the input.
+///
+/// @note See 'log' for precision. Negative inputs return NaN, and zero returns negative infinity.
+///
+/// @param x the value.
+///
+/// @returns the base-2 logarithm.
+///
+/// @sa precision
+/// @sa exp2
+/// @sa log
+template < precision Precision, uint32_t Depth, uint32_t Width >
+wf log2(const wf &x)
+{
+	wf e;
+	const wf m = cc0::wide::__wide_log_reduce<Precision>(x, e);
+	return cc0::wide::__wide_log_special(x, cc0::wide::fma(m, wf(sf(CC0_WIDE_LOG2E)), e));
+}
+
+
+/// @brief Returns the base-10 logarithm of the input.
+///
+/// @note See 'log' for precision. Negative inputs return NaN, and zero returns negative infinity.
+///
+/// @param x the value.
+///
+/// @returns the base-10 logarithm.
+///
+/// @sa precision
+/// @sa log
+template < precision Precision, uint32_t Depth, uint32_t Width >
+wf log10(const wf &x)
+{
+	return cc0::wide::log<Precision>(x) * sf(CC0_WIDE_LOG10E);
+}
+
+
+/// @brief Computes 'exp2(ex * log2(base))' for positive, finite bases and finite exponents. The accurate precision carries the logarithm and its product with the exponent in two parts, since the error of a single-precision product grows with the magnitude of the result's exponent.
+template < precision Precision >
+struct __wide_pow
+{
+	template < uint32_t Depth, uint32_t Width >
+	static wf apply(const wf &base, const wf &ex) { return cc0::wide::exp2<Precision>(ex * cc0::wide::log2<Precision>(base)); }
+};
+
+template <>
+struct __wide_pow<precision::accurate>
+{
+	template < uint32_t Depth, uint32_t Width >
+	static wf apply(const wf &base, const wf &ex)
+	{
+		wf       lo;
+		const wf hi = cc0::wide::__wide_log2_split<precision::accurate>(base, lo);
+		const wf e  = cc0::wide::__wide_split_high(ex);
+		const wf ph = e * hi;
+		const wf pl = (ex - e) * hi + ex * lo;
+		return cc0::wide::__wide_exp2_split<precision::accurate>(ph, pl);
+	}
+};
+
+
 /// @brief Raises the input by an exponent.
 ///
+/// @note Computed as 'exp2(ex * log2(base))', so the cost is the same for all inputs. The accurate precision computes the logarithm and its product with the exponent with extra precision, so it is within a few units in the last place for results of moderate magnitude, rising to around ten units near the limits of the exponent range. The other precisions use a single product, so their relative error grows with the magnitude of the result's exponent. Follows the C standard for special cases; negative bases return NaN unless the exponent is an integer, and any base raised to zero, and one raised to any exponent, returns one.
+///
 /// @param base the base floating-point value to be raised by an exponent.
 /// @param ex the floating-point exponent.
 ///
 /// @returns the result of raising the base by the exponent.
-template < uint32_t Depth, uint32_t Width >
-wf pow(const wf &base, const wf &ex);
+///
+/// @sa precision
+template < precision Precision, uint32_t Depth, uint32_t Width >
+wf pow(const wf &base, const wf &ex)
+{
+	// All floating-point values of at least this magnitude are even integers.
+	const wf big = sf(si(1) << std::numeric_limits<sf>::digits);
+	const wf ey  = cc0::wide::clamp(-big, ex, big);
+	const wi iy  = wi(ey);
+	const wb integer = wf(iy) == ey;
+	const wb odd     = integer & ((iy & si(1)) != si(0));
+	const wb sign     = cc0::wide::bit_cast<wi>(base) < si(0);
+	const wb negative = (base < sf(0)) & (base > -std::numeric_limits<sf>::infinity());
+
+	// Zero, infinite, or NaN bases and infinite or NaN exponents are computed via the special cases of log2 and exp2 instead.
+	const wf ab      = cc0::wide::abs(base);
+	const wb special = !((ab > sf(0)) & (ab < std::numeric_limits<sf>::infinity()) & (cc0::wide::abs(ex) < std::numeric_limits<sf>::infinity()));
+	wf o = cc0::wide::__wide_pow<Precision>::apply(cc0::wide::cmov(special, wf(sf(1)), ab), cc0::wide::cmov(special, wf(sf(0)), ex));
+	if (cc0::wide::any(special)) {
+		o = cc0::wide::cmov(special, cc0::wide::exp2<Precision>(ex * cc0::wide::log2<Precision>(ab)), o);
+	}
+	o = cc0::wide::cmov(sign & odd, -o, o);
+	o = cc0::wide::cmov(negative & !integer, nan, o);
+	o = cc0::wide::cmov((ex == sf(0)) | (base == sf(1)) | ((base == sf(-1)) & (cc0::wide::abs(ex) == std::numeric_limits<sf>::infinity())), wf(sf(1)), o);
+	return o;
+}
 
 
 /// @brief Returns a number which, when raised by 'n' yields 'A'.
@@ -622,67 +1489,34 @@ wf nth_root(const wf &A, const wi &n)
 	wf x[K] = { wf(1) };
 	const wf N = wf(n);
 	for (int k = 0; k < K - 1; ++k) {
-		x[k + 1] = (wf(sf(1)) / N) * ((N - wf(sf(1))) * x[k] + A / cc0::wide::pow(x[k], N - wf(sf(1))));
+		x[k + 1] = cc0::wide::rcp(N) * cc0::wide::fma(N - wf(sf(1)), x[k], A * cc0::wide::rcp(cc0::wide::pow<precision::accurate>(x[k], N - wf(sf(1)))));
 	}
 	return x[K - 1];
 }
 
+// Calls that give no template arguments, or only the depth and width (e.g. 'sin<32,4>(x)'), use the accurate precision. These are separate overloads rather than a default for the precision, since the precision comes first and could then not be skipped when giving the depth and width explicitly.
+#define ACCURATE_1(name, a)    template < uint32_t Depth, uint32_t Width > wf name(const wf &a) { return cc0::wide::name<precision::accurate>(a); }
+#define ACCURATE_2(name, a, b) template < uint32_t Depth, uint32_t Width > wf name(const wf &a, const wf &b) { return cc0::wide::name<precision::accurate>(a, b); }
+
+ACCURATE_1(sin, rad)
+ACCURATE_1(cos, rad)
+ACCURATE_1(tan, rad)
+ACCURATE_1(asin, x)
+ACCURATE_1(acos, x)
+ACCURATE_1(atan, x)
+ACCURATE_2(atan2, y, x)
+ACCURATE_1(exp, x)
+ACCURATE_1(exp2, x)
+ACCURATE_1(log, x)
+ACCURATE_1(log2, x)
+ACCURATE_1(log10, x)
+ACCURATE_2(pow, base, ex)
+template < uint32_t Depth, uint32_t Width > void sincos(const wf &rad, wf &s, wf &c) { cc0::wide::sincos<precision::accurate>(rad, s, c); }
+
+#undef ACCURATE_1
+#undef ACCURATE_2
 
-/// @brief Raises the input by an exponent.
-///
-/// @param base the base floating-point value to be raised by an exponent.
-/// @param ex the floating-point exponent.
-///
-/// @returns the result of raising the base by the exponent.
-template < uint32_t Depth, uint32_t Width >
-wf pow(const wf &base, const wf &ex)
-{
-	wf out = 0.0;
-
-	// power of 0
-	wb m0 = (base != 0);
-	wb m1 = (ex == 0 && m0);
-	if (m1) {
-		out = cc0::wide::cmov(m1, wf(1), out);
-	}
-	m1 = !m1 && m0;
-	if (m1) {
-		// negative exponenet
-		wb m2 = (ex < 0 && m1);
-		if (m2) {
-			out = cc0::wide::cmov(m2, wf(sf(1)) / cc0::wide::pow(base, -ex), out);
-		}
-		m2 = !m2 && m1;
-		if (m2) {
-			// fractional exponent
-			wb m3 = (ex > 0 && ex < 1 && m2);
-			if (m3) {
-				out = cc0::wide::cmov(m3, cc0::wide::nth_root(base, wi(wf(sf(1)) / ex)), out);
-			}
-			m3 = !m3 && m2;
-			if (m3) {
-				wb m4 = (wi(ex) % wi(si(2)) == 0 && m3);
-				if (m4) {
-					const wf half_pow = cc0::wide::pow(base, ex / wf(sf(2)));
-					out = cc0::wide::cmov(m4, half_pow * half_pow, out);
-				}
-				m4 = !m4 && m3;
-				if (m4) {
-					// integer exponenet
-					out = cc0::wide::cmov(m4, base * cc0::wide::pow(base, ex - wf(1)), out);
-				}
-			}
-		}
-	}
-	return out;
 }
-
-/*template < uint32_t Depth, uint32_t Width >
-wf pow(const wf &x, const wf &n)
-{
-	return cc0::wide::exp(log(x) * b);
-}*/
-
 }
 }
 
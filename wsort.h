@@ -0,0 +1,384 @@
+/// @file wsort.h
+/// @brief Contains sorting networks for wide data types, and a sort for arrays of serial values built on them.
+/// @author github.com/SirJonthe
+/// @date 2022, 2023
+/// @copyright Public domain.
+/// @license CC0 1.0
+
+#ifndef CC0_WSORT_H_INCLUDED__
+#define CC0_WSORT_H_INCLUDED__
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+#include "wide.h"
+
+// The number of wide values sorted by a single sorting network in wide_sort. Partitions of at most this many wide values are sorted without being partitioned further. Provide CC0_WIDE_SORT_BLOCK through the build stage to override. Must be a power of two.
+#if !defined(CC0_WIDE_SORT_BLOCK)
+	#define CC0_WIDE_SORT_BLOCK 8
+#endif
+
+namespace cc0
+{
+namespace wide
+{
+inline namespace CC0_WIDE_ISA_NAMESPACE
+{
+
+/// @brief A pack of the lane indices 0 to Width - 1, from which the constant indices and masks of the sorting networks are built.
+template < uint32_t... Lanes >
+struct __wide_sort_lanes {};
+
+template < uint32_t Width, uint32_t... Lanes >
+struct __wide_sort_iota : __wide_sort_iota<Width - 1, Width - 1, Lanes...> {};
+
+template < uint32_t... Lanes >
+struct __wide_sort_iota<0, Lanes...>
+{
+	typedef __wide_sort_lanes<Lanes...> type;
+};
+
+
+/// @brief Returns the lane indices that pair each lane with the lane 'Distance' lanes away in a sorting network, i.e. lane 'i' with lane 'i ^ Distance'.
+template < typename wide_t, uint32_t Distance, uint32_t... Lanes >
+inline wide_int<wide_t::depth,wide_t::width> __wide_sort_partner(__wide_sort_lanes<Lanes...>)
+{
+	typedef wide_int<wide_t::depth,wide_t::width> index_t;
+	const typename index_t::serial_t i[] = { typename index_t::serial_t(Lanes ^ Distance)... };
+	return cc0::wide::load<index_t>(i);
+}
+
+
+/// @brief Returns the lane indices that reverse the order of the lanes.
+template < typename wide_t, uint32_t... Lanes >
+inline wide_int<wide_t::depth,wide_t::width> __wide_sort_reverse(__wide_sort_lanes<Lanes...>)
+{
+	typedef wide_int<wide_t::depth,wide_t::width> index_t;
+	const typename index_t::serial_t i[] = { typename index_t::serial_t(wide_t::width - 1 - Lanes)... };
+	return cc0::wide::load<index_t>(i);
+}
+
+
+/// @brief Returns the lanes that keep the higher value of their pair in a step of a bitonic sorting network.
+///
+/// @note Element 'e' belongs to a block of 'Block' elements sorted in ascending order if 'e & Block' is zero, and in descending order otherwise. Within an ascending block, it keeps the higher value if it is the upper element of its pair, i.e. if 'e & Distance' is non-zero, and the opposite within a descending block.
+///
+/// @param Block the size of the blocks sorted by the current stage of the network.
+/// @param Distance the distance between the elements of each pair.
+/// @param First the index of the element in lane 0.
+template < typename wide_t, uint32_t Block, uint32_t Distance, uint32_t First, uint32_t... Lanes >
+inline wide_bool<wide_t::depth,wide_t::width> __wide_sort_upper(__wide_sort_lanes<Lanes...>)
+{
+	typedef wide_bool<wide_t::depth,wide_t::width> mask_t;
+	typedef typename mask_t::serial_t              bits_t;
+	const bits_t b[] = { ((((First + Lanes) & Distance) != 0) != (((First + Lanes) & Block) != 0)) ? bits_t(~bits_t(0)) : bits_t(0)... };
+	return cc0::wide::load<mask_t>(b);
+}
+
+
+/// @brief Compares and exchanges the pairs of lanes within a wide value in a step of a sorting network.
+///
+/// @note The lower lane of a pair takes the value of its partner only if the partner is less, and the upper lane only if the partner is greater, so both lanes agree on whether to exchange even when the pair is unordered, i.e. contains a NaN.
+template < typename wide_t >
+inline wide_t __wide_sort_exchange(const wide_t &x, const wide_int<wide_t::depth,wide_t::width> &partner, const wide_bool<wide_t::depth,wide_t::width> &upper)
+{
+	const wide_t p = cc0::wide::permute(x, partner);
+	return cmov(cmov(upper, x < p, p < x), p, x);
+}
+
+
+/// @brief Compares and exchanges the lanes of two wide values, so that 'lo' holds the lower and 'hi' the higher value of each pair of lanes.
+template < typename wide_t >
+inline void __wide_sort_exchange(wide_t &lo, wide_t &hi)
+{
+	const wide_bool<wide_t::depth,wide_t::width> less = lo < hi;
+	const wide_t l = cmov(less, lo, hi);
+	hi = cmov(less, hi, lo);
+	lo = l;
+}
+
+
+/// @brief Runs one step of a bitonic sorting network over N wide values, starting at wide value 'Index'. Pairs that lie in different wide values are exchanged vertically, while pairs within a wide value are exchanged via a permute.
+template < typename wide_t, size_t N, uint32_t Block, uint32_t Distance, size_t Index = 0 >
+struct __wide_sort_step
+{
+	static void apply(wide_t (&x)[N])
+	{
+		const uint32_t W = wide_t::width;
+		if (Distance >= W) {
+			const size_t partner = Index ^ (Distance / W);
+			if (partner > Index) {
+				if (((Index * W) & Block) == 0) { __wide_sort_exchange(x[Index], x[partner]); }
+				else                            { __wide_sort_exchange(x[partner], x[Index]); }
+			}
+		} else {
+			typedef typename __wide_sort_iota<wide_t::width>::type lanes_t;
+			x[Index] = __wide_sort_exchange(x[Index], __wide_sort_partner<wide_t,Distance>(lanes_t()), __wide_sort_upper<wide_t,Block,Distance,uint32_t(Index * W)>(lanes_t()));
+		}
+		__wide_sort_step<wide_t,N,Block,Distance,Index + 1>::apply(x);
+	}
+};
+
+template < typename wide_t, size_t N, uint32_t Block, uint32_t Distance >
+struct __wide_sort_step<wide_t,N,Block,Distance,N>
+{
+	static void apply(wide_t (&)[N]) {}
+};
+
+
+/// @brief Runs the steps of a bitonic sorting network that merge blocks of 'Block' elements, starting at the given distance.
+template < typename wide_t, size_t N, uint32_t Block, uint32_t Distance = Block / 2 >
+struct __wide_sort_stage
+{
+	static void apply(wide_t (&x)[N])
+	{
+		__wide_sort_step<wide_t,N,Block,Distance>::apply(x);
+		__wide_sort_stage<wide_t,N,Block,Distance / 2>::apply(x);
+	}
+};
+
+template < typename wide_t, size_t N, uint32_t Block >
+struct __wide_sort_stage<wide_t,N,Block,0>
+{
+	static void apply(wide_t (&)[N]) {}
+};
+
+
+/// @brief Runs the stages of a bitonic sorting network over N wide values, from blocks of two elements up to all elements. The network is unrolled at compile time, so all indices and masks are constants.
+template < typename wide_t, size_t N, uint32_t Block = 2, bool Done = (Block > N * wide_t::width) >
+struct __wide_sort_network
+{
+	static void apply(wide_t (&x)[N])
+	{
+		__wide_sort_stage<wide_t,N,Block>::apply(x);
+		__wide_sort_network<wide_t,N,Block * 2>::apply(x);
+	}
+};
+
+template < typename wide_t, size_t N, uint32_t Block >
+struct __wide_sort_network<wide_t,N,Block,true>
+{
+	static void apply(wide_t (&)[N]) {}
+};
+
+
+/// @brief Sorts the lanes of a wide value in ascending order via a bitonic sorting network.
+///
+/// @note The network runs the same sequence of instructions regardless of the values, i.e. log2(width) * (log2(width) + 1) / 2 steps of a permute, a comparison, and a blend. The lanes are only ever exchanged, so NaN values are preserved, but they do not compare to other values, so the order of the result is unspecified if any lane is NaN.
+///
+/// @param x the wide value.
+///
+/// @returns the wide value with its lanes in ascending order.
+///
+/// @sa merge
+/// @sa wide_sort
+template < typename wide_t >
+wide_t sort_lanes(const wide_t &x)
+{
+	wide_t o[1] = { x };
+	__wide_sort_network<wide_t,1>::apply(o);
+	return o[0];
+}
+
+
+/// @brief Sorts the lanes of several wide values in ascending order via a bitonic sorting network, as if they were a single wide value with N times the width, i.e. lane 0 of 'x[0]' holds the lowest value, and the last lane of 'x[N - 1]' holds the highest value.
+///
+/// @note Pairs of lanes that lie in different wide values are exchanged without moving lanes, so most of the work of sorting several wide values is vertical. As with sorting a single wide value, NaN values are preserved, but the order of the result is unspecified if any lane is NaN.
+///
+/// @param x the wide values. The number of wide values must be a power of two.
+///
+/// @sa merge
+/// @sa wide_sort
+template < typename wide_t, size_t N >
+void sort_lanes(wide_t (&x)[N])
+{
+	static_assert(N > 0 && (N & (N - 1)) == 0, "The number of wide values must be a power of two");
+	__wide_sort_network<wide_t,N>::apply(x);
+}
+
+
+/// @brief Merges two wide values with lanes sorted in ascending order, so that 'lo' holds the lowest and 'hi' the highest lanes of both, each in ascending order.
+///
+/// @note Implemented as a bitonic merge, which reverses the lanes of 'hi' and runs log2(width) + 1 steps of the sorting network. Use to merge sorted runs one wide value at a time. NaN values are preserved, but the order of the result is unspecified if any lane is NaN.
+///
+/// @param lo a wide value with its lanes in ascending order.
+/// @param hi a wide value with its lanes in ascending order.
+///
+/// @sa sort_lanes
+template < typename wide_t >
+void merge(wide_t &lo, wide_t &hi)
+{
+	wide_t x[2] = { lo, cc0::wide::permute(hi, __wide_sort_reverse<wide_t>(typename __wide_sort_iota<wide_t::width>::type())) };
+	__wide_sort_exchange(x[0], x[1]);
+	__wide_sort_stage<wide_t,2,2 * wide_t::width,wide_t::width / 2>::apply(x);
+	lo = x[0];
+	hi = x[1];
+}
+
+
+/// @brief Sorts up to N wide values worth of elements with a single sorting network. Lanes past the end of the input are filled with the highest value of the serial type, so that they sort to the end and are never written.
+template < typename wide_t, size_t N >
+void __wide_sort_block(typename wide_t::serial_t *out, const typename wide_t::serial_t *in, size_t count)
+{
+	typedef typename wide_t::serial_t serial_t;
+	const serial_t highest = std::numeric_limits<serial_t>::has_infinity ? std::numeric_limits<serial_t>::infinity() : std::numeric_limits<serial_t>::max();
+	serial_t s[N * wide_t::width];
+	wide_t   x[N];
+	std::memcpy(s, in, count * sizeof(serial_t));
+	for (size_t i = count; i < N * wide_t::width; ++i) { s[i] = highest; }
+	for (size_t n = 0; n < N; ++n) { x[n] = cc0::wide::load<wide_t>(s + n * wide_t::width); }
+	cc0::wide::sort_lanes(x);
+	for (size_t n = 0; n < N; ++n) { cc0::wide::store(s + n * wide_t::width, x[n]); }
+	std::memcpy(out, s, count * sizeof(serial_t));
+}
+
+
+/// @brief Sorts at most CC0_WIDE_SORT_BLOCK wide values worth of elements with the smallest sorting network that fits them.
+template < typename wide_t, size_t N = CC0_WIDE_SORT_BLOCK >
+struct __wide_sort_small
+{
+	static void sort(typename wide_t::serial_t *out, const typename wide_t::serial_t *in, size_t count)
+	{
+		if (count <= N / 2 * wide_t::width) { __wide_sort_small<wide_t,N / 2>::sort(out, in, count); }
+		else                                { __wide_sort_block<wide_t,N>(out, in, count); }
+	}
+};
+
+template < typename wide_t >
+struct __wide_sort_small<wide_t,1>
+{
+	static void sort(typename wide_t::serial_t *out, const typename wide_t::serial_t *in, size_t count)
+	{
+		__wide_sort_block<wide_t,1>(out, in, count);
+	}
+};
+
+
+/// @brief Selects the elements that are less than the pivot, or less than or equal to it if 'Inclusive' is true.
+template < typename wide_t, bool Inclusive >
+struct __wide_sort_below
+{
+	typename wide_t::serial_t pivot;
+	wide_bool<wide_t::depth,wide_t::width> operator()(const wide_t &x) const { return Inclusive ? x <= pivot : x < pivot; }
+};
+
+
+/// @brief Selects the elements that are not NaN.
+template < typename wide_t >
+struct __wide_sort_ordered
+{
+	wide_bool<wide_t::depth,wide_t::width> operator()(const wide_t &x) const { return x == x; }
+};
+
+
+/// @brief Moves the elements of 'in' selected by 'select' to the front of 'out', and the remaining elements to the back.
+///
+/// @returns the number of elements moved to the front.
+template < typename wide_t, typename select_t >
+size_t __wide_sort_split(typename wide_t::serial_t *out, const typename wide_t::serial_t *in, size_t count, const select_t &select)
+{
+	typedef wide_bool<wide_t::depth,wide_t::width> mask_t;
+	const uint32_t W     = wide_t::width;
+	size_t         front = 0;
+	size_t         back  = count;
+	size_t         i     = 0;
+	for (; i + W <= count; i += W) {
+		const wide_t   x = cc0::wide::load<wide_t>(in + i);
+		const mask_t   m = select(x);
+		const uint32_t n = cc0::wide::compress_store(out + front, x, m);
+		front += n;
+		back  -= W - n;
+		cc0::wide::compress_store(out + back, x, !m);
+	}
+	if (i < count) {
+		const mask_t   tail = tail_mask<wide_t>(count - i);
+		const wide_t   x    = cc0::wide::load_masked<wide_t>(in + i, tail);
+		const mask_t   m    = select(x) & tail;
+		const uint32_t n    = cc0::wide::compress_store(out + front, x, m);
+		front += n;
+		back  -= (count - i) - n;
+		cc0::wide::compress_store(out + back, x, (!m) & tail);
+	}
+	return front;
+}
+
+
+/// @brief Sorts the elements in the range ['lo', 'hi') of 'in' into the same range of 'out' via quicksort, using 'scratch' as the target of the partitions. 'in' and 'scratch' swap roles at every level, so every element is read and written once per level.
+///
+/// @note Falls back to std::sort when the partitions are consistently unbalanced, which bounds the worst case to O(n log n). The range must not contain NaN values.
+template < typename wide_t >
+void __wide_sort_range(typename wide_t::serial_t *out, typename wide_t::serial_t *in, typename wide_t::serial_t *scratch, size_t lo, size_t hi, uint32_t depth)
+{
+	typedef typename wide_t::serial_t serial_t;
+	const size_t count = hi - lo;
+	if (count <= CC0_WIDE_SORT_BLOCK * wide_t::width) {
+		__wide_sort_small<wide_t>::sort(out + lo, in + lo, count);
+		return;
+	}
+	if (depth == 0) {
+		if (in != out) { std::memcpy(out + lo, in + lo, count * sizeof(serial_t)); }
+		std::sort(out + lo, out + hi);
+		return;
+	}
+
+	const serial_t a     = in[lo + count / 4];
+	const serial_t b     = in[lo + count / 2];
+	const serial_t c     = in[lo + count / 4 * 3];
+	const serial_t pivot = std::max(std::min(a, b), std::min(std::max(a, b), c));
+
+	size_t front = __wide_sort_split<wide_t>(scratch + lo, in + lo, count, __wide_sort_below<wide_t,false>{ pivot });
+	if (front == 0) {
+		// The pivot is the lowest value, so split off the values equal to it instead. These are already in their final place.
+		front = __wide_sort_split<wide_t>(scratch + lo, in + lo, count, __wide_sort_below<wide_t,true>{ pivot });
+		std::fill(out + lo, out + lo + front, pivot);
+	} else {
+		__wide_sort_range<wide_t>(out, scratch, in, lo, lo + front, depth - 1);
+	}
+	__wide_sort_range<wide_t>(out, scratch, in, lo + front, hi, depth - 1);
+}
+
+
+/// @brief Sorts an array of serial values in ascending order.
+///
+/// @note Partitions the array via quicksort, moving the elements on each side of the pivot with compress_store, until the partitions are small enough to be sorted by the sorting network of sort_lanes. Requires a temporary buffer the size of the array. The sort is not stable. NaN values are moved to the end of the array in an unspecified order before the remaining values are sorted, so they never take part in a comparison.
+///
+/// @param Width the width of the wide type used, e.g. 'wide_sort<8>(p, count)' sorts an array of float with 'wide_float<32,8>'.
+/// @param p the array of serial values.
+/// @param count the number of elements in the array.
+///
+/// @sa sort_lanes
+/// @sa compress_store
+template < uint32_t Width, typename serial_t >
+void wide_sort(serial_t *p, size_t count)
+{
+	typedef typename __wide_of<serial_t,Width>::type wide_t;
+	if (count < 2) {
+		return;
+	}
+	if (count <= CC0_WIDE_SORT_BLOCK * Width) {
+		if (std::numeric_limits<serial_t>::has_quiet_NaN) {
+			count = size_t(std::partition(p, p + count, [](serial_t x) { return x == x; }) - p);
+		}
+		__wide_sort_small<wide_t>::sort(p, p, count);
+		return;
+	}
+	uint32_t depth = 0;
+	for (size_t n = count; n > 1; n /= 2) { depth += 2; }
+	std::vector<serial_t> scratch(count);
+	if (std::numeric_limits<serial_t>::has_quiet_NaN) {
+		// Moves the NaN values to the back of the array, and sorts the rest out of the scratch buffer, using the front of the array as the scratch buffer in turn.
+		const size_t ordered = __wide_sort_split<wide_t>(scratch.data(), p, count, __wide_sort_ordered<wide_t>());
+		std::memcpy(p + ordered, scratch.data() + ordered, (count - ordered) * sizeof(serial_t));
+		__wide_sort_range<wide_t>(p, scratch.data(), p, 0, ordered, depth);
+	} else {
+		__wide_sort_range<wide_t>(p, p, scratch.data(), 0, count, depth);
+	}
+}
+
+}
+}
+}
+
+#endif // CC0_WSORT_H_INCLUDED__
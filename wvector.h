@@ -0,0 +1,350 @@
+/// @file wvector.h
+/// @brief Contains aligned containers for wide data types.
+/// @author github.com/SirJonthe
+/// @date 2022, 2023
+/// @copyright Public domain.
+/// @license CC0 1.0
+
+#ifndef CC0_WVECTOR_H_INCLUDED__
+#define CC0_WVECTOR_H_INCLUDED__
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <tuple>
+#include <utility>
+#include "wide.h"
+
+// The default alignment of memory allocated by wide containers. Provide CC0_WIDE_CACHE_LINE_SIZE through the build stage to override.
+#if !defined(CC0_WIDE_CACHE_LINE_SIZE)
+	#define CC0_WIDE_CACHE_LINE_SIZE 64
+#endif
+
+namespace cc0
+{
+namespace wide
+{
+inline namespace CC0_WIDE_ISA_NAMESPACE
+{
+
+/// @brief An allocator which aligns all memory to a given number of bytes. Can be used with standard containers to store wide types without relying on over-aligned new.
+///
+/// @param T the type of the elements to allocate.
+/// @param Alignment the number of bytes to align memory to. Must be a power of two, and is raised to the alignment of T if lower.
+template < typename T, size_t Alignment = CC0_WIDE_CACHE_LINE_SIZE >
+class aligned_allocator
+{
+public:
+	typedef T         value_type;
+	typedef T        *pointer;
+	typedef const T  *const_pointer;
+	typedef size_t    size_type;
+	typedef ptrdiff_t difference_type;
+
+	template < typename U >
+	struct rebind { typedef aligned_allocator<U,Alignment> other; };
+
+	static constexpr size_t alignment = Alignment > alignof(T) ? Alignment : alignof(T);
+	static_assert((alignment & (alignment - 1)) == 0, "Alignment must be a power of two");
+
+public:
+	aligned_allocator( void ) = default;
+	template < typename U >
+	aligned_allocator(const aligned_allocator<U,Alignment>&) {}
+
+	/// @brief Allocates uninitialized memory for a number of elements.
+	///
+	/// @param n the number of elements.
+	///
+	/// @returns a pointer to the aligned memory.
+	///
+	/// @note Throws std::bad_alloc if the memory could not be allocated.
+	T *allocate(size_t n)
+	{
+		if (n == 0) {
+			return nullptr;
+		}
+		if (n > (std::numeric_limits<size_t>::max() - alignment - sizeof(void*)) / sizeof(T)) {
+			throw std::bad_alloc();
+		}
+		// Over-allocate, align, and store the original pointer just before the aligned memory.
+		void *raw = std::malloc(n * sizeof(T) + alignment + sizeof(void*));
+		if (raw == nullptr) {
+			throw std::bad_alloc();
+		}
+		const uintptr_t aligned = (reinterpret_cast<uintptr_t>(raw) + sizeof(void*) + alignment - 1) & ~uintptr_t(alignment - 1);
+		reinterpret_cast<void**>(aligned)[-1] = raw;
+		return reinterpret_cast<T*>(aligned);
+	}
+
+	/// @brief Releases memory previously returned by allocate.
+	///
+	/// @param p the pointer returned by allocate.
+	void deallocate(T *p, size_t)
+	{
+		if (p != nullptr) {
+			std::free(reinterpret_cast<void**>(p)[-1]);
+		}
+	}
+
+	template < typename U >
+	bool operator==(const aligned_allocator<U,Alignment>&) const { return true; }
+	template < typename U >
+	bool operator!=(const aligned_allocator<U,Alignment>&) const { return false; }
+};
+
+
+/// @brief A dynamic array of serial values stored as whole wide values. Memory is aligned to the cache line size, and padded to a whole number of wide values, so that the same memory can be accessed both one wide value at a time and one serial value at a time without copying.
+///
+/// @note Lanes past the last element in the last wide value are always zero.
+///
+/// @param wide_t the wide type to store.
+/// @param Alignment the number of bytes to align memory to. Defaults to the cache line size.
+template < typename wide_t, size_t Alignment = CC0_WIDE_CACHE_LINE_SIZE >
+class wide_vector
+{
+public:
+	typedef typename wide_t::serial_t                      serial_t;
+	typedef wide_bool<wide_t::depth,wide_t::width>         mask_t;
+	typedef aligned_allocator<wide_t,Alignment>            allocator_t;
+	static constexpr uint32_t width = wide_t::width;
+
+private:
+	wide_t *mem;
+	size_t  serial_count;
+	size_t  wide_capacity;
+
+private:
+	static size_t blocks(size_t n) { return (n + width - 1) / width; }
+
+	void reallocate(size_t new_wide_capacity)
+	{
+		allocator_t a;
+		wide_t *new_mem = a.allocate(new_wide_capacity);
+		if (mem != nullptr) {
+			std::memcpy(static_cast<void*>(new_mem), static_cast<const void*>(mem), wide_size() * sizeof(wide_t));
+			a.deallocate(mem, wide_capacity);
+		}
+		mem = new_mem;
+		wide_capacity = new_wide_capacity;
+	}
+
+	void grow(size_t n)
+	{
+		if (blocks(n) > wide_capacity) {
+			const size_t doubled = wide_capacity * 2;
+			reallocate(doubled > blocks(n) ? doubled : blocks(n));
+		}
+	}
+
+public:
+	wide_vector( void ) : mem(nullptr), serial_count(0), wide_capacity(0) {}
+	explicit wide_vector(size_t size, const serial_t &value = serial_t(0)) : wide_vector() { resize(size, value); }
+	wide_vector(const wide_vector &v) : wide_vector() { *this = v; }
+	wide_vector(wide_vector &&v) noexcept : mem(v.mem), serial_count(v.serial_count), wide_capacity(v.wide_capacity) { v.mem = nullptr; v.serial_count = 0; v.wide_capacity = 0; }
+	~wide_vector( void ) { allocator_t().deallocate(mem, wide_capacity); }
+
+	wide_vector &operator=(const wide_vector &v)
+	{
+		if (this != &v) {
+			if (v.wide_size() > wide_capacity) {
+				allocator_t().deallocate(mem, wide_capacity);
+				mem = nullptr;
+				wide_capacity = 0;
+				reallocate(v.wide_size());
+			}
+			if (v.wide_size() > 0) {
+				std::memcpy(static_cast<void*>(mem), static_cast<const void*>(v.mem), v.wide_size() * sizeof(wide_t));
+			}
+			serial_count = v.serial_count;
+		}
+		return *this;
+	}
+
+	wide_vector &operator=(wide_vector &&v) noexcept
+	{
+		if (this != &v) {
+			std::swap(mem, v.mem);
+			std::swap(serial_count, v.serial_count);
+			std::swap(wide_capacity, v.wide_capacity);
+		}
+		return *this;
+	}
+
+	/// @brief Returns the number of serial elements.
+	size_t size( void ) const { return serial_count; }
+
+	/// @brief Returns the number of wide values needed to hold all serial elements.
+	size_t wide_size( void ) const { return blocks(serial_count); }
+
+	/// @brief Returns the number of serial elements that can be held without reallocating.
+	size_t capacity( void ) const { return wide_capacity * width; }
+
+	/// @brief Returns true if there are no elements.
+	bool empty( void ) const { return serial_count == 0; }
+
+	/// @brief Ensures that a number of serial elements can be held without reallocating.
+	///
+	/// @param n the number of serial elements.
+	void reserve(size_t n)
+	{
+		if (blocks(n) > wide_capacity) {
+			reallocate(blocks(n));
+		}
+	}
+
+	/// @brief Changes the number of serial elements.
+	///
+	/// @param n the new number of serial elements.
+	/// @param value the value of any new elements.
+	void resize(size_t n, const serial_t &value = serial_t(0))
+	{
+		grow(n);
+		serial_t *s = data();
+		for (size_t i = serial_count; i < n; ++i) { s[i] = value; }
+		const size_t end = blocks(n) * width;
+		for (size_t i = n; i < end; ++i) { s[i] = serial_t(0); }
+		serial_count = n;
+	}
+
+	/// @brief Removes all elements, but keeps the allocated memory.
+	void clear( void ) { resize(0); }
+
+	/// @brief Appends a serial element.
+	///
+	/// @param value the element to append.
+	void push_back(const serial_t &value)
+	{
+		grow(serial_count + 1);
+		if (serial_count % width == 0) {
+			mem[serial_count / width] = serial_t(0);
+		}
+		data()[serial_count++] = value;
+	}
+
+	/// @brief Removes the last serial element.
+	void pop_back( void ) { data()[--serial_count] = serial_t(0); }
+
+	/// @brief Returns a pointer to the serial elements.
+	serial_t       *data( void )       { return reinterpret_cast<serial_t*>(mem); }
+	const serial_t *data( void ) const { return reinterpret_cast<const serial_t*>(mem); }
+
+	/// @brief Returns a pointer to the wide values.
+	wide_t       *wide_data( void )       { return mem; }
+	const wide_t *wide_data( void ) const { return mem; }
+
+	/// @brief Accesses a serial element.
+	serial_t       &operator[](size_t i)       { return data()[i]; }
+	const serial_t &operator[](size_t i) const { return data()[i]; }
+
+	/// @brief Accesses the wide value holding serial elements [i * width, (i + 1) * width).
+	wide_t       &block(size_t i)       { return mem[i]; }
+	const wide_t &block(size_t i) const { return mem[i]; }
+
+	/// @brief Returns a mask of the lanes of the wide value at the given index that hold elements.
+	///
+	/// @param i the index of the wide value. Indices at or past wide_size() return a mask with no lanes set.
+	mask_t mask(size_t i) const { return tail_mask<wide_t>(i < wide_size() ? serial_count - i * width : 0); }
+
+	/// @brief Iterates over wide values.
+	wide_t       *begin( void )       { return mem; }
+	wide_t       *end( void )         { return mem + wide_size(); }
+	const wide_t *begin( void ) const { return mem; }
+	const wide_t *end( void ) const   { return mem + wide_size(); }
+
+	/// @brief Iterates over serial elements.
+	serial_t       *serial_begin( void )       { return data(); }
+	serial_t       *serial_end( void )         { return data() + serial_count; }
+	const serial_t *serial_begin( void ) const { return data(); }
+	const serial_t *serial_end( void ) const   { return data() + serial_count; }
+};
+
+
+/// @brief Applies a function object to each element in a tuple.
+template < size_t I, size_t N >
+struct __wide_tuple_each
+{
+	template < typename tuple_t, typename func_t >
+	static void apply(tuple_t &t, const func_t &f) { f(std::get<I>(t)); __wide_tuple_each<I + 1,N>::apply(t, f); }
+};
+
+template < size_t N >
+struct __wide_tuple_each<N,N>
+{
+	template < typename tuple_t, typename func_t >
+	static void apply(tuple_t&, const func_t&) {}
+};
+
+
+/// @brief A structure-of-arrays table where each field is stored in its own wide_vector. All columns have the same number of elements, so that lane 'i' of wide value 'j' in every column belongs to the same record.
+///
+/// @param columns_t the wide types of the fields. All types must have the same width.
+template < typename... columns_t >
+class wide_table
+{
+public:
+	typedef std::tuple< wide_vector<columns_t>... > storage_t;
+	template < size_t I >
+	using column_t = typename std::tuple_element<I,storage_t>::type;
+	static constexpr uint32_t width = column_t<0>::width;
+
+private:
+	template < typename... > struct same_width                      { static constexpr bool value = true; };
+	template < typename c, typename... r > struct same_width<c,r...> { static constexpr bool value = c::width == width && same_width<r...>::value; };
+	static_assert(sizeof...(columns_t) > 0, "wide_table requires at least one column");
+	static_assert(same_width<columns_t...>::value, "All columns of a wide_table must have the same width");
+
+	struct reserve_f { size_t n; template < typename c > void operator()(c &v) const { v.reserve(n); } };
+	struct resize_f  { size_t n; template < typename c > void operator()(c &v) const { v.resize(n); } };
+	struct pop_f     {           template < typename c > void operator()(c &v) const { v.pop_back(); } };
+
+	template < size_t I >
+	void push( void ) {}
+
+	template < size_t I, typename first_t, typename... rest_t >
+	void push(const first_t &first, const rest_t&... rest) { std::get<I>(columns).push_back(first); push<I + 1>(rest...); }
+
+private:
+	storage_t columns;
+
+public:
+	/// @brief Returns the number of records.
+	size_t size( void ) const { return std::get<0>(columns).size(); }
+
+	/// @brief Returns the number of wide values needed to hold all records in each column.
+	size_t wide_size( void ) const { return std::get<0>(columns).wide_size(); }
+
+	/// @brief Returns true if there are no records.
+	bool empty( void ) const { return size() == 0; }
+
+	/// @brief Ensures that a number of records can be held without reallocating any column.
+	void reserve(size_t n) { __wide_tuple_each<0,sizeof...(columns_t)>::apply(columns, reserve_f{n}); }
+
+	/// @brief Changes the number of records. New fields are zero.
+	void resize(size_t n) { __wide_tuple_each<0,sizeof...(columns_t)>::apply(columns, resize_f{n}); }
+
+	/// @brief Removes all records, but keeps the allocated memory.
+	void clear( void ) { resize(0); }
+
+	/// @brief Appends a record, given one serial value per column.
+	void push_back(const typename columns_t::serial_t&... values) { push<0>(values...); }
+
+	/// @brief Removes the last record.
+	void pop_back( void ) { __wide_tuple_each<0,sizeof...(columns_t)>::apply(columns, pop_f{}); }
+
+	/// @brief Accesses a column.
+	template < size_t I > column_t<I>       &column( void )       { return std::get<I>(columns); }
+	template < size_t I > const column_t<I> &column( void ) const { return std::get<I>(columns); }
+
+	/// @brief Returns a mask of the lanes of the wide values at the given index that hold records. Indices at or past wide_size() return a mask with no lanes set.
+	typename column_t<0>::mask_t mask(size_t i) const { return std::get<0>(columns).mask(i); }
+};
+
+}
+}
+}
+
+#endif // CC0_WVECTOR_H_INCLUDED__